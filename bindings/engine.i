@@ -94,6 +94,15 @@ engine-common.i */
 
 %include "qoflog.h"
 
+%ignore qof_stats_active;
+%ignore qof_stats_enabled;
+%ignore qof_stat_record;
+%ignore qof_stats_snapshot_free;
+%newobject qof_stats_snapshot;
+%ignore QofStatTimer;
+%newobject qof_stats_to_string;
+%include "qofstats.h"
+
 %inline %{
 static const GncGUID * gncPriceGetGUID(GNCPrice *x)
 { return qof_instance_get_guid(QOF_INSTANCE(x)); }
@@ -406,6 +415,11 @@ void qof_book_set_string_option(QofBook* book, const char* opt_name, const char*
     SET_ENUM("OPTION-SECTION-BUDGETING");
     SET_ENUM("OPTION-NAME-DEFAULT-BUDGET");
 
+    SET_ENUM("OPTION-SECTION-SQLITE");
+    SET_ENUM("OPTION-NAME-SQLITE-PROFILE");
+    SET_ENUM("OPTION-NAME-SQLITE-SYNCHRONOUS");
+    SET_ENUM("OPTION-NAME-SQLITE-MEMORY-TEMP-STORE");
+
     SET_ENUM("ACCOUNT-CODE-");  /* sic */
 
     SET_ENUM("GNC-HOW-RND-CEIL");
@@ -35,6 +35,7 @@
 (export gnc:account-map-children)
 (export account-full-name<?)
 (export accounts-get-children-depth)
+(export gnc:query-for-each)
 
 ;; A few account related utility functions which used to be in engine-utilities.scm
 (define (gnc:account-map-descendants thunk account)
@@ -61,3 +62,24 @@ gnc:accounts-get-children-depth instead.")
                     (+ (gnc-account-get-current-depth acct)
                        (gnc-account-get-tree-depth acct)))
                   accounts))))
+
+;; Call proc with each result of query in turn, without making the
+;; list of all the results which qof-query-run returns. Returns #t, or
+;; #f without calling proc if the query is for results that Scheme
+;; can't be given.
+(define* (gnc:query-for-each proc query #:optional (chunk-size 1024))
+  (let ((cursor (gnc-query-cursor-new query)))
+    (and (not (null? cursor))
+         (dynamic-wind
+           (lambda () #f)
+           (lambda ()
+             (let loop ()
+               (let* ((chunk (gnc-query-cursor-next-vector cursor chunk-size))
+                      (len (vector-length chunk)))
+                 (unless (zero? len)
+                   (do ((i 0 (1+ i))) ((= i len))
+                     (proc (vector-ref chunk i)))
+                   (loop))))
+             #t)
+           (lambda ()
+             (gnc-query-cursor-destroy cursor))))))
@@ -64,6 +64,34 @@
 /* This static indicates the debugging module this .o belongs to.  */
 static QofLogModule UNUSED_VAR log_module = GNC_MOD_GUILE;
 
+/* SWIG_TypeQuery compares the name with every type SWIG knows of, so
+ * remember what it found. The swig_type_info structures are static and
+ * never go away. */
+static GHashTable *swig_types = NULL;
+G_LOCK_DEFINE_STATIC (swig_types);
+
+swig_type_info *
+gnc_scm_swig_type (const gchar *type_name)
+{
+    swig_type_info *stype;
+
+    g_return_val_if_fail (type_name, NULL);
+
+    G_LOCK (swig_types);
+    if (!swig_types)
+        swig_types = g_hash_table_new (g_str_hash, g_str_equal);
+    stype = g_hash_table_lookup (swig_types, type_name);
+    if (!stype)
+    {
+        stype = SWIG_TypeQuery (type_name);
+        if (stype)
+            g_hash_table_insert (swig_types, g_strdup (type_name), stype);
+    }
+    G_UNLOCK (swig_types);
+
+    return stype;
+}
+
 static SCM
 glist_to_scm_list_helper(GList *glist, swig_type_info *wct)
 {
@@ -79,11 +107,23 @@ glist_to_scm_list_helper(GList *glist, swig_type_info *wct)
 SCM
 gnc_glist_to_scm_list(GList *glist, gchar *wct)
 {
-    swig_type_info *stype = SWIG_TypeQuery(wct);
+    swig_type_info *stype = gnc_scm_swig_type(wct);
     g_return_val_if_fail(stype, SCM_UNDEFINED);
     return glist_to_scm_list_helper(glist, stype);
 }
 
+static void *
+scm_to_wcp(SCM scm_item, const char *func_name)
+{
+    if (scm_is_false(scm_item))
+        return NULL;
+
+    if (!SWIG_IsPointer(scm_item))
+        scm_misc_error(func_name, "Item in list not a wcp.", scm_item);
+
+    return (void *)SWIG_PointerAddress(scm_item);
+}
+
 GList *
 gnc_scm_list_to_glist(SCM rest)
 {
@@ -95,24 +135,11 @@ gnc_scm_list_to_glist(SCM rest)
 
     while (!scm_is_null(rest))
     {
-        void *item;
-
         scm_item = SCM_CAR(rest);
         rest = SCM_CDR(rest);
 
-        if (scm_item == SCM_BOOL_F)
-        {
-            result = g_list_prepend(result, NULL);
-        }
-        else
-        {
-            if (!SWIG_IsPointer(scm_item))
-                scm_misc_error("gnc_scm_list_to_glist",
-                               "Item in list not a wcp.", scm_item);
-
-            item = (void *)SWIG_PointerAddress(scm_item);
-            result = g_list_prepend(result, item);
-        }
+        result = g_list_prepend(result,
+                                scm_to_wcp(scm_item, "gnc_scm_list_to_glist"));
     }
 
     return g_list_reverse(result);
@@ -28,6 +28,10 @@
 #include <glib.h>
 #include <libguile.h>
 
+/** The SWIG type called type_name, e.g. "_p_Split", or NULL if there is
+ * none. Unlike SWIG_TypeQuery it only searches for each name once. */
+struct swig_type_info *gnc_scm_swig_type(const gchar *type_name);
+
 SCM gnc_glist_to_scm_list(GList *glist, gchar *wct);
 GList* gnc_scm_list_to_glist(SCM wcp_list);
 
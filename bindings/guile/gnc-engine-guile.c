@@ -29,6 +29,8 @@
 #include <string.h>
 
 #include "Account.h"
+#include "gncEntry.h"
+#include "gncInvoice.h"
 #include "engine-helpers.h"
 #include "gnc-engine-guile.h"
 #include "glib-guile.h"
@@ -1718,6 +1720,103 @@ gnc_scm2query (SCM query_scm)
     return q;
 }
 
+struct _GncQueryCursor
+{
+    QofQuery *query;
+    GList *next;
+    swig_type_info *stype;
+};
+
+static const struct
+{
+    const char *search_for;
+    const char *swig_type;
+} query_result_types[] =
+{
+    { GNC_ID_SPLIT, "_p_Split" },
+    { GNC_ID_TRANS, "_p_Transaction" },
+    { GNC_ID_ACCOUNT, "_p_Account" },
+    { GNC_ID_LOT, "_p_GNCLot" },
+    { GNC_ID_PRICE, "_p_GNCPrice" },
+    { GNC_ID_INVOICE, "_p__gncInvoice" },
+    { GNC_ID_ENTRY, "_p__gncEntry" },
+};
+
+GncQueryCursor *
+gnc_query_cursor_new (QofQuery *q)
+{
+    GncQueryCursor *cursor;
+    swig_type_info *stype = NULL;
+    QofIdType search_for;
+    size_t i;
+
+    if (!q) return NULL;
+
+    search_for = qof_query_get_search_for (q);
+    for (i = 0; i < G_N_ELEMENTS (query_result_types); i++)
+        if (!g_strcmp0 (search_for, query_result_types[i].search_for))
+        {
+            stype = gnc_scm_swig_type (query_result_types[i].swig_type);
+            break;
+        }
+    if (!stype)
+    {
+        PERR ("No SWIG type for query results of type %s", search_for);
+        return NULL;
+    }
+
+    /* Run a copy so the results stay valid whatever happens to q. */
+    cursor = g_new0 (GncQueryCursor, 1);
+    cursor->query = qof_query_copy (q);
+    cursor->next = qof_query_run (cursor->query);
+    cursor->stype = stype;
+    return cursor;
+}
+
+SCM
+gnc_query_cursor_next (GncQueryCursor *cursor)
+{
+    gpointer item;
+
+    if (!cursor || !cursor->next) return SCM_BOOL_F;
+
+    item = cursor->next->data;
+    cursor->next = cursor->next->next;
+    return SWIG_NewPointerObj (item, cursor->stype, 0);
+}
+
+SCM
+gnc_query_cursor_next_vector (GncQueryCursor *cursor, gint max_items)
+{
+    SCM vector;
+    GList *node;
+    gint i, n = 0;
+
+    if (!cursor || max_items <= 0)
+        return scm_c_make_vector (0, SCM_BOOL_F);
+
+    for (node = cursor->next; node && n < max_items; node = node->next)
+        n++;
+
+    vector = scm_c_make_vector (n, SCM_BOOL_F);
+    for (i = 0; i < n; i++)
+    {
+        SCM_SIMPLE_VECTOR_SET (vector, i,
+                               SWIG_NewPointerObj (cursor->next->data,
+                                                   cursor->stype, 0));
+        cursor->next = cursor->next->next;
+    }
+    return vector;
+}
+
+void
+gnc_query_cursor_destroy (GncQueryCursor *cursor)
+{
+    if (!cursor) return;
+    qof_query_destroy (cursor->query);
+    g_free (cursor);
+}
+
 gnc_numeric
 gnc_scm_to_numeric(SCM gncnum)
 {
@@ -1752,7 +1851,7 @@ gnc_generic_to_scm(const void *cx, const gchar *type_str)
     void *x = (void*) cx;
 
     if (!x) return SCM_BOOL_F;
-    stype = SWIG_TypeQuery(type_str);
+    stype = gnc_scm_swig_type(type_str);
 
     if (!stype)
     {
@@ -1768,7 +1867,7 @@ gnc_scm_to_generic(SCM scm, const gchar *type_str)
 {
     swig_type_info * stype = NULL;
 
-    stype = SWIG_TypeQuery(type_str);
+    stype = gnc_scm_swig_type(type_str);
     if (!stype)
     {
         PERR("Unknown SWIG Type: %s ", type_str);
@@ -1878,7 +1977,7 @@ scm_hook_cb (gpointer data, GncScmDangler *scm)
     {
         // XXX: FIXME: We really should make sure this is a session!!! */
         scm_call_1 (scm->proc,
-            SWIG_NewPointerObj(data, SWIG_TypeQuery("_p_QofSession"), 0));
+            SWIG_NewPointerObj(data, gnc_scm_swig_type("_p_QofSession"), 0));
     }
 
     LEAVE("");
@@ -49,6 +49,24 @@ GSList * gnc_query_scm2path (SCM path_scm);
 SCM gnc_query2scm (QofQuery * q);
 QofQuery * gnc_scm2query (SCM query_scm);
 
+/** A cursor over the results of a query, for walking through them from
+ * Scheme without converting them all to a list as qof-query-run does. */
+typedef struct _GncQueryCursor GncQueryCursor;
+
+/** Run a copy of the query q, which may then be changed or destroyed.
+ * Returns NULL if q doesn't search for splits, transactions, accounts,
+ * lots, prices, invoices or entries. */
+GncQueryCursor * gnc_query_cursor_new (QofQuery *q);
+
+/** The next result of the query, or #f after the last. */
+SCM gnc_query_cursor_next (GncQueryCursor *cursor);
+
+/** A vector of the next max_items results, fewer at the end of the
+ * results and empty after the last. */
+SCM gnc_query_cursor_next_vector (GncQueryCursor *cursor, gint max_items);
+
+void gnc_query_cursor_destroy (GncQueryCursor *cursor);
+
 SCM gnc_numeric_to_scm(gnc_numeric arg);
 gnc_numeric gnc_scm_to_numeric(SCM arg);
 gnc_commodity * gnc_scm_to_commodity(SCM scm);
@@ -0,0 +1,33 @@
+(use-modules (srfi srfi-64))
+(use-modules (tests srfi64-extras))
+(use-modules (gnucash engine))
+(use-modules (gnucash app-utils))
+
+(define (run-test)
+  (test-runner-factory gnc:test-runner)
+  (test-begin "test-qof-stats")
+  (test-stats-snapshot)
+  (test-end "test-qof-stats"))
+
+(define (test-stats-snapshot)
+  (let ((query (qof-query-create-for-splits)))
+    (qof-query-set-book query (gnc-get-current-book))
+    (test-begin "qof-stats-snapshot")
+    (qof-stats-reset)
+    (qof-stats-set-enabled #t)
+    (qof-query-run query)
+    (qof-query-run query)
+    (qof-stats-set-enabled #f)
+    (let ((stat (assoc "qof.query.run" (qof-stats-snapshot))))
+      (test-assert "query runs are recorded" stat)
+      (test-equal "name count total-ns max-ns" 4 (length stat))
+      (test-equal "count" 2 (cadr stat))
+      (test-assert "longest within total" (<= (cadddr stat) (caddr stat))))
+    (qof-query-run query)
+    (test-equal "nothing is recorded while disabled"
+      2 (cadr (assoc "qof.query.run" (qof-stats-snapshot))))
+    (qof-stats-reset)
+    (test-equal "reset forgets the runs"
+      0 (cadr (assoc "qof.query.run" (qof-stats-snapshot))))
+    (test-end "qof-stats-snapshot")
+    (qof-query-destroy query)))
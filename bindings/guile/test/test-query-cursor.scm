@@ -0,0 +1,64 @@
+(use-modules (srfi srfi-1))
+(use-modules (srfi srfi-64))
+(use-modules (tests srfi64-extras))
+(use-modules (tests test-engine-extras))
+(use-modules (gnucash engine))
+
+(define (run-test)
+  (test-runner-factory gnc:test-runner)
+  (test-begin "test-query-cursor")
+  (test-query-cursor)
+  (test-end "test-query-cursor"))
+
+(define (make-split-query account)
+  (let ((query (qof-query-create-for-splits)))
+    (qof-query-set-book query (gnc-get-current-book))
+    (xaccQueryAddSingleAccountMatch query account QOF-QUERY-AND)
+    query))
+
+(define (test-query-cursor)
+  (let* ((env (create-test-env))
+         (accounts (env-create-test-accounts env))
+         (bank (assoc-ref accounts "Bank"))
+         (wallet (assoc-ref accounts "Wallet")))
+
+    (for-each
+     (lambda (day) (env-transfer env day 1 2020 bank wallet 10))
+     (iota 5 1))
+
+    (let* ((query (make-split-query wallet))
+           (splits (qof-query-run query)))
+
+      (test-begin "gnc:query-for-each")
+      (let ((seen '()))
+        (gnc:query-for-each (lambda (split) (set! seen (cons split seen)))
+                            query)
+        (test-equal "all results in order" splits (reverse seen)))
+      (let ((seen '()))
+        (gnc:query-for-each (lambda (split) (set! seen (cons split seen)))
+                            query 2)
+        (test-equal "in chunks smaller than the results"
+          splits (reverse seen)))
+      (let ((budgets (qof-query-create-for "Budget"))
+            (called #f))
+        (qof-query-set-book budgets (gnc-get-current-book))
+        (test-equal "#f for results Scheme can't be given"
+          #f (gnc:query-for-each (lambda (budget) (set! called #t)) budgets))
+        (test-assert "proc isn't called" (not called))
+        (qof-query-destroy budgets))
+      (test-end "gnc:query-for-each")
+
+      (test-begin "gnc-query-cursor")
+      (let ((cursor (gnc-query-cursor-new query)))
+        (qof-query-destroy query)
+        (test-equal "the query may be destroyed"
+          (car splits) (gnc-query-cursor-next cursor))
+        (test-equal "next-vector stops at the end"
+          (list->vector (cdr splits))
+          (gnc-query-cursor-next-vector cursor 10))
+        (test-equal "empty vector after the last result"
+          (vector) (gnc-query-cursor-next-vector cursor 10))
+        (test-equal "#f after the last result"
+          #f (gnc-query-cursor-next cursor))
+        (gnc-query-cursor-destroy cursor))
+      (test-end "gnc-query-cursor"))))
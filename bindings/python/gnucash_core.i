@@ -51,6 +51,7 @@
 #include "qofbook.h"
 #include "qofbackend.h"
 #include "qoflog.h"
+#include "qofstats.h"
 #include "qofutil.h"
 #include "qofid.h"
 #include "guid.h"
@@ -105,6 +106,14 @@
 
 %include <qofquerycore.h>
 
+%ignore qof_stats_active;
+%ignore qof_stats_enabled;
+%ignore qof_stat_record;
+%ignore qof_stats_snapshot_free;
+%newobject qof_stats_snapshot;
+%newobject qof_stats_to_string;
+%include <qofstats.h>
+
 /* SWIG doesn't like this macro, so redefine it to simply mean const */
 #define G_CONST_RETURN const
 %include <guid.h>
@@ -215,6 +224,187 @@ static const GncGUID * gncEntryGetGUID(GncEntry *x);
 %include <cap-gains.h>
 %include <Scrub3.h>
 
+/* Columnar split export, wrapped by SplitColumns in gnucash_core.py.
+ * Every column is a bytearray filled here, so no Python object is made
+ * per split. */
+%{
+enum
+{
+    SPLIT_COL_POST_DATE,
+    SPLIT_COL_AMOUNT_NUM,
+    SPLIT_COL_AMOUNT_DENOM,
+    SPLIT_COL_VALUE_NUM,
+    SPLIT_COL_VALUE_DENOM,
+    SPLIT_COL_NUM_INT64
+};
+
+static const char *split_int64_col_names[SPLIT_COL_NUM_INT64] =
+{
+    "post_date", "amount_num", "amount_denom", "value_num", "value_denom"
+};
+
+static PyObject *
+split_columns_add (PyObject *columns, const char *name, Py_ssize_t size,
+                   char **data)
+{
+    PyObject *column = PyByteArray_FromStringAndSize (NULL, size);
+    if (!column)
+        return NULL;
+    if (PyDict_SetItemString (columns, name, column) < 0)
+    {
+        Py_DECREF (column);
+        return NULL;
+    }
+    Py_DECREF (column);
+    *data = PyByteArray_AS_STRING (column);
+    return column;
+}
+
+static PyObject *
+split_columns_new (GList *splits)
+{
+    Py_ssize_t n = g_list_length (splits);
+    PyObject *columns = PyDict_New ();
+    PyObject *accounts = NULL, *memo = NULL;
+    gint64 *int64_cols[SPLIT_COL_NUM_INT64];
+    gint32 *account_index;
+    guchar *guids, *trans_guids;
+    gint64 *memo_offsets;
+    GHashTable *account_indices = NULL;
+    GString *memo_buf = NULL;
+    Py_ssize_t i;
+    GList *node;
+    char *data;
+    int c;
+
+    if (!columns)
+        return NULL;
+
+    for (c = 0; c < SPLIT_COL_NUM_INT64; c++)
+    {
+        if (!split_columns_add (columns, split_int64_col_names[c],
+                                n * sizeof (gint64), &data))
+            goto error;
+        int64_cols[c] = (gint64*) data;
+    }
+    if (!split_columns_add (columns, "account_index", n * sizeof (gint32), &data))
+        goto error;
+    account_index = (gint32*) data;
+    if (!split_columns_add (columns, "guid", n * GUID_DATA_SIZE, &data))
+        goto error;
+    guids = (guchar*) data;
+    if (!split_columns_add (columns, "transaction_guid", n * GUID_DATA_SIZE, &data))
+        goto error;
+    trans_guids = (guchar*) data;
+    if (!split_columns_add (columns, "memo_offsets", (n + 1) * sizeof (gint64), &data))
+        goto error;
+    memo_offsets = (gint64*) data;
+
+    accounts = PyList_New (0);
+    if (!accounts || PyDict_SetItemString (columns, "accounts", accounts) < 0)
+        goto error;
+
+    account_indices = g_hash_table_new (g_direct_hash, g_direct_equal);
+    memo_buf = g_string_new (NULL);
+
+    for (node = splits, i = 0; node; node = node->next, i++)
+    {
+        Split *split = node->data;
+        Transaction *trans = xaccSplitGetParent (split);
+        Account *account = xaccSplitGetAccount (split);
+        gnc_numeric amount = xaccSplitGetAmount (split);
+        gnc_numeric value = xaccSplitGetValue (split);
+        const char *split_memo = xaccSplitGetMemo (split);
+        gpointer index;
+
+        int64_cols[SPLIT_COL_POST_DATE][i] = trans ? xaccTransGetDate (trans) : 0;
+        int64_cols[SPLIT_COL_AMOUNT_NUM][i] = amount.num;
+        int64_cols[SPLIT_COL_AMOUNT_DENOM][i] = amount.denom;
+        int64_cols[SPLIT_COL_VALUE_NUM][i] = value.num;
+        int64_cols[SPLIT_COL_VALUE_DENOM][i] = value.denom;
+
+        /* Index 0 of the hash table means not seen yet, so store index + 1. */
+        if (!account)
+            account_index[i] = -1;
+        else if ((index = g_hash_table_lookup (account_indices, account)))
+            account_index[i] = GPOINTER_TO_INT (index) - 1;
+        else
+        {
+            PyObject *item = SWIG_NewPointerObj (account, SWIGTYPE_p_Account, 0);
+            if (!item || PyList_Append (accounts, item) < 0)
+            {
+                Py_XDECREF (item);
+                goto error;
+            }
+            Py_DECREF (item);
+            account_index[i] = PyList_GET_SIZE (accounts) - 1;
+            g_hash_table_insert (account_indices, account,
+                                 GINT_TO_POINTER (account_index[i] + 1));
+        }
+
+        memcpy (guids + i * GUID_DATA_SIZE,
+                qof_entity_get_guid (QOF_INSTANCE (split))->reserved,
+                GUID_DATA_SIZE);
+        if (trans)
+            memcpy (trans_guids + i * GUID_DATA_SIZE,
+                    qof_entity_get_guid (QOF_INSTANCE (trans))->reserved,
+                    GUID_DATA_SIZE);
+        else
+            memset (trans_guids + i * GUID_DATA_SIZE, 0, GUID_DATA_SIZE);
+
+        memo_offsets[i] = memo_buf->len;
+        if (split_memo)
+            g_string_append (memo_buf, split_memo);
+    }
+    memo_offsets[n] = memo_buf->len;
+
+    memo = PyByteArray_FromStringAndSize (memo_buf->str, memo_buf->len);
+    if (!memo || PyDict_SetItemString (columns, "memo", memo) < 0)
+        goto error;
+
+    Py_DECREF (memo);
+    Py_DECREF (accounts);
+    g_string_free (memo_buf, TRUE);
+    g_hash_table_destroy (account_indices);
+    return columns;
+
+error:
+    Py_XDECREF (memo);
+    Py_XDECREF (accounts);
+    Py_DECREF (columns);
+    if (memo_buf)
+        g_string_free (memo_buf, TRUE);
+    if (account_indices)
+        g_hash_table_destroy (account_indices);
+    return NULL;
+}
+
+static PyObject *
+gnc_query_split_columns (QofQuery *query)
+{
+    if (!query || g_strcmp0 (qof_query_get_search_for (query), GNC_ID_SPLIT))
+    {
+        PyErr_SetString (PyExc_TypeError, "the query must search for splits");
+        return NULL;
+    }
+    return split_columns_new (qof_query_run (query));
+}
+
+static PyObject *
+gnc_account_split_columns (Account *account)
+{
+    if (!account)
+    {
+        PyErr_SetString (PyExc_TypeError, "no account");
+        return NULL;
+    }
+    return split_columns_new (xaccAccountGetSplitList (account));
+}
+%}
+
+PyObject *gnc_query_split_columns (QofQuery *query);
+PyObject *gnc_account_split_columns (Account *account);
+
 %init %{
 gnc_environment_setup();
 qof_log_init();
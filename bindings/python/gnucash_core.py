@@ -28,6 +28,7 @@
 #  @author Jeff Green,   ParIT Worker Co-operative <jeff@parit.ca>
 #  @ingroup python_bindings
 
+from contextlib import contextmanager
 from enum import IntEnum
 from urllib.parse import urlparse
 
@@ -48,7 +49,7 @@ from gnucash.gnucash_core_c import gncInvoiceLookup, gncInvoiceGetInvoiceFromTxn
     gnc_search_vendor_on_id, gncInvoiceNextID, gncCustomerNextID, \
     gncVendorNextID, gncTaxTableGetTables, gnc_numeric_zero, \
     gnc_numeric_create, double_to_gnc_numeric, string_to_gnc_numeric, \
-    gnc_numeric_to_string
+    gnc_numeric_to_string, gnc_book_begin_bulk_load, gnc_book_end_bulk_load
 
 from gnucash.deprecation import (
     deprecated_args_session,
@@ -302,6 +303,7 @@ class Book(GnuCashCoreClass):
     Methods of interest
     get_root_account -- Returns the root level Account
     get_table -- Returns a commodity lookup table, of type GncCommodityTable
+    bulk_load -- Context manager for adding many transactions at once
     """
     def InvoiceLookup(self, guid):
         from gnucash.gnucash_business import Invoice
@@ -367,6 +369,23 @@ class Book(GnuCashCoreClass):
         return self.do_lookup_create_oo_instance(
             gnc_search_vendor_on_id, Vendor, id)
 
+    @contextmanager
+    def bulk_load(self):
+        """Defer split sorting, balance computation, events and backend
+        commits until the end of the with block, see
+        gnc_book_begin_bulk_load() in Account.h. Use it around code that
+        adds many transactions:
+
+        with book.bulk_load():
+            for row in rows:
+                ...
+        """
+        gnc_book_begin_bulk_load(self.instance)
+        try:
+            yield self
+        finally:
+            gnc_book_end_bulk_load(self.instance)
+
     def InvoiceNextID(self, customer):
       ''' Return the next invoice ID.
       '''
@@ -618,6 +637,74 @@ class Account(GnuCashCoreClass):
     """
     _new_instance = 'xaccMallocAccount'
 
+    def split_columns(self):
+        """Return the splits of this account as SplitColumns, in the order
+        of GetSplitList."""
+        return SplitColumns(gnc_account_split_columns(self.instance))
+
+from gnucash.gnucash_core_c import \
+    gnc_account_split_columns, gnc_query_split_columns
+
+class SplitColumns(object):
+    """The data of many splits, a column per field and an entry per split.
+
+    post_date (seconds since the epoch), amount_num, amount_denom, value_num,
+    value_denom and memo_offsets are int64 arrays, account_index is an int32
+    array of indices into accounts (-1 for a split without account), guid
+    and transaction_guid are byte arrays of shape (n, 16), a row of 16
+    bytes per split. The UTF-8 memo of split i is
+    memo[memo_offsets[i]:memo_offsets[i + 1]].
+
+    The arrays are NumPy arrays if NumPy can be imported and memoryviews
+    otherwise. Either way they use the buffers the columns were filled in,
+    nothing is copied per split.
+    """
+
+    def __init__(self, columns):
+        try:
+            import numpy
+        except ImportError:
+            numpy = None
+
+        def array(name, fmt, dtype):
+            if numpy is not None:
+                return numpy.frombuffer(columns[name], dtype=dtype)
+            return memoryview(columns[name]).cast(fmt)
+
+        def guids(name):
+            if numpy is not None:
+                return numpy.frombuffer(columns[name],
+                                        dtype='uint8').reshape(-1, 16)
+            view = memoryview(columns[name])
+            # memoryview won't take a shape with a 0 in it
+            if not len(view):
+                return view.cast('B')
+            return view.cast('B', (len(view) // 16, 16))
+
+        for name in ('post_date', 'amount_num', 'amount_denom',
+                     'value_num', 'value_denom', 'memo_offsets'):
+            setattr(self, name, array(name, 'q', 'int64'))
+        self.account_index = array('account_index', 'i', 'int32')
+        self.guid = guids('guid')
+        self.transaction_guid = guids('transaction_guid')
+        self.memo = memoryview(columns['memo'])
+        self._guids = memoryview(columns['guid'])
+        self.accounts = [Account(instance=account)
+                         for account in columns['accounts']]
+
+    def __len__(self):
+        return len(self.memo_offsets) - 1
+
+    def get_memo(self, index):
+        """Return the memo of split index as a str."""
+        start, end = self.memo_offsets[index], self.memo_offsets[index + 1]
+        return bytes(self.memo[start:end]).decode('utf-8')
+
+    def get_guid(self, index):
+        """Return the GUID of split index as a hex string, like
+        GUID.to_string."""
+        return bytes(self._guids[index * 16:(index + 1) * 16]).hex()
+
 class GUID(GnuCashCoreClass):
     _new_instance = 'guid_new_return'
 
@@ -918,6 +1005,11 @@ class Query(GnuCashCoreClass):
         self.__search_for_buf = obj_type
         self._search_for(self.__search_for_buf)
 
+    def split_columns(self):
+        """Run the query, which must search for splits, and return the
+        splits found as SplitColumns."""
+        return SplitColumns(gnc_query_split_columns(self.instance))
+
 Query.add_constructor_and_methods_with_prefix('qof_query_', 'create', exclude=["qof_query_search_for"])
 
 Query.add_method('qof_query_set_book', 'set_book')
@@ -959,3 +1051,18 @@ class QueryGuidPredicate(GnuCashCoreClass):
 
 QueryGuidPredicate.add_constructor_and_methods_with_prefix(
     'qof_query_', 'guid_predicate')
+
+# Engine counters and timers, see qofstats.h
+from gnucash.gnucash_core_c import \
+    qof_stats_set_enabled, qof_stats_get_enabled, qof_stats_reset, \
+    qof_stats_get_count, qof_stats_get_total_ns, qof_stats_to_string, \
+    qof_stats_snapshot
+
+def stats_snapshot():
+    """Return the engine statistics recorded so far as a dict mapping each
+    name to a (count, total milliseconds, longest milliseconds) tuple."""
+    snapshot = {}
+    for name, count, total_ns, max_ns in qof_stats_snapshot():
+        if count:
+            snapshot[name] = (count, total_ns / 1e6, max_ns / 1e6)
+    return snapshot
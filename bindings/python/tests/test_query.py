@@ -1,6 +1,7 @@
 from unittest import TestCase, main
 
-from gnucash import Query
+from gnucash import Query, Session, qof_stats_set_enabled, qof_stats_reset, \
+    qof_stats_snapshot, stats_snapshot
 from gnucash.gnucash_core_c import GNC_ID_INVOICE
 
 
@@ -19,5 +20,26 @@ class TestQuery(TestCase):
         query.search_for(obj_type)
         self.assertEqual(query.get_search_for(), obj_type)
 
+    def test_stats(self):
+        ses = Session()
+        query = Query()
+        query.search_for('Split')
+        query.set_book(ses.get_book())
+
+        qof_stats_reset()
+        qof_stats_set_enabled(True)
+        query.run()
+        query.run()
+        qof_stats_set_enabled(False)
+        self.assertEqual(stats_snapshot()['qof.query.run'][0], 2)
+        name, count, total_ns, max_ns = next(
+            stat for stat in qof_stats_snapshot() if stat[0] == 'qof.query.run')
+        self.assertEqual(count, 2)
+        self.assertLessEqual(max_ns, total_ns)
+        query.run()
+        self.assertEqual(stats_snapshot()['qof.query.run'][0], 2)
+        query.destroy()
+        ses.end()
+
 if __name__ == '__main__':
     main()
@@ -1,6 +1,6 @@
 from unittest import main
 
-from gnucash import Book, Account, Split, Transaction
+from gnucash import Book, Account, Split, Transaction, GncNumeric, Query
 from unittest_support import *
 
 from test_book import BookSession
@@ -63,5 +63,69 @@ class TestSplit(SplitSession):
         self.assertTrue( self.split == TRANS.GetSplitList()[0] )
         self.assertTrue( self.split != Split(self.book) )
 
+class TestSplitColumns(BookSession):
+    def setUp(self):
+        BookSession.setUp(self)
+        self.bank = Account(self.book)
+        self.bank.SetCommodity(self.currency)
+        self.expense = Account(self.book)
+        self.expense.SetCommodity(self.currency)
+        root = self.book.get_root_account()
+        root.append_child(self.bank)
+        root.append_child(self.expense)
+
+        self.trans = Transaction(self.book)
+        self.trans.BeginEdit()
+        self.trans.SetCurrency(self.currency)
+        self.trans.SetDate(14, 3, 2006)
+        for account, num, memo in ((self.bank, -1250, "cash"),
+                                   (self.expense, 1250, "lunch \u00e0 la carte")):
+            split = Split(self.book)
+            split.SetParent(self.trans)
+            split.SetAccount(account)
+            split.SetValue(GncNumeric(num, 100))
+            split.SetAmount(GncNumeric(num, 100))
+            split.SetMemo(memo)
+        self.trans.CommitEdit()
+
+    def check_columns(self, columns, splits):
+        # queries don't keep the order of the split list
+        splits = dict((split.GetGUID().to_string(), split) for split in splits)
+        self.assertEqual(len(columns), len(splits))
+        self.assertEqual(tuple(columns.guid.shape), (len(columns), 16))
+        self.assertEqual(tuple(columns.transaction_guid.shape),
+                         (len(columns), 16))
+        for i in range(len(columns)):
+            split = splits[columns.get_guid(i)]
+            self.assertEqual(columns.post_date[i], self.trans.GetDate())
+            self.assertEqual(columns.amount_num[i], split.GetAmount().num())
+            self.assertEqual(columns.amount_denom[i], split.GetAmount().denom())
+            self.assertEqual(columns.value_num[i], split.GetValue().num())
+            self.assertEqual(columns.value_denom[i], split.GetValue().denom())
+            self.assertEqual(columns.get_memo(i), split.GetMemo())
+            account = columns.accounts[columns.account_index[i]]
+            self.assertTrue(account.Equal(split.GetAccount(), True))
+
+    def test_account(self):
+        columns = self.bank.split_columns()
+        self.check_columns(columns, self.bank.GetSplitList())
+        self.assertEqual(len(columns.accounts), 1)
+
+    def test_query(self):
+        query = Query()
+        query.search_for('Split')
+        query.set_book(self.book)
+        columns = query.split_columns()
+        self.check_columns(columns, self.trans.GetSplitList())
+        self.assertEqual(len(columns.accounts), 2)
+        query.destroy()
+
+    def test_query_not_splits(self):
+        query = Query()
+        query.search_for('Trans')
+        query.set_book(self.book)
+        self.assertRaises(TypeError, query.split_columns)
+        query.destroy()
+
 if __name__ == '__main__':
     main()
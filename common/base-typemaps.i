@@ -139,6 +139,23 @@ typedef char gchar;
      }
  }
 
+%typemap(out) QofStatList * {
+  SCM list = SCM_EOL;
+  GList *node;
+
+  for (node = $1; node; node = node->next)
+  {
+    QofStatValue *value = (QofStatValue *)node->data;
+    list = scm_cons(scm_list_4(scm_from_utf8_string(value->name),
+                               scm_from_uint64(value->count),
+                               scm_from_uint64(value->total_ns),
+                               scm_from_uint64(value->max_ns)), list);
+  }
+
+  $result = scm_reverse(list);
+}
+%typemap(newfree) QofStatList * "qof_stats_snapshot_free($1);"
+
 %define GLIST_HELPER_INOUT(ListType, ElemSwigType)
 %typemap(in) ListType * {
   SCM list = $input;
@@ -266,6 +283,23 @@ typedef char gchar;
     }
 }
 
+%typemap(out) QofStatList * {
+    GList *l;
+    PyObject *list = PyList_New(0);
+    for (l = $1; l != NULL; l = l->next)
+    {
+        QofStatValue *value = (QofStatValue *)l->data;
+        PyObject *item = Py_BuildValue("(sKKK)", value->name,
+                                       (unsigned long long)value->count,
+                                       (unsigned long long)value->total_ns,
+                                       (unsigned long long)value->max_ns);
+        PyList_Append(list, item);
+        Py_DECREF(item);
+    }
+    $result = list;
+}
+%typemap(newfree) QofStatList * "qof_stats_snapshot_free($1);"
+
 %typemap(out) GList *, CommodityList *, SplitList *, AccountList *, LotList *,
     MonetaryList *, PriceList *, EntryList * {
     gpointer data;
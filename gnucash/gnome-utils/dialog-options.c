@@ -3367,7 +3367,7 @@ gnc_option_set_ui_value_account_sel (GNCOption *option, gboolean use_default,
             scm_misc_error ("gnc_option_set_ui_value_account_sel",
                             "Option Value not a wcp.", value);
 
-        acc = SWIG_MustGetPtr (value, SWIG_TypeQuery ("_p_Account"), 4, 0);
+        acc = SWIG_MustGetPtr (value, gnc_scm_swig_type ("_p_Account"), 4, 0);
     }
 
     //doesn't default because this function is called to set a specific account
@@ -3902,7 +3902,7 @@ gnc_option_get_ui_value_account_sel (GNCOption *option, GtkWidget *widget)
     if (!acc)
         return SCM_BOOL_F;
 
-    return SWIG_NewPointerObj (acc, SWIG_TypeQuery ("_p_Account"), 0);
+    return SWIG_NewPointerObj (acc, gnc_scm_swig_type ("_p_Account"), 0);
 }
 
 static SCM
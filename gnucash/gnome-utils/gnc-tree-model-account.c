@@ -562,6 +562,7 @@ gnc_tree_model_account_compute_period_balance (GncTreeModelAccount *model,
     GncTreeModelAccountPrivate *priv;
     time64 t1, t2;
     gnc_numeric b3;
+    char buf[256];
 
     if (negative)
         *negative = FALSE;
@@ -583,7 +584,9 @@ gnc_tree_model_account_compute_period_balance (GncTreeModelAccount *model,
     if (negative)
         *negative = gnc_numeric_negative_p (b3);
 
-    return g_strdup(xaccPrintAmount (b3, gnc_account_print_info (acct, TRUE)));
+    gnc_amount_formatter_print (gnc_account_amount_formatter (acct, TRUE),
+                                b3, buf, sizeof(buf));
+    return g_strdup (buf);
 }
 
 static gboolean
@@ -1751,6 +1751,15 @@ return a document object with export-string or export-error."));
         }
         result = TRUE;
     }
+    else if (priv->cur_report != SCM_BOOL_F)
+    {
+        /* Render the report again straight to the file rather than write
+         * out the viewer's copy, so a large report isn't held in memory
+         * a second time. */
+        SCM get_id = scm_c_eval_string ("gnc:report-id");
+        gint report_id = scm_to_int (scm_call_1 (get_id, priv->cur_report));
+        result = gnc_run_report_to_file (report_id, filepath);
+    }
     else
         result = gnc_html_export_to_file (priv->html, filepath);
 
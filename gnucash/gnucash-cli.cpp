@@ -38,6 +38,7 @@ extern "C" {
 
 #include <boost/locale.hpp>
 #include <boost/optional.hpp>
+#include <cstdlib>
 #include <iostream>
 
 namespace bl = boost::locale;
@@ -63,10 +64,22 @@ namespace Gnucash {
         boost::optional <std::string> m_report_name;
         boost::optional <std::string> m_export_type;
         boost::optional <std::string> m_output_file;
+
+        bool m_show_stats = false;
     };
 
 }
 
+/* The commands end with gnc_shutdown(), which exits, so the statistics
+ * are printed from an atexit handler. */
+static void
+print_stats (void)
+{
+    auto stats = qof_stats_to_string ();
+    std::cerr << "name count total-ms max-ms\n" << stats;
+    g_free (stats);
+}
+
 Gnucash::GnucashCli::GnucashCli (const char *app_name) : Gnucash::CoreApp (app_name)
 {
     configure_program_options();
@@ -82,6 +95,12 @@ Gnucash::GnucashCli::parse_command_line (int argc, char **argv)
 
     if (m_namespace)
         gnc_prefs_set_namespace_regexp (m_namespace->c_str());
+
+    if (m_show_stats)
+    {
+        qof_stats_set_enabled (TRUE);
+        atexit (print_stats);
+    }
 }
 
 // Define command line options specific to gnucash-cli.
@@ -115,6 +134,12 @@ may be specified to describe some saved options.\n"
     m_opt_desc_display->add (report_options);
     m_opt_desc_all.add (report_options);
 
+    bpo::options_description stats_options(_("Diagnostic Options"));
+    stats_options.add_options()
+    ("stats", bpo::bool_switch (&m_show_stats),
+     _("Print the engine's counters and timers to stderr on exit"));
+    m_opt_desc_display->add (stats_options);
+    m_opt_desc_all.add (stats_options);
 }
 
 int
@@ -39,6 +39,7 @@ extern "C" {
 #include <gnc-report.h>
 #include <gnc-session.h>
 #include <qoflog.h>
+#include <qofstats.h>
 }
 
 #include <boost/locale.hpp>
@@ -168,9 +169,12 @@ scm_run_report (void *data,
     auto args = static_cast<run_report_args*>(data);
 
     scm_c_eval_string("(debug-set! stack 200000)");
-    scm_c_use_module ("gnucash utilities");
-    scm_c_use_module ("gnucash app-utils");
-    scm_c_use_module ("gnucash reports");
+    {
+        QOF_STAT_SCOPED_TIMER ("startup.scheme-modules");
+        scm_c_use_module ("gnucash utilities");
+        scm_c_use_module ("gnucash app-utils");
+        scm_c_use_module ("gnucash reports");
+    }
 
     gnc_report_init ();
     // load_system_config();
@@ -214,7 +218,11 @@ scm_run_report (void *data,
 
     if (!args->export_type.empty())
     {
-        SCM retval = scm_call_2 (run_export_cmd, report, type);
+        SCM retval;
+        {
+            QOF_STAT_SCOPED_TIMER ("report.render");
+            retval = scm_call_2 (run_export_cmd, report, type);
+        }
         SCM query_result = scm_c_eval_string ("gnc:html-document?");
         SCM get_export_string = scm_c_eval_string ("gnc:html-document-export-string");
         SCM get_export_error = scm_c_eval_string ("gnc:html-document-export-error");
@@ -260,18 +268,21 @@ return a document object with export-string or export-error.") << std::endl;
 
         if (scm_is_false (id))
             scm_cleanup_and_exit_with_failure (nullptr);
-        char* html;
-        gnc_run_report (scm_to_int(id), &html);
-        if (html && *html)
+        if (!args->output_file.empty())
         {
-            if (!args->output_file.empty())
-            {
-                write_report_file(html, args->output_file.c_str());
-            }
-            else
-            {
+            /* Large reports are written out as they are rendered. */
+            if (!gnc_run_report_to_file (scm_to_int(id),
+                                         args->output_file.c_str()))
+                std::cerr << "Failed to write report to "
+                          << args->output_file << "\n";
+        }
+        else
+        {
+            char* html;
+            gnc_run_report (scm_to_int(id), &html);
+            if (html && *html)
                 std::cout << html << std::endl;
-            }
+            g_free (html);
         }
     }
 
@@ -295,9 +306,12 @@ scm_report_show (void *data,
     auto args = static_cast<show_report_args*>(data);
 
     scm_c_eval_string("(debug-set! stack 200000)");
-    scm_c_use_module ("gnucash utilities");
-    scm_c_use_module ("gnucash app-utils");
-    scm_c_use_module ("gnucash reports");
+    {
+        QOF_STAT_SCOPED_TIMER ("startup.scheme-modules");
+        scm_c_use_module ("gnucash utilities");
+        scm_c_use_module ("gnucash app-utils");
+        scm_c_use_module ("gnucash reports");
+    }
     gnc_report_init ();
 
     if (!args->file_to_load.empty())
@@ -327,8 +341,11 @@ scm_report_list ([[maybe_unused]] void *data,
                  [[maybe_unused]] int argc, [[maybe_unused]] char **argv)
 {
     scm_c_eval_string("(debug-set! stack 200000)");
-    scm_c_use_module ("gnucash app-utils");
-    scm_c_use_module ("gnucash reports");
+    {
+        QOF_STAT_SCOPED_TIMER ("startup.scheme-modules");
+        scm_c_use_module ("gnucash app-utils");
+        scm_c_use_module ("gnucash reports");
+    }
     gnc_report_init ();
 
     scm_call_1 (scm_c_eval_string ("gnc:cmdline-report-list"),
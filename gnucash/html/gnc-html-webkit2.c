@@ -504,13 +504,16 @@ load_to_stream( GncHtmlWebkit* self, URLType type,
                          fdata = new_fdata;
                     }
 
-                    // Save a copy for export purposes
+                    // Keep the data; impl_webkit_show_data writes it to
+                    // the file the view loads. Exporting a report renders
+                    // it again, see gnc_plugin_page_report_export_cb.
                     if ( priv->html_string != NULL )
                     {
                          g_free( priv->html_string );
                     }
-                    priv->html_string = g_strdup( fdata );
+                    priv->html_string = fdata;
                     impl_webkit_show_data( GNC_HTML(self), fdata, strlen(fdata) );
+                    fdata = NULL;
 //                webkit_web_view_load_html (priv->web_view, fdata,
 //                                           BASE_URI_NAME);
                }
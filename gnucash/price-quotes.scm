@@ -24,6 +24,9 @@
 
 (export gnc:book-add-quotes) ;; called from gnome/dialog-price-edit-db.c
 (export gnc:price-quotes-install-sources)
+(export gnc:fq-get-quotes)
+(export gnc:fq-helper-command)
+(export gnc:fq-helper-workers)
 
 (use-modules (gnucash engine))
 (use-modules (gnucash utilities))
@@ -77,6 +80,15 @@
 (define gnc:*finance-quote-helper*
   (string-append (gnc-path-get-bindir) "/gnc-fq-helper"))
 
+(define gnc:fq-helper-command
+  ;; The command running a quote helper. The tests replace it with a
+  ;; stub which doesn't use the network.
+  (make-parameter (list "perl" "-w" gnc:*finance-quote-helper*)))
+
+(define gnc:fq-helper-workers
+  ;; The most quote helpers to run at once.
+  (make-parameter 4))
+
 (define (gnc:fq-get-quotes requests)
   ;; requests should be a list where each item is of the form
   ;;
@@ -114,47 +126,125 @@
   ;; 'failed-conversion if the Finance::Quote result for that field
   ;; was unparsable.  See the gnc-fq-helper for more details
   ;; about it's output.
-
-  (let ((quoter #f))
-
-    (define (start-quoter)
-      (set! quoter
-        (gnc-spawn-process-async (list "perl" "-w" gnc:*finance-quote-helper*) #t)))
-
-    (define (get-quotes)
-      (when quoter
-        (map
-         (lambda (request)
-           (catch #t
-             (lambda ()
+  ;;
+  ;; The requests are shared among up to (gnc:fq-helper-workers)
+  ;; helpers, all the requests for one method going to the same
+  ;; helper so that each source sees its requests in turn as before.
+  ;; Every helper is sent all its requests before any result is read,
+  ;; so they fetch their quotes at the same time.
+
+  (define (request-error request)
+    (and (member (car request) '("currency" "alphavantage" "vanguard"))
+         (not (getenv "ALPHAVANTAGE_API_KEY"))
+         'need-alphavantage-key))
+
+  (define (partition-requests indexed-requests)
+    ;; Group the (index . request) pairs by method and deal the groups,
+    ;; largest first, to the helper with the fewest requests so far.
+    ;; Returns a list of lists of (index . request) pairs.
+    (let ((groups (make-hash-table)))
+      (for-each
+       (lambda (item)
+         (hash-set! groups (cadr item)
+                    (cons item (hash-ref groups (cadr item) '()))))
+       indexed-requests)
+      (let* ((groups (sort (map reverse (hash-map->list (lambda (k v) v) groups))
+                           (lambda (a b) (> (length a) (length b)))))
+             (n-workers (max 1 (min (gnc:fq-helper-workers) (length groups))))
+             (workers (make-vector n-workers '())))
+        (define (least-loaded)
+          (let lp ((i 1) (best 0))
+            (cond
+             ((= i n-workers) best)
+             ((< (length (vector-ref workers i))
+                 (length (vector-ref workers best)))
+              (lp (1+ i) i))
+             (else (lp (1+ i) best)))))
+        (for-each
+         (lambda (group)
+           (let ((i (least-loaded)))
+             (vector-set! workers i (append (vector-ref workers i) group))))
+         groups)
+        (filter pair? (vector->list workers)))))
+
+  (define (send-request quoter request)
+    ;; we need to display the first element (the method,
+    ;; so it won't be quoted) and then write the rest
+    (with-output-to-port (fdes->outport (gnc-process-get-fd quoter 0))
+      (lambda ()
+        (display #\()
+        (display (car request))
+        (display " ")
+        (for-each write (cdr request))
+        (display #\))
+        (newline)
+        (force-output))))
+
+  (let* ((results (make-vector (length requests) #f))
+         (indexed-requests
+          (filter-map
+           (lambda (index request)
+             (let ((err (request-error request)))
                (gnc:debug "handling-request: " request)
-               (and (member (car request) '("currency" "alphavantage" "vanguard"))
-                    (not (getenv "ALPHAVANTAGE_API_KEY"))
-                    (throw 'need-alphavantage-key))
-               ;; we need to display the first element (the method,
-               ;; so it won't be quoted) and then write the rest
-               (with-output-to-port (fdes->outport (gnc-process-get-fd quoter 0))
-                 (lambda ()
-                   (display #\()
-                   (display (car request))
-                   (display " ")
-                   (for-each write (cdr request))
-                   (display #\))
-                   (newline)
-                   (force-output)))
-
-               (let ((results (read (fdes->inport (gnc-process-get-fd quoter 1)))))
-                 (gnc:debug "results: " results)
-                 results))
-             (lambda (key . args) key)))
-         requests)))
+               (cond
+                (err (vector-set! results index err) #f)
+                (else (cons index request)))))
+           (iota (length requests)) requests))
+         (workers (map (lambda (items) (cons #f items))
+                       (partition-requests indexed-requests))))
+
+    (define (start-quoters)
+      (for-each
+       (lambda (worker)
+         (let ((quoter (gnc-spawn-process-async (gnc:fq-helper-command) #t)))
+           (set-car! worker (and (not (null? quoter)) quoter))))
+       workers))
 
-    (define (kill-quoter)
-      (when quoter
-        (gnc-detach-process quoter #t)
-        (set! quoter #f)))
+    (define (get-quotes)
+      ;; sent holds, for each helper, (index . #t) for every request
+      ;; it will answer and (index . error-symbol) for the others.
+      (let ((sent
+             (map
+              (lambda (worker)
+                (map
+                 (lambda (item)
+                   (cons (car item)
+                         (if (car worker)
+                             (catch #t
+                               (lambda () (send-request (car worker) (cdr item)) #t)
+                               (lambda (key . args) key))
+                             'system-error)))
+                 (cdr worker)))
+              workers)))
+        (for-each
+         (lambda (worker worker-sent)
+           (for-each
+            (lambda (item)
+              (vector-set!
+               results (car item)
+               (if (eq? (cdr item) #t)
+                   (catch #t
+                     (lambda ()
+                       (let ((result (read (fdes->inport
+                                            (gnc-process-get-fd (car worker) 1)))))
+                         (gnc:debug "results: " result)
+                         result))
+                     (lambda (key . args) key))
+                   (cdr item))))
+            worker-sent))
+         workers sent)
+        (and (or (null? workers) (any car workers))
+             (vector->list results))))
+
+    (define (kill-quoters)
+      (for-each
+       (lambda (worker)
+         (when (car worker)
+           (gnc-detach-process (car worker) #t)
+           (set-car! worker #f)))
+       workers))
 
-    (dynamic-wind start-quoter get-quotes kill-quoter)))
+    (dynamic-wind start-quoters get-quotes kill-quoters)))
 
 (define (gnc:book-add-quotes window book)
 
@@ -394,13 +484,10 @@
       ))
 
   (define (book-add-prices! book prices)
-    (let ((pricedb (gnc-pricedb-get-db book)))
-      (for-each
-       (lambda (price)
-         (when price
-           (gnc-pricedb-add-price pricedb price)
-           (gnc-price-unref price)))
-       prices)))
+    ;; add all the new prices at once, the pricedb changes only once.
+    (let ((prices (filter identity prices)))
+      (gnc-pricedb-add-prices-bulk (gnc-pricedb-get-db book) prices)
+      (for-each gnc-price-unref prices)))
 
   (define (show-error msg)
     (gnc:gui-error msg (G_ msg)))
@@ -59,7 +59,7 @@ try_load_config_array(const gchar *fns[])
     for (i = 0; fns[i]; i++)
     {
         filename = gnc_build_userdata_path(fns[i]);
-        if (gfec_try_load(filename))
+        if (gfec_try_load_compiled(filename))
         {
             g_free(filename);
             return TRUE;
@@ -87,24 +87,30 @@ load_custom_reports_stylesheets(void)
     };
     static const gchar *stylesheet_files[] = { "stylesheets-2.0", NULL};
     static int is_user_config_loaded = FALSE;
+    gint64 stat_start;
 
     if (is_user_config_loaded)
         return;
     else is_user_config_loaded = TRUE;
 
+    stat_start = QOF_STAT_TIMER_START ();
     update_message("loading saved reports");
     try_load_config_array(saved_report_files);
     update_message("loading stylesheets");
     try_load_config_array(stylesheet_files);
+    QOF_STAT_TIMER_STOP ("startup.saved-reports", stat_start);
 }
 
 void
 gnc_report_init (void)
 {
+    gint64 stat_start = QOF_STAT_TIMER_START ();
+
     scm_init_sw_report_module();
     scm_c_use_module ("gnucash report");
     scm_c_use_module ("gnucash reports");
     scm_c_eval_string("(report-module-loader (list '(gnucash report stylesheets)))");
+    QOF_STAT_TIMER_STOP ("startup.report-modules", stat_start);
 
     load_custom_reports_stylesheets();
 }
@@ -217,12 +223,15 @@ gnc_run_report (gint report_id, char ** data)
 {
     SCM scm_text;
     gchar *str;
+    gint64 stat_start;
 
     g_return_val_if_fail (data != NULL, FALSE);
     *data = NULL;
 
     str = g_strdup_printf("(gnc:report-run %d)", report_id);
+    stat_start = QOF_STAT_TIMER_START ();
     scm_text = gfec_eval_string(str, error_handler);
+    QOF_STAT_TIMER_STOP ("report.render", stat_start);
     g_free(str);
 
     if (scm_text == SCM_UNDEFINED || !scm_is_string (scm_text))
@@ -233,6 +242,53 @@ gnc_run_report (gint report_id, char ** data)
     return TRUE;
 }
 
+gboolean
+gnc_run_report_to_file (gint report_id, const char *filename)
+{
+    SCM func, result;
+    gint64 stat_start;
+
+    g_return_val_if_fail (filename != NULL, FALSE);
+
+    func = scm_c_eval_string ("gnc:report-run-to-file");
+    stat_start = QOF_STAT_TIMER_START ();
+    result = gfec_apply (func, scm_list_2 (scm_from_int (report_id),
+                                           scm_from_utf8_string (filename)),
+                         error_handler);
+    QOF_STAT_TIMER_STOP ("report.render", stat_start);
+
+    return result != SCM_UNDEFINED && scm_is_true (result);
+}
+
+/* The trees are built by consing, so each list holds its pieces last
+ * first. */
+static void
+html_tree_write (SCM tree, SCM port)
+{
+    if (scm_is_string (tree))
+        scm_display (tree, port);
+    else if (scm_is_pair (tree))
+    {
+        GPtrArray *pieces = g_ptr_array_new ();
+        guint i;
+
+        for (; scm_is_pair (tree); tree = SCM_CDR (tree))
+            g_ptr_array_add (pieces, SCM_UNPACK_POINTER (SCM_CAR (tree)));
+        for (i = pieces->len; i > 0; i--)
+            html_tree_write (SCM_PACK_POINTER (g_ptr_array_index (pieces, i - 1)),
+                             port);
+        g_ptr_array_free (pieces, TRUE);
+    }
+    else if (!scm_is_null (tree))
+        scm_write (tree, port);
+}
+
+void
+gnc_html_tree_write (SCM tree, SCM port)
+{
+    html_tree_write (tree, port);
+}
+
 gboolean
 gnc_run_report_id_string (const char * id_string, char **data)
 {
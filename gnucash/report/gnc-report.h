@@ -41,6 +41,14 @@ void gnc_report_init (void);
 gboolean gnc_run_report (gint report_id, char ** data);
 gboolean gnc_run_report_id_string (const char * id_string, char **data);
 
+/** Render the report and write the html to filename as it is produced,
+ *  without holding it in memory. */
+gboolean gnc_run_report_to_file (gint report_id, const char *filename);
+
+/** Write a document tree built by the html renderers to port, see
+ *  gnc:html-document-tree-write. */
+void gnc_html_tree_write (SCM tree, SCM port);
+
 /**
  * @param report The SCM version of the report.
  * @return a caller-owned copy of the name of the report, or NULL if report
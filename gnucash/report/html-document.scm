@@ -23,6 +23,10 @@
 
 (define-module (gnucash report html-document))
 
+(eval-when (compile load eval expand)
+  (load-extension "libgnc-report" "scm_init_sw_report_module"))
+
+(use-modules (sw_report))
 (use-modules (gnucash html))
 (use-modules (gnucash report html-anytag))
 (use-modules (gnucash report html-barchart))
@@ -62,6 +66,8 @@
 (export gnc:html-document-set-style!)
 (export gnc:html-document-tree-collapse)
 (export gnc:html-document-render)
+(export gnc:html-document-render-to-port)
+(export gnc:html-document-tree-write)
 (export gnc:html-document-push-style)
 (export gnc:html-document-pop-style)
 (export gnc:html-document-add-object!)
@@ -155,6 +161,15 @@
           ((string? e) (cons e accum))
           (else (cons (object->string e) accum)))))
 
+;; Writes a tree built by the renderers, nested lists holding their
+;; pieces in reverse order, to port in document order. This is the C
+;; function gnc-html-tree-write, which saves a scheme call per string.
+(define gnc:html-document-tree-write gnc-html-tree-write)
+
+;; The port gnc:html-document-render-to-port writes to, while it renders
+;; the document itself rather than some object inside it.
+(define html-render-port (make-parameter #f))
+
 ;; first optional argument is "headers?"
 ;; returns the html document as a string, I think.
 (define (gnc:html-document-render doc . rest)
@@ -168,7 +183,10 @@
 
         ;; otherwise, do the trivial render.
         (let* ((retval '())
-               (push (lambda (l) (set! retval (cons l retval))))
+               (port (html-render-port))
+               (push (if port
+                         (lambda (l) (gnc:html-document-tree-write l port))
+                         (lambda (l) (set! retval (cons l retval)))))
                (objs (gnc:html-document-objects doc))
                (title (gnc:html-document-title doc)))
           ;; compile the doc style
@@ -198,11 +216,16 @@
             ;; attributes like bgcolor get included
             (push ((gnc:html-markup/open-tag-only "body") doc)))
 
-          ;; now render the children
-          (for-each
-           (lambda (child)
-               (push (gnc:html-object-render child doc)))
-           objs)
+          ;; now render the children. when writing to a port, tables are
+          ;; written as they are rendered, and documents rendered inside
+          ;; the children return strings as usual.
+          (parameterize ((html-render-port #f))
+            (for-each
+             (lambda (child)
+               (if (and port (html-object-table child))
+                   (gnc:html-table-write (html-object-table child) doc port)
+                   (push (gnc:html-object-render child doc))))
+             objs))
 
           (when headers?
             (push "</body>\n")
@@ -212,7 +235,25 @@
           (gnc:html-document-pop-style doc)
           (gnc:html-style-table-uncompile (gnc:html-document-style doc))
 
-          (string-concatenate (gnc:html-document-tree-collapse retval))))))
+          (if port
+              #t
+              (string-concatenate (gnc:html-document-tree-collapse retval)))))))
+
+;; Render the document like gnc:html-document-render, but write it to
+;; port as it is rendered instead of returning a string. The top-level
+;; tables, usually the bulk of a report, are written a row at a time.
+(define (gnc:html-document-render-to-port doc port . rest)
+  (parameterize ((html-render-port port))
+    (gnc:html-document-render doc (or (null? rest) (car rest)))))
+
+;; The table an object of the document renders, if it is one.
+(define (html-object-table obj)
+  (cond
+   ((gnc:html-table? obj) obj)
+   ((and (gnc:html-object? obj)
+         (eq? (gnc:html-object-renderer obj) gnc:html-table-render))
+    (gnc:html-object-data obj))
+   (else #f)))
 
 
 (define (gnc:html-document-push-style doc style)
@@ -228,7 +228,7 @@
          (amt-display (if (exact? amount)
                           (gnc-numeric-convert amount scu GNC-HOW-RND-ROUND)
                           amount)))
-    (xaccPrintAmount amt-display (gnc-commodity-print-info comm #t))))
+    (gnc-print-commodity-amount amt-display comm #t)))
 
 (define (gnc:default-html-number-renderer datum params)  
   (xaccPrintAmount
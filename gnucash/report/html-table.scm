@@ -99,6 +99,7 @@
 (export gnc:html-table-set-cell/tag!)
 (export gnc:html-table-append-column!)
 (export gnc:html-table-render)
+(export gnc:html-table-write)
 
 ;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;;
 ;; 
@@ -435,8 +436,20 @@
           (1+ numrows))))))
 
 (define (gnc:html-table-render table doc)
-  (let* ((retval '())
-         (push (lambda (l) (set! retval (cons l retval)))))
+  (let ((retval '()))
+    (html-table-emit table doc (lambda (l) (set! retval (cons l retval))))
+    retval))
+
+;; Render the table to port a row at a time, so that the markup of a
+;; large table is never held in memory all at once.
+(define (gnc:html-table-write table doc port)
+  (html-table-emit table doc
+                   (lambda (l) (gnc:html-document-tree-write l port))))
+
+;; Render the table, passing each piece of the document tree to push in
+;; document order.
+(define (html-table-emit table doc push)
+  (let ()
 
     ;; compile the table style to make other compiles faster
     (gnc:html-style-table-compile (gnc:html-table-style table)
@@ -554,8 +567,7 @@
 
     ;; write the table end tag and pop the table style
     (push (gnc:html-document-markup-end doc "table"))
-    (gnc:html-document-pop-style doc)
-    retval))
+    (gnc:html-document-pop-style doc)))
 
 (define (gnc:html-table-set-last-row-style! table tag . rest)
   (apply gnc:html-table-set-row-style!
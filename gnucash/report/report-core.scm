@@ -43,6 +43,7 @@
 (export gnc:all-report-template-guids)
 (export gnc:custom-report-template-guids)
 (export gnc:define-report)
+(export gnc:define-report-in-module)
 (export gnc:delete-report)
 (export gnc:find-report-template)
 (export gnc:is-custom-report-type)
@@ -76,7 +77,9 @@
 (export gnc:report-needs-save?)
 (export gnc:report-options)
 (export gnc:report-render-html)
+(export gnc:report-render-html-to-port)
 (export gnc:report-run)
+(export gnc:report-run-to-file)
 (export gnc:report-serialize)
 (export gnc:report-set-ctext!)
 (export gnc:report-set-dirty?!)
@@ -92,10 +95,12 @@
 (export gnc:report-template-has-unique-name?)
 (export gnc:report-template-in-menu?)
 (export gnc:report-template-is-custom/template-guid?)
+(export gnc:report-template-loaded?)
 (export gnc:report-template-menu-name)
 (export gnc:report-template-menu-name/report-guid)
 (export gnc:report-template-menu-path)
 (export gnc:report-template-menu-tip)
+(export gnc:report-template-module)
 (export gnc:report-template-name)
 (export gnc:report-template-new-options)
 (export gnc:report-template-new-options/report-guid)
@@ -192,16 +197,25 @@
 (define gnc:report-template-set-name report-template-set-name)
 (define gnc:report-template-parent-type report-template-parent-type)
 (define gnc:report-template-set-parent-type! report-template-set-parent-type!)
-(define gnc:report-template-options-generator report-template-options-generator)
-(define gnc:report-template-options-cleanup-cb report-template-options-cleanup-cb)
-(define gnc:report-template-options-changed-cb report-template-options-changed-cb)
-(define gnc:report-template-renderer report-template-renderer)
 (define gnc:report-template-in-menu? report-template-in-menu?)
 (define gnc:report-template-menu-path report-template-menu-path)
 (define gnc:report-template-menu-name report-template-menu-name)
 (define gnc:report-template-menu-tip report-template-menu-tip)
-(define gnc:report-template-export-types report-template-export-types)
-(define gnc:report-template-export-thunk report-template-export-thunk)
+
+;; Templates registered by gnc:define-report-in-module only know their
+;; name and menu entry; these getters load the module first.
+(define (gnc:report-template-options-generator templ)
+  (report-template-options-generator (report-template-load templ)))
+(define (gnc:report-template-options-cleanup-cb templ)
+  (report-template-options-cleanup-cb (report-template-load templ)))
+(define (gnc:report-template-options-changed-cb templ)
+  (report-template-options-changed-cb (report-template-load templ)))
+(define (gnc:report-template-renderer templ)
+  (report-template-renderer (report-template-load templ)))
+(define (gnc:report-template-export-types templ)
+  (report-template-export-types (report-template-load templ)))
+(define (gnc:report-template-export-thunk templ)
+  (report-template-export-thunk (report-template-load templ)))
 
 ;; define strings centrally to ease code clarity
 (define rpterr-dupe
@@ -248,11 +262,15 @@ not found.")))
            (gui-error (string-append rpterr-guid1 report-name rpterr-guid2)))
 
           ;; dupe: report-guid is a duplicate
-          ((hash-ref *gnc:_report-templates_* report-guid)
+          ((and (hash-ref *gnc:_report-templates_* report-guid)
+                (not (hash-ref *gnc:_report-template-modules_* report-guid)))
            (gui-error (string-append rpterr-dupe report-guid)))
 
           ;; good: new report definition, store into report-templates hash
           (else
+           (hash-remove! *gnc:_report-template-modules_* report-guid)
+           (hash-set! *gnc:_report-template-sources_* report-guid
+                      (module-name (current-module)))
            (hash-set! *gnc:_report-templates_* report-guid report-rec)))))
 
       (((? not-a-field? fld) . _)
@@ -262,6 +280,48 @@ not found.")))
        ((record-modifier <report-template> field) report-rec val)
        (loop rest)))))
 
+;; The modules of the templates registered by gnc:define-report-in-module
+;; which haven't been loaded yet, by report-guid.
+(define *gnc:_report-template-modules_* (make-hash-table 23))
+
+;; The name of the module each template was defined in, by report-guid.
+(define *gnc:_report-template-sources_* (make-hash-table 23))
+
+;; Register a template from its name and menu fields, given as args in the
+;; form gnc:define-report takes, without loading module. The module is
+;; loaded, and replaces the template with its own definition, when the
+;; template is first used for anything else. Does nothing if the template
+;; is already defined.
+(define (gnc:define-report-in-module module . args)
+  (let ((report-guid (and=> (memq 'report-guid args) cadr)))
+    (unless (and report-guid
+                 (hash-ref *gnc:_report-templates_* report-guid))
+      (apply gnc:define-report args)
+      (when report-guid
+        (hash-set! *gnc:_report-template-modules_* report-guid module)
+        (hash-set! *gnc:_report-template-sources_* report-guid module)))))
+
+(define (gnc:report-template-loaded? templ)
+  (not (hash-ref *gnc:_report-template-modules_*
+                 (report-template-report-guid templ))))
+
+(define (gnc:report-template-module templ)
+  (hash-ref *gnc:_report-template-sources_*
+            (report-template-report-guid templ)))
+
+(define (report-template-load templ)
+  (let* ((report-guid (report-template-report-guid templ))
+         (module (hash-ref *gnc:_report-template-modules_* report-guid)))
+    (cond
+     ((not module) templ)
+     (else
+      (gnc:debug "loading report module " module " for " report-guid)
+      (gnc:backtrace-if-exception resolve-interface module)
+      (when (hash-ref *gnc:_report-template-modules_* report-guid)
+        (gnc:warn "report module " module " doesn't define " report-guid)
+        (hash-remove! *gnc:_report-template-modules_* report-guid))
+      (hash-ref *gnc:_report-templates_* report-guid templ)))))
+
 (define (gnc:report-template-new-options/report-guid template-id template-name)
   (let ((templ (hash-ref *gnc:_report-templates_* template-id)))
     (and templ
@@ -275,8 +335,13 @@ not found.")))
 
 (define (gnc:report-template-renderer/report-guid template-id template-name)
   (let ((templ (hash-ref *gnc:_report-templates_* template-id)))
-    (and templ
-         (gnc:report-template-renderer templ))))
+    (cond
+     ((not templ) #f)
+     ;; saved reports ask for their parent's renderer when they are
+     ;; defined, which mustn't load the parent's module yet
+     ((gnc:report-template-loaded? templ) (gnc:report-template-renderer templ))
+     (else (lambda (report)
+             ((gnc:report-template-renderer templ) report))))))
 
 (define (gnc:report-template-new-options report-template)
   (let ((generator (gnc:report-template-options-generator report-template))
@@ -776,6 +841,39 @@ not found.")))
     html))
 
 
+;; renders the report like gnc:report-render-html, but writes the html
+;; to port while it is produced; a large report is never held in memory.
+;; The html isn't cached. Returns #f if the report has no template.
+(define (gnc:report-render-html-to-port report port headers?)
+  (cond
+   ((and (not (gnc:report-dirty? report))
+         (gnc:report-ctext report))
+    (display (gnc:report-ctext report) port)
+    #t)
+   ((hash-ref *gnc:_report-templates_* (gnc:report-type report))
+    => (lambda (template)
+         (let ((doc ((gnc:report-template-renderer template) report)))
+           (cond
+            ((string? doc) (display doc port))
+            (else
+             (gnc:html-document-set-style-sheet!
+              doc (gnc:report-stylesheet report))
+             (gnc:html-document-render-to-port doc port headers?)))
+           #t)))
+   (else #f)))
+
+;; looks up the report by id and writes its html to the file named
+;; filename with gnc:report-render-html-to-port; returns #t on success
+(define (gnc:report-run-to-file id filename)
+  (let ((report (gnc-report-find id)))
+    (and report
+         (gnc:backtrace-if-exception
+          (lambda ()
+            (call-with-output-file filename
+              (lambda (port)
+                (set-port-encoding! port "UTF-8")
+                (gnc:report-render-html-to-port report port #t))))))))
+
 ;; "thunk" should take the report-type and the report template record
 (define (gnc:report-templates-for-each thunk)
   (hash-for-each
@@ -124,9 +124,9 @@
 ;; style-info mechanism and simple plug the <gnc-monetary> into the
 ;; html-renderer.
 (define (gnc:monetary->string value)
-  (xaccPrintAmount
-   (gnc:gnc-monetary-amount value) 
-   (gnc-commodity-print-info (gnc:gnc-monetary-commodity value) #t)))
+  (gnc-print-commodity-amount
+   (gnc:gnc-monetary-amount value)
+   (gnc:gnc-monetary-commodity value) #t))
 
 ;; True if the account is of type currency, stock, or mutual-fund
 (define (gnc:account-has-shares? account)
@@ -554,17 +554,15 @@
                              (and end-date #t) (or end-date 0)
                              QOF-QUERY-AND)
 
-    ;; Get the query results.
-    (let ((splits (qof-query-run query)))
-      (qof-query-destroy query)
-      ;; Add the "value" of each split returned (which is measured
-      ;; in the transaction currency).
-      (for-each
-       (lambda (split)
-         (value-collector 'add
-                          (xaccTransGetCurrency (xaccSplitGetParent split))
-                          (xaccSplitGetValue split)))
-       splits))
+    ;; Add the "value" of each split returned (which is measured
+    ;; in the transaction currency).
+    (gnc:query-for-each
+     (lambda (split)
+       (value-collector 'add
+                        (xaccTransGetCurrency (xaccSplitGetParent split))
+                        (xaccSplitGetValue split)))
+     query)
+    (qof-query-destroy query)
     value-collector))
 
 ;; Calculate the balance of the account in terms of "value" (rather
@@ -36,6 +36,7 @@ SCM scm_init_sw_report_module (void);
 
 SCM gnc_report_find(gint id);
 gint gnc_report_add(SCM report);
+void gnc_html_tree_write (SCM tree, SCM port);
 
 %newobject gnc_get_default_report_font_family;
 gchar* gnc_get_default_report_font_family();
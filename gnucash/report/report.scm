@@ -26,6 +26,7 @@
 
 (define-module (gnucash report))
 (use-modules (gnucash utilities)) 
+(use-modules (ice-9 match))
 (use-modules (ice-9 regex))
 (use-modules (srfi srfi-1))
 (use-modules (srfi srfi-19))
@@ -65,6 +66,71 @@
 (define category-barchart-asset-uuid "e9cf815f79db44bcb637d0295093ae3d")
 (define category-barchart-liability-uuid "faf410e8f8da481fbc09e4763da40bcc")
 
+;; The report index keeps the name and menu fields of the templates each
+;; report module defines, so that report-module-loader can register them
+;; with gnc:define-report-in-module instead of loading every report at
+;; startup. It is rebuilt for a module whenever the module's file changes,
+;; and entirely when the locale changes, because some reports translate
+;; their names when they are loaded. Modules defining no templates, like
+;; the stylesheets, are always loaded.
+(define report-index-version 1)
+
+(define report-index-fields
+  (list (cons 'version gnc:report-template-version)
+        (cons 'name gnc:report-template-name)
+        (cons 'report-guid gnc:report-template-report-guid)
+        (cons 'in-menu? gnc:report-template-in-menu?)
+        (cons 'menu-path gnc:report-template-menu-path)
+        (cons 'menu-name gnc:report-template-menu-name)
+        (cons 'menu-tip gnc:report-template-menu-tip)))
+
+(define (report-index-file)
+  (gnc-build-userdata-path "report-index"))
+
+(define (report-index-header)
+  (list 'report-index report-index-version (gnc-locale-name)))
+
+;; Returns the index entries, (module mtime template-args) lists where
+;; template-args is #f for modules which must be loaded.
+(define (read-report-index)
+  (let ((header (report-index-header))
+        (index (false-if-exception
+                (call-with-input-file (report-index-file) read))))
+    (if (and (list? index)
+             (>= (length index) (length header))
+             (equal? (list-head index (length header)) header))
+        (list-tail index (length header))
+        '())))
+
+(define (write-report-index entries)
+  (unless (false-if-exception
+           (call-with-output-file (report-index-file)
+             (lambda (port)
+               (write (append (report-index-header) entries) port))))
+    (gnc:warn "Can't write the report index " (report-index-file))))
+
+(define (report-index-value? val)
+  (or (string? val) (number? val) (boolean? val) (symbol? val) (null? val)
+      (and (pair? val)
+           (report-index-value? (car val))
+           (report-index-value? (cdr val)))))
+
+;; The gnc:define-report-in-module arguments of the templates defined in
+;; module, or #f if there are none or they can't be written to the index.
+(define (report-index-template-args module)
+  (let ((args (filter-map
+               (lambda (guid)
+                 (let ((templ (gnc:find-report-template guid)))
+                   (and (equal? (gnc:report-template-module templ) module)
+                        (append-map
+                         (lambda (field)
+                           (list (car field) ((cdr field) templ)))
+                         report-index-fields))))
+               (gnc:all-report-template-guids))))
+    (and (pair? args)
+         (every (lambda (arg) (every report-index-value? arg)) args)
+         args)))
+
 ;; Given a list of module prefixes, load all guile modules with these prefixes
 ;; This assumes the modules are located on the file system in a
 ;; path matching the module prefix
@@ -76,6 +142,8 @@
 ;; and try to load them.
 ;; This function is non-recursive so it won't
 ;; descend in subdirectories.
+;; Modules found in the report index with an unchanged file only have
+;; their templates registered, they are loaded when one is used.
 (define (report-module-loader mod-prefix-list)
 
   ;; Returns a list of files in a directory
@@ -104,11 +172,11 @@
         (gnc:warn "Can't access " dir ".\nEmpty list will be returned.")
         '())))
 
-    ;; Return a list of symbols representing modules in the directory
-    ;; matching the prefix
+    ;; Return a list of (module . file modification time) pairs for
+    ;; the modules in the directory matching the prefix
     ;;
     ;; Return value:
-    ;;  List of symbols for modules
+    ;;  List of modules
   (define (get-module-list mod-prefix)
     (let* ((subdir (string-join (map symbol->string mod-prefix) "/"))
            (mod-dir (gnc-build-scm-path subdir))
@@ -116,18 +184,51 @@
           (gnc:debug "rpt-subdir=" subdir)
           (gnc:debug "mod-dir=" mod-dir)
           (gnc:debug "dir-files=" mod-list)
-     (map string->symbol mod-list)))
-
-  (for-each
-    (lambda (mod-prefix)
-      (for-each
-        (lambda (mod-file)
-                (let* ((module (append mod-prefix (list mod-file))))
-                      (module-use!
-                       (current-module)
-                       (resolve-interface module))))
-        (get-module-list mod-prefix)))
-    mod-prefix-list))
+     (map (lambda (mod-file)
+            (cons (append mod-prefix (list (string->symbol mod-file)))
+                  (stat:mtime (stat (string-append mod-dir "/" mod-file ".scm")))))
+          mod-list)))
+
+  (define (load-module! module)
+    (module-use! (current-module) (resolve-interface module)))
+
+  (let* ((index (read-report-index))
+         (changed? #f)
+         (entries
+          (append-map
+           (lambda (mod-prefix)
+             (map
+              (lambda (mod)
+                (match (assoc (car mod) index)
+                  ((module mtime (? pair? template-args))
+                   (=> next)
+                   (unless (eqv? mtime (cdr mod)) (next))
+                   (for-each
+                    (lambda (args) (apply gnc:define-report-in-module module args))
+                    template-args)
+                   (list module mtime template-args))
+                  ((module mtime #f)
+                   (=> next)
+                   (unless (eqv? mtime (cdr mod)) (next))
+                   (load-module! module)
+                   (list module mtime #f))
+                  (_
+                   (load-module! (car mod))
+                   (set! changed? #t)
+                   (list (car mod) (cdr mod) #f))))
+              (get-module-list mod-prefix)))
+           mod-prefix-list)))
+    ;; templates are attributed to their modules once all new modules are
+    ;; loaded, as one report module may load another
+    (when changed?
+      (write-report-index
+       (append
+        (map (match-lambda
+               ((module mtime #f)
+                (list module mtime (report-index-template-args module)))
+               (entry entry))
+             entries)
+        (remove (lambda (entry) (assoc (car entry) entries)) index))))))
 
 ;; Add hooks when this module is loaded
 (gnc-hook-add-scm-dangler HOOK-SAVE-OPTIONS gnc:save-style-sheet-options)
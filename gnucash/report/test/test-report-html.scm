@@ -42,6 +42,7 @@
     (test-html-objects)
     (test-html-cells)
     (test-html-table)
+    (test-html-document-render-to-port)
     (test-gnc:html-table-add-labeled-amount-line!)
     (test-gnc:make-html-acct-table/env/accts)
     (test-end "Testing/Temporary/test-report-html")
@@ -622,6 +623,39 @@ HTML Document Title</title></head><body></body>\n\
 
 ;; -----------------------------------------------------------------------
 
+(define (test-html-document-render-to-port)
+  (define (make-doc)
+    (let ((doc (gnc:make-html-document))
+          (table (gnc:make-html-table))
+          (nested (gnc:make-html-table)))
+      (gnc:html-document-set-title! doc "Streamed")
+      (gnc:html-table-set-col-headers! table '("Date" "Amount"))
+      (gnc:html-table-append-row! nested '("inner"))
+      (gnc:html-table-append-row! table (list "01/01/2020" 10))
+      (gnc:html-table-append-row! table (list "02/01/2020" -20))
+      (gnc:html-table-append-row! table (list (gnc:make-html-table-cell nested)))
+      (gnc:html-document-add-object! doc (gnc:make-html-text "before"))
+      (gnc:html-document-add-object! doc table)
+      (gnc:html-document-add-object! doc "after & done")
+      doc))
+  (test-begin "HTML Document - render to port")
+  (test-equal "writing to a port gives the same html"
+    (gnc:html-document-render (make-doc) #t)
+    (call-with-output-string
+      (lambda (port)
+        (gnc:html-document-render-to-port (make-doc) port #t))))
+  (test-equal "without headers"
+    (gnc:html-document-render (make-doc) #f)
+    (call-with-output-string
+      (lambda (port)
+        (gnc:html-document-render-to-port (make-doc) port #f))))
+  (test-equal "tree write"
+    "<b>bold</b>1"
+    (call-with-output-string
+      (lambda (port)
+        (gnc:html-document-tree-write '(1 ("</b>" "bold") "<b>") port))))
+  (test-end "HTML Document - render to port"))
+
 (define (test-html-table)
 
    ;; A table is list of rows in reverse order
@@ -17,6 +17,7 @@
   (test-report-template-getters)
   (test-make-report)
   (test-report)
+  (test-define-report-in-module)
   (test-end "Testing/Temporary/test-report"))
 
 (define test4-guid "54c2fc051af64a08ba2334c2e9179e24")
@@ -221,3 +222,35 @@
     (test-assert "gnc:report-serialize = string"
       (string?
        (gnc:report-serialize report)))))
+
+(define (test-define-report-in-module)
+  (define hello-guid "898d78ec92854402bf76e20a36d24ade")
+  (define hello-module '(gnucash reports example hello-world))
+  (test-begin "test-define-report-in-module")
+  (gnc:define-report-in-module hello-module
+                               'version 1
+                               'name "Hello, World"
+                               'report-guid hello-guid
+                               'menu-path (list gnc:menuname-example))
+  (let ((templ (gnc:find-report-template hello-guid)))
+    (test-assert "template registered without its module"
+      (not (gnc:report-template-loaded? templ)))
+    (test-equal "template module"
+      hello-module
+      (gnc:report-template-module templ))
+    (test-equal "menu fields come from the arguments"
+      (list gnc:menuname-example)
+      (gnc:report-template-menu-path templ))
+    (test-assert "renderer loads the module"
+      (procedure? (gnc:report-template-renderer templ)))
+    (test-assert "module replaced the template"
+      (let ((loaded (gnc:find-report-template hello-guid)))
+        (and (not (eq? loaded templ))
+             (gnc:report-template-loaded? loaded))))
+    (gnc:define-report-in-module hello-module
+                                 'version 1
+                                 'name "Hello, World"
+                                 'report-guid hello-guid)
+    (test-assert "loaded templates aren't registered again"
+      (gnc:report-template-loaded? (gnc:find-report-template hello-guid))))
+  (test-end "test-define-report-in-module"))
@@ -0,0 +1,36 @@
+#!/usr/bin/perl -w
+#
+# A stand-in for gnc-fq-helper which answers every request at once
+# without using the network. Each quote carries the method asked for and
+# the stub's pid, so the tests can see which helper answered it. The
+# symbol FAIL gets no quote.
+
+use strict;
+
+$| = 1;
+
+while (my $line = <STDIN>) {
+  my ($method, $args) = $line =~ /^\((\S+)\s*(.*)\)\s*$/ or exit 1;
+  my @symbols = $args =~ /"([^"]*)"/g;
+  my $currency = "USD";
+
+  if ($method eq "currency") {
+    $currency = $symbols[1];
+    @symbols = ($symbols[0]);
+  }
+
+  print "(";
+  foreach my $symbol (@symbols) {
+    if ($symbol eq "FAIL") {
+      print "#f ";
+      next;
+    }
+    print "(\"$symbol\" (symbol . \"$symbol\")",
+      " (gnc:time-no-zone . \"2020-06-15 12:00:00\")",
+      " (last . 10.5) (currency . \"$currency\")",
+      " (method . \"$method\") (pid . $$)) ";
+  }
+  print ")\n";
+}
+
+exit 0;
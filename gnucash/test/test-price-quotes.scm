@@ -0,0 +1,84 @@
+(use-modules (gnucash engine))
+(use-modules (gnucash app-utils))
+(use-modules (gnucash price-quotes))
+(use-modules (srfi srfi-1))
+(use-modules (srfi srfi-64))
+(use-modules (tests srfi64-extras))
+
+(define (run-test)
+  (test-runner-factory gnc:test-runner)
+  (test-begin "test-price-quotes.scm")
+  (parameterize ((gnc:fq-helper-command
+                  (list (getenv "PERL") (getenv "GNC_FQ_STUB"))))
+    (test-fq-get-quotes)
+    (test-fq-get-quotes-one-helper)
+    (test-fq-get-quotes-no-key))
+  (test-end "test-price-quotes.scm"))
+
+(define requests
+  '(("yahoo_json" "IBM" "FAIL")
+    ("tiaacref" "TIAA")
+    ("currency" "EUR" "USD")
+    ("yahoo_json" "AMD")
+    ("currency" "GBP" "USD")))
+
+;; the quote data of symbol in the results of a request
+(define (quote-ref results index symbol field)
+  (assq-ref (assoc-ref (list-ref results index) symbol) field))
+
+(define (result-symbols results)
+  (map (lambda (result)
+         (if (list? result)
+             (map (lambda (item) (and (pair? item) (car item))) result)
+             result))
+       results))
+
+(define (test-fq-get-quotes)
+  (test-begin "fq-get-quotes")
+  (setenv "ALPHAVANTAGE_API_KEY" "stub")
+  (let ((results (gnc:fq-get-quotes requests)))
+    (test-equal "results are in the order of the requests"
+      '(("IBM" #f) ("TIAA") ("EUR") ("AMD") ("GBP"))
+      (result-symbols results))
+    (test-equal "quote data"
+      10.5
+      (quote-ref results 3 "AMD" 'last))
+    (test-equal "requests of one source go to the same helper"
+      (list (quote-ref results 0 "IBM" 'pid)
+            (quote-ref results 2 "EUR" 'pid))
+      (list (quote-ref results 3 "AMD" 'pid)
+            (quote-ref results 4 "GBP" 'pid)))
+    (test-equal "each source has its own helper"
+      3
+      (length (delete-duplicates
+               (list (quote-ref results 0 "IBM" 'pid)
+                     (quote-ref results 1 "TIAA" 'pid)
+                     (quote-ref results 2 "EUR" 'pid))))))
+  (test-end "fq-get-quotes"))
+
+(define (test-fq-get-quotes-one-helper)
+  (test-begin "fq-get-quotes-one-helper")
+  (setenv "ALPHAVANTAGE_API_KEY" "stub")
+  (parameterize ((gnc:fq-helper-workers 1))
+    (let ((results (gnc:fq-get-quotes requests)))
+      (test-equal "results are in the order of the requests"
+        '(("IBM" #f) ("TIAA") ("EUR") ("AMD") ("GBP"))
+        (result-symbols results))
+      (test-equal "one helper answers everything"
+        1
+        (length (delete-duplicates
+                 (list (quote-ref results 0 "IBM" 'pid)
+                       (quote-ref results 1 "TIAA" 'pid)
+                       (quote-ref results 2 "EUR" 'pid)))))))
+  (test-end "fq-get-quotes-one-helper"))
+
+(define (test-fq-get-quotes-no-key)
+  (test-begin "fq-get-quotes-no-key")
+  (unsetenv "ALPHAVANTAGE_API_KEY")
+  (test-equal "currencies need the alphavantage key"
+    '(("IBM" #f) ("TIAA") need-alphavantage-key ("AMD") need-alphavantage-key)
+    (result-symbols (gnc:fq-get-quotes requests)))
+  (test-equal "nothing to send"
+    '(need-alphavantage-key)
+    (gnc:fq-get-quotes '(("currency" "EUR" "USD"))))
+  (test-end "fq-get-quotes-no-key"))
@@ -104,6 +104,8 @@ GNCPrintAmountInfo gnc_price_print_info (const gnc_commodity *curr,
         gboolean use_symbol);
 GNCPrintAmountInfo gnc_share_print_info_places (int decplaces);
 const char * xaccPrintAmount (gnc_numeric val, GNCPrintAmountInfo info);
+const char * gnc_print_commodity_amount (gnc_numeric val,
+        const gnc_commodity *commodity, gboolean use_symbol);
 
 gchar *number_to_words(gdouble val, gint64 denom);
 const gchar *printable_value (gdouble val, gint denom);
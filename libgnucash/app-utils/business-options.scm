@@ -56,6 +56,10 @@
 (export gnc:*kvp-option-path*)
 (export gnc:options-fancy-date)
 (export gnc:*option-name-default-budget*)
+(export gnc:*option-section-sqlite*)
+(export gnc:*option-name-sqlite-profile*)
+(export gnc:*option-name-sqlite-synchronous*)
+(export gnc:*option-name-sqlite-memory-temp-store*)
 
 (define gnc:*kvp-option-path* (list KVP-OPTION-PATH))
 (define gnc:*option-name-auto-readonly-days* OPTION-NAME-AUTO-READONLY-DAYS)
@@ -64,6 +68,11 @@
 (define gnc:*option-section-budgeting* OPTION-SECTION-BUDGETING)
 (define gnc:*option-name-default-budget* OPTION-NAME-DEFAULT-BUDGET)
 
+(define gnc:*option-section-sqlite* OPTION-SECTION-SQLITE)
+(define gnc:*option-name-sqlite-profile* OPTION-NAME-SQLITE-PROFILE)
+(define gnc:*option-name-sqlite-synchronous* OPTION-NAME-SQLITE-SYNCHRONOUS)
+(define gnc:*option-name-sqlite-memory-temp-store* OPTION-NAME-SQLITE-MEMORY-TEMP-STORE)
+
 (define gnc:*business-label* (N_ "Business"))
 (define gnc:*company-name* (N_ "Company Name"))
 (define gnc:*company-addy* (N_ "Company Address"))
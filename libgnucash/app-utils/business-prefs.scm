@@ -166,6 +166,31 @@
     gnc:*option-section-budgeting* gnc:*option-name-default-budget*
     "a" (N_ "Budget to be used when none has been otherwise specified.")))
 
+  ;; SQLite Tab
+
+  (reg-option
+   (gnc:make-multichoice-option
+    gnc:*option-section-sqlite* gnc:*option-name-sqlite-profile*
+    "a" (N_ "How an SQLite file is set up when it is opened. The tuned profile uses write-ahead logging, memory-mapped I/O and a larger page cache, and adds any missing lookup indexes. Takes effect the next time the file is opened, or when the book is saved to a new SQLite file; ignored for other file formats.")
+    'default
+    (list (vector 'default (N_ "Default") (N_ "Use SQLite's own settings."))
+          (vector 'tuned (N_ "Tuned") (N_ "Use the settings below for faster loading and saving.")))))
+
+  (reg-option
+   (gnc:make-multichoice-option
+    gnc:*option-section-sqlite* gnc:*option-name-sqlite-synchronous*
+    "b" (N_ "How often the tuned profile waits for changes to reach the disk.")
+    'normal
+    (list (vector 'full (N_ "Full") (N_ "Wait at every save; survives a power failure."))
+          (vector 'normal (N_ "Normal") (N_ "Wait at checkpoints; the last saves may be lost in a power failure but the file stays consistent."))
+          (vector 'off (N_ "Off") (N_ "Never wait; a power failure may corrupt the file.")))))
+
+  (reg-option
+   (gnc:make-simple-boolean-option
+    gnc:*option-section-sqlite* gnc:*option-name-sqlite-memory-temp-store*
+    "c" (N_ "Check to have the tuned profile keep SQLite's temporary tables and indexes in memory instead of in temporary files.")
+    #t))
+
   ;; Tax Tab
   (reg-option
    (gnc:make-string-option
@@ -18,6 +18,7 @@
 (define-module (gnucash app-utils c-interface))
 
 (use-modules (ice-9 match))
+(use-modules (system base compile))
 (use-modules (gnucash core-utils)
              (gnucash utilities))
 
@@ -25,6 +26,7 @@
 (export gnc:call-with-error-handling)
 (export gnc:apply-with-error-handling)
 (export gnc:eval-string-with-error-handling)
+(export gnc:load-compiled-with-error-handling)
 (export gnc:backtrace-if-exception)
 (export gnc:last-captured-error)
 
@@ -63,6 +65,27 @@
 (define (gnc:eval-string-with-error-handling cmd)
   (gnc:call-with-error-handling cmd '()))
 
+;; gnc:load-compiled-with-error-handling loads file into the current
+;; module, like gnc:eval-string-with-error-handling would its contents,
+;; but from a compiled copy kept in guile's compile cache. The copy is
+;; rebuilt when file is newer; if it can't be, file is loaded as source.
+;; It returns the same list as gnc:eval-string-with-error-handling.
+(define (gnc:load-compiled-with-error-handling file)
+  (define (up-to-date? go)
+    (and (file-exists? go)
+         (> (stat:mtime (stat go)) (stat:mtime (stat file)))))
+  (gnc:call-with-error-handling
+   (lambda ()
+     (let ((go (compiled-file-name file)))
+       (if (and go
+                (or (up-to-date? go)
+                    (false-if-exception
+                     (compile-file file #:output-file go
+                                   #:env (current-module)))))
+           (load-compiled go)
+           (primitive-load file))))
+   '()))
+
 ;; gnc:apply-with-error-handling will call guile's apply to run func with args
 ;; an captures any exception that would be generated. It returns
 ;; a list with 2 elements: the output of the evaluation and a backtrace.
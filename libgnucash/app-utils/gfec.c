@@ -174,3 +174,29 @@ gfec_try_load(const gchar *fn)
     }
     return FALSE;
 }
+
+gboolean
+gfec_try_load_compiled(const gchar *fn)
+{
+    SCM func, call_result, error;
+
+    g_debug("looking for %s", fn);
+    if (!g_file_test(fn, G_FILE_TEST_EXISTS))
+        return FALSE;
+
+    func = scm_c_eval_string("gnc:load-compiled-with-error-handling");
+    if (!scm_is_procedure(func))
+        return gfec_try_load(fn);
+
+    g_debug("trying to load %s compiled", fn);
+    call_result = scm_call_1(func, scm_from_utf8_string(fn));
+    error = scm_list_ref(call_result, scm_from_uint(1));
+    if (scm_is_true(error))
+    {
+        char *err_msg = gnc_scm_to_utf8_string(error);
+        error_handler(err_msg);
+        free(err_msg);
+        return FALSE;
+    }
+    return TRUE;
+}
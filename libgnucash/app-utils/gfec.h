@@ -19,5 +19,8 @@ SCM gfec_eval_file(const char *file, gfec_error_handler error_handler);
 SCM gfec_eval_string(const char *str, gfec_error_handler error_handler);
 SCM gfec_apply(SCM proc, SCM arglist, gfec_error_handler error_handler);
 gboolean gfec_try_load(const gchar *fn);
+/* Like gfec_try_load, but loads a compiled copy of fn which is cached
+ * and only rebuilt when fn changes. */
+gboolean gfec_try_load_compiled(const gchar *fn);
 
 #endif
@@ -287,15 +287,12 @@ _exception_handler(const char *error_message)
     _function_evaluation_error_msg = (char*)error_message;
 }
 
-static
-void*
-func_op(const char *fname, int argc, void **argv)
+/* Look up the Scheme procedure gnc:fname, returning SCM_BOOL_F if there is
+ * none. */
+static SCM
+lookup_function (const char *fname)
 {
-    SCM scmFn, scmArgs, scmTmp;
-    int i;
-    var_store *vs;
-    gchar *str;
-    gnc_numeric n, *result;
+    SCM scmFn;
     GString *realFnName;
 
     realFnName = g_string_sized_new( strlen(fname) + 5 );
@@ -308,8 +305,20 @@ func_op(const char *fname, int argc, void **argv)
     {
         /* FIXME: handle errors correctly. */
         printf( "gnc:\"%s\" is not a scm procedure\n", fname );
-        return NULL;
+        return SCM_BOOL_F;
     }
+    return scmFn;
+}
+
+static gnc_numeric *
+apply_function (const char *fname, SCM scmFn, int argc, void **argv)
+{
+    SCM scmArgs, scmTmp;
+    int i;
+    var_store *vs;
+    gchar *str;
+    gnc_numeric n, *result;
+
     scmArgs = scm_list_n (SCM_UNDEFINED);
     for ( i = 0; i < argc; i++ )
     {
@@ -363,7 +372,19 @@ func_op(const char *fname, int argc, void **argv)
 	return NULL;
     }
     /* FIXME: cleanup scmArgs = scm_list, cons'ed cells? */
-    return (void*)result;
+    return result;
+}
+
+static
+void*
+func_op(const char *fname, int argc, void **argv)
+{
+    SCM scmFn = lookup_function (fname);
+
+    if (scm_is_false (scmFn))
+        return NULL;
+
+    return (void*)apply_function (fname, scmFn, argc, argv);
 }
 
 static void *
@@ -387,6 +408,26 @@ trans_numeric(const char *digit_str,
     return pnum;
 }
 
+static gnc_numeric
+apply_operator (char op_sym, gnc_numeric left, gnc_numeric right)
+{
+    switch (op_sym)
+    {
+    case ADD_OP:
+        return gnc_numeric_add (left, right, GNC_DENOM_AUTO, GNC_HOW_DENOM_EXACT);
+    case SUB_OP:
+        return gnc_numeric_sub (left, right, GNC_DENOM_AUTO, GNC_HOW_DENOM_EXACT);
+    case DIV_OP:
+        return gnc_numeric_div (left, right, GNC_DENOM_AUTO, GNC_HOW_DENOM_EXACT);
+    case MUL_OP:
+        return gnc_numeric_mul (left, right, GNC_DENOM_AUTO, GNC_HOW_DENOM_EXACT);
+    case ASN_OP:
+        return right;
+    default:
+        return gnc_numeric_zero ();
+    }
+}
+
 static void *
 numeric_ops(char op_sym,
             void *left_value,
@@ -400,29 +441,7 @@ numeric_ops(char op_sym,
         return NULL;
 
     result = (op_sym == ASN_OP) ? left : g_new0(ParserNum, 1);
-
-    switch (op_sym)
-    {
-    case ADD_OP:
-        result->value = gnc_numeric_add (left->value, right->value,
-                                         GNC_DENOM_AUTO, GNC_HOW_DENOM_EXACT);
-        break;
-    case SUB_OP:
-        result->value = gnc_numeric_sub (left->value, right->value,
-                                         GNC_DENOM_AUTO, GNC_HOW_DENOM_EXACT);
-        break;
-    case DIV_OP:
-        result->value = gnc_numeric_div (left->value, right->value,
-                                         GNC_DENOM_AUTO, GNC_HOW_DENOM_EXACT);
-        break;
-    case MUL_OP:
-        result->value = gnc_numeric_mul (left->value, right->value,
-                                         GNC_DENOM_AUTO, GNC_HOW_DENOM_EXACT);
-        break;
-    case ASN_OP:
-        result->value = right->value;
-        break;
-    }
+    result->value = apply_operator (op_sym, left->value, right->value);
 
     return result;
 }
@@ -607,6 +626,545 @@ gnc_exp_parser_parse_separate_vars (const char * expression,
     return last_error == PARSER_NO_ERROR;
 }
 
+/** Compiled expressions *******************************************/
+
+/* gnc_exp_parser_compile runs the expression through the parser with
+ * callbacks which build a tree of ExpNodes instead of computing values,
+ * so compiled expressions follow exactly the same grammar. The tree is
+ * then flattened into the instructions of a small stack machine. */
+
+typedef enum
+{
+    EXP_NODE_NUMBER,
+    EXP_NODE_VARIABLE,
+    EXP_NODE_NEGATE,
+    EXP_NODE_OPERATOR,
+    EXP_NODE_FUNCTION
+} ExpNodeType;
+
+typedef struct ExpNode ExpNode;
+struct ExpNode
+{
+    ExpNodeType type;
+    gboolean is_operand;    /* Already used by another node. */
+    gnc_numeric value;      /* EXP_NODE_NUMBER */
+    guint index;            /* EXP_NODE_VARIABLE */
+    char op;                /* EXP_NODE_OPERATOR */
+    ExpNode *left;          /* EXP_NODE_OPERATOR, EXP_NODE_NEGATE */
+    ExpNode *right;
+    char *fname;            /* EXP_NODE_FUNCTION: argument i is */
+    SCM proc;               /* strings[i] if that is set, else args[i]. */
+    int argc;
+    ExpNode **args;
+    char **strings;
+};
+
+typedef struct
+{
+    GHashTable *nodes;      /* Owns every ExpNode of the expression. */
+    guint n_variables;
+    gboolean unsupported;
+} ExpCompileState;
+
+typedef enum
+{
+    EXP_PUSH_NUMBER,
+    EXP_PUSH_VARIABLE,
+    EXP_PUSH_STRING,
+    EXP_NEGATE,
+    EXP_OPERATOR,
+    EXP_CALL
+} ExpOpcode;
+
+typedef struct
+{
+    ExpOpcode opcode;
+    char op;
+    guint index;
+} ExpInstruction;
+
+typedef struct
+{
+    char *name;
+    SCM proc;
+    int argc;
+} ExpFunction;
+
+typedef struct
+{
+    gnc_numeric value;
+    const char *string;
+} ExpValue;
+
+struct GncExpCompiled
+{
+    GArray *code;           /* ExpInstruction */
+    GArray *numbers;        /* gnc_numeric */
+    GPtrArray *strings;
+    GArray *functions;      /* ExpFunction */
+    GPtrArray *var_names;
+    guint stack_size;
+};
+
+/* The parser callbacks have no user data. */
+static ExpCompileState *compile_state = NULL;
+
+static ExpNode *
+exp_node_new (ExpNodeType type)
+{
+    ExpNode *node = g_new0 (ExpNode, 1);
+
+    node->type = type;
+    g_hash_table_add (compile_state->nodes, node);
+
+    return node;
+}
+
+static void
+exp_node_free (gpointer data)
+{
+    ExpNode *node = data;
+    int i;
+
+    if (node->type == EXP_NODE_FUNCTION)
+    {
+        for (i = 0; i < node->argc; i++)
+            g_free (node->strings[i]);
+        g_free (node->strings);
+        g_free (node->args);
+        g_free (node->fname);
+        scm_gc_unprotect_object (node->proc);
+    }
+    g_free (node);
+}
+
+static void *
+compile_trans_numeric (const char *digit_str,
+                       gchar      *radix_point,
+                       gchar      *group_char,
+                       char      **rstr)
+{
+    ExpNode *node;
+    gnc_numeric value;
+
+    if (digit_str == NULL)
+        return NULL;
+
+    /* The parser creates each new variable as "0" without an rstr, in the
+     * order it keeps them in. */
+    if (rstr == NULL)
+    {
+        node = exp_node_new (EXP_NODE_VARIABLE);
+        node->index = compile_state->n_variables++;
+        return node;
+    }
+
+    if (!xaccParseAmount (digit_str, TRUE, &value, rstr))
+        return NULL;
+
+    node = exp_node_new (EXP_NODE_NUMBER);
+    node->value = value;
+
+    return node;
+}
+
+static void *
+compile_numeric_ops (char op_sym, void *left_value, void *right_value)
+{
+    ExpNode *left = left_value;
+    ExpNode *right = right_value;
+    ExpNode *node;
+
+    if ((left == NULL) || (right == NULL))
+        return NULL;
+
+    if (op_sym == ASN_OP)
+    {
+        compile_state->unsupported = TRUE;
+        return left;
+    }
+
+    node = exp_node_new (EXP_NODE_OPERATOR);
+    node->op = op_sym;
+    node->left = left;
+    node->right = right;
+    left->is_operand = TRUE;
+    right->is_operand = TRUE;
+
+    return node;
+}
+
+static void *
+compile_negate_numeric (void *value)
+{
+    ExpNode *node = value;
+    ExpNode *operand;
+
+    if (node == NULL)
+        return NULL;
+
+    /* The parser negates in place, so negating a variable changes it for
+     * the rest of the expression. Rewriting the node does the same, but
+     * would also change the operations that have already used it. */
+    if (node->is_operand)
+    {
+        compile_state->unsupported = TRUE;
+        return node;
+    }
+
+    operand = exp_node_new (node->type);
+    *operand = *node;
+    operand->is_operand = TRUE;
+
+    memset (node, 0, sizeof (ExpNode));
+    node->type = EXP_NODE_NEGATE;
+    node->left = operand;
+
+    return node;
+}
+
+static void
+compile_free_value (void *value)
+{
+    /* Nodes are freed with the compile state, anything else is a string
+     * argument allocated by the parser. */
+    if (!g_hash_table_contains (compile_state->nodes, value))
+        g_free (value);
+}
+
+static void *
+compile_func_op (const char *fname, int argc, void **argv)
+{
+    SCM proc = lookup_function (fname);
+    ExpNode *node;
+    int i;
+
+    if (scm_is_false (proc))
+        return NULL;
+
+    node = exp_node_new (EXP_NODE_FUNCTION);
+    node->fname = g_strdup (fname);
+    node->proc = scm_gc_protect_object (proc);
+    node->argc = argc;
+    node->args = g_new0 (ExpNode*, argc);
+    node->strings = g_new0 (char*, argc);
+
+    for (i = 0; i < argc; i++)
+    {
+        var_store *vs = argv[i];
+
+        if (vs->type == VST_STRING)
+        {
+            node->strings[i] = g_strdup (vs->value);
+        }
+        else
+        {
+            node->args[i] = vs->value;
+            node->args[i]->is_operand = TRUE;
+        }
+    }
+
+    return node;
+}
+
+static void
+compiled_append (GncExpCompiled *exp, ExpOpcode opcode, char op,
+                 guint index, guint depth)
+{
+    ExpInstruction insn;
+
+    insn.opcode = opcode;
+    insn.op = op;
+    insn.index = index;
+    g_array_append_val (exp->code, insn);
+
+    exp->stack_size = MAX (exp->stack_size, depth + 1);
+}
+
+/* Emit the instructions which leave the value of node on the stack at
+ * depth. */
+static void
+compiled_emit (GncExpCompiled *exp, const ExpNode *node, guint depth)
+{
+    ExpFunction func;
+    int i;
+
+    switch (node->type)
+    {
+    case EXP_NODE_NUMBER:
+        compiled_append (exp, EXP_PUSH_NUMBER, 0, exp->numbers->len, depth);
+        g_array_append_val (exp->numbers, node->value);
+        break;
+    case EXP_NODE_VARIABLE:
+        compiled_append (exp, EXP_PUSH_VARIABLE, 0, node->index, depth);
+        break;
+    case EXP_NODE_NEGATE:
+        compiled_emit (exp, node->left, depth);
+        compiled_append (exp, EXP_NEGATE, 0, 0, depth);
+        break;
+    case EXP_NODE_OPERATOR:
+        compiled_emit (exp, node->left, depth);
+        compiled_emit (exp, node->right, depth + 1);
+        compiled_append (exp, EXP_OPERATOR, node->op, 0, depth);
+        break;
+    case EXP_NODE_FUNCTION:
+        for (i = 0; i < node->argc; i++)
+        {
+            if (node->strings[i])
+            {
+                compiled_append (exp, EXP_PUSH_STRING, 0, exp->strings->len,
+                                 depth + i);
+                g_ptr_array_add (exp->strings, g_strdup (node->strings[i]));
+            }
+            else
+                compiled_emit (exp, node->args[i], depth + i);
+        }
+
+        func.name = g_strdup (node->fname);
+        func.proc = scm_gc_protect_object (node->proc);
+        func.argc = node->argc;
+        compiled_append (exp, EXP_CALL, 0, exp->functions->len, depth);
+        g_array_append_val (exp->functions, func);
+        break;
+    }
+}
+
+static GncExpCompiled *
+compiled_new (const ExpNode *root, var_store_ptr vars)
+{
+    GncExpCompiled *exp = g_new0 (GncExpCompiled, 1);
+
+    exp->code = g_array_new (FALSE, FALSE, sizeof (ExpInstruction));
+    exp->numbers = g_array_new (FALSE, FALSE, sizeof (gnc_numeric));
+    exp->strings = g_ptr_array_new_with_free_func (g_free);
+    exp->functions = g_array_new (FALSE, FALSE, sizeof (ExpFunction));
+    exp->var_names = g_ptr_array_new_with_free_func (g_free);
+
+    for ( ; vars ; vars = vars->next_var )
+        g_ptr_array_add (exp->var_names, g_strdup (vars->variable_name));
+
+    compiled_emit (exp, root, 0);
+
+    return exp;
+}
+
+GncExpCompiled *
+gnc_exp_parser_compile (const char *expression, char **error_loc_p)
+{
+    ExpCompileState state;
+    GncExpCompiled *exp = NULL;
+    parser_env_ptr pe;
+    var_store_ptr var;
+    struct lconv *lc;
+    var_store result;
+    char *error_loc;
+
+    if (expression == NULL)
+        return NULL;
+
+    g_return_val_if_fail (compile_state == NULL, NULL);
+
+    if (!parser_inited)
+        gnc_exp_parser_real_init (FALSE);
+
+    result.variable_name = NULL;
+    result.value = NULL;
+    result.next_var = NULL;
+
+    state.nodes = g_hash_table_new_full (NULL, NULL, exp_node_free, NULL);
+    state.n_variables = 0;
+    state.unsupported = FALSE;
+    compile_state = &state;
+
+    lc = gnc_localeconv ();
+
+    pe = init_parser (NULL, lc->mon_decimal_point, lc->mon_thousands_sep,
+                      compile_trans_numeric, compile_numeric_ops,
+                      compile_negate_numeric, compile_free_value,
+                      compile_func_op);
+
+    error_loc = parse_string (&result, expression, pe);
+
+    if (error_loc == NULL)
+    {
+        if (error_loc_p != NULL)
+            *error_loc_p = NULL;
+
+        last_error = PARSER_NO_ERROR;
+
+        for (var = parser_get_vars (pe); var; var = var->next_var)
+            if (var->assign_flag == ASSIGNED_TO)
+                state.unsupported = TRUE;
+
+        if (!state.unsupported && result.value)
+            exp = compiled_new (result.value, parser_get_vars (pe));
+    }
+    else
+    {
+        if (error_loc_p != NULL)
+            *error_loc_p = error_loc;
+
+        last_error = get_parse_error (pe);
+    }
+
+    exit_parser (pe);
+
+    compile_state = NULL;
+    g_hash_table_destroy (state.nodes);
+
+    return exp;
+}
+
+void
+gnc_exp_parser_compiled_free (GncExpCompiled *exp)
+{
+    guint i;
+
+    if (exp == NULL)
+        return;
+
+    for (i = 0; i < exp->functions->len; i++)
+    {
+        ExpFunction *func = &g_array_index (exp->functions, ExpFunction, i);
+
+        g_free (func->name);
+        scm_gc_unprotect_object (func->proc);
+    }
+
+    g_array_free (exp->code, TRUE);
+    g_array_free (exp->numbers, TRUE);
+    g_ptr_array_free (exp->strings, TRUE);
+    g_array_free (exp->functions, TRUE);
+    g_ptr_array_free (exp->var_names, TRUE);
+    g_free (exp);
+}
+
+guint
+gnc_exp_parser_compiled_get_num_vars (const GncExpCompiled *exp)
+{
+    g_return_val_if_fail (exp != NULL, 0);
+
+    return exp->var_names->len;
+}
+
+const char *
+gnc_exp_parser_compiled_get_var_name (const GncExpCompiled *exp, guint index)
+{
+    g_return_val_if_fail (exp != NULL, NULL);
+    g_return_val_if_fail (index < exp->var_names->len, NULL);
+
+    return g_ptr_array_index (exp->var_names, index);
+}
+
+/* Replace the arguments on top of the stack with the function's result. */
+static gboolean
+call_compiled_function (const ExpFunction *func, ExpValue *stack, guint *sp)
+{
+    ExpValue *args = stack + *sp - func->argc;
+    var_store *vs = g_new0 (var_store, func->argc);
+    void **argv = g_new0 (void*, func->argc);
+    gnc_numeric *result;
+    int i;
+
+    for (i = 0; i < func->argc; i++)
+    {
+        if (args[i].string)
+        {
+            vs[i].type = VST_STRING;
+            vs[i].value = (void*)args[i].string;
+        }
+        else
+        {
+            vs[i].type = VST_NUMERIC;
+            vs[i].value = &args[i].value;
+        }
+        argv[i] = &vs[i];
+    }
+
+    result = apply_function (func->name, func->proc, func->argc, argv);
+
+    g_free (argv);
+    g_free (vs);
+
+    if (result == NULL)
+        return FALSE;
+
+    args[0].value = *result;
+    args[0].string = NULL;
+    *sp = *sp - func->argc + 1;
+    g_free (result);
+
+    return TRUE;
+}
+
+gboolean
+gnc_exp_parser_evaluate (const GncExpCompiled *exp,
+                         const gnc_numeric *values,
+                         gnc_numeric *value_p)
+{
+    ExpValue *stack;
+    guint sp = 0;
+    guint pc;
+    gboolean ok = TRUE;
+
+    g_return_val_if_fail (exp != NULL, FALSE);
+    g_return_val_if_fail (values != NULL || exp->var_names->len == 0, FALSE);
+
+    stack = g_new0 (ExpValue, exp->stack_size);
+
+    for (pc = 0; ok && pc < exp->code->len; pc++)
+    {
+        const ExpInstruction *insn =
+            &g_array_index (exp->code, ExpInstruction, pc);
+
+        switch (insn->opcode)
+        {
+        case EXP_PUSH_NUMBER:
+            stack[sp].value = g_array_index (exp->numbers, gnc_numeric,
+                                             insn->index);
+            stack[sp++].string = NULL;
+            break;
+        case EXP_PUSH_VARIABLE:
+            stack[sp].value = values[insn->index];
+            stack[sp++].string = NULL;
+            break;
+        case EXP_PUSH_STRING:
+            stack[sp++].string = g_ptr_array_index (exp->strings, insn->index);
+            break;
+        case EXP_NEGATE:
+            stack[sp - 1].value = gnc_numeric_neg (stack[sp - 1].value);
+            break;
+        case EXP_OPERATOR:
+            sp--;
+            stack[sp - 1].value = apply_operator (insn->op, stack[sp - 1].value,
+                                                  stack[sp].value);
+            break;
+        case EXP_CALL:
+            ok = call_compiled_function (&g_array_index (exp->functions,
+                                                         ExpFunction,
+                                                         insn->index),
+                                         stack, &sp);
+            break;
+        }
+    }
+
+    if (!ok)
+        last_error = NOT_A_FUNC;
+    else if (gnc_numeric_check (stack[0].value))
+        last_error = NUMERIC_ERROR;
+    else
+    {
+        if (value_p)
+            *value_p = gnc_numeric_reduce (stack[0].value);
+
+        last_error = PARSER_NO_ERROR;
+    }
+
+    g_free (stack);
+
+    return last_error == PARSER_NO_ERROR;
+}
+
 const char *
 gnc_exp_parser_error_string (void)
 {
@@ -85,6 +85,44 @@ gboolean gnc_exp_parser_parse_separate_vars (const char * expression,
         char **error_loc_p,
         GHashTable *varHash );
 
+/**
+ * An expression parsed once by gnc_exp_parser_compile, to be evaluated
+ * with different variable values by gnc_exp_parser_evaluate.
+ **/
+typedef struct GncExpCompiled GncExpCompiled;
+
+/**
+ * Parse the expression as gnc_exp_parser_parse_separate_vars would, but
+ * don't evaluate it. Each variable named in the expression gets a slot,
+ * see gnc_exp_parser_compiled_get_var_name; the parser's own variables
+ * aren't used. Functions are looked up now and called on evaluation.
+ *
+ * Returns NULL if the expression doesn't parse, setting *error_loc_p and
+ * the error string as gnc_exp_parser_parse does. Also returns NULL, with
+ * *error_loc_p set to NULL, for expressions which assign to or negate a
+ * variable after using it; evaluate those with
+ * gnc_exp_parser_parse_separate_vars.
+ **/
+GncExpCompiled *gnc_exp_parser_compile (const char *expression,
+                                        char **error_loc_p);
+
+void gnc_exp_parser_compiled_free (GncExpCompiled *exp);
+
+/** The number of variables in the expression and their names, in the
+ * order gnc_exp_parser_evaluate expects their values. */
+guint gnc_exp_parser_compiled_get_num_vars (const GncExpCompiled *exp);
+const char *gnc_exp_parser_compiled_get_var_name (const GncExpCompiled *exp,
+                                                  guint index);
+
+/**
+ * Evaluate a compiled expression with values[i] as the value of variable
+ * i. The result and the error string are as for gnc_exp_parser_parse,
+ * except that there is no error location.
+ **/
+gboolean gnc_exp_parser_evaluate (const GncExpCompiled *exp,
+                                  const gnc_numeric *values,
+                                  gnc_numeric *value_p);
+
 /* If the last parse returned FALSE, return an error string describing
  * the problem. Otherwise, return NULL. */
 const char * gnc_exp_parser_error_string (void);
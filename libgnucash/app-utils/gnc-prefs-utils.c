@@ -23,6 +23,7 @@
 
 #include <config.h>
 
+#include "Account.h"
 #include "gnc-gsettings.h"
 #include "gnc-prefs-utils.h"
 #include "gnc-prefs.h"
@@ -32,6 +33,9 @@ static QofLogModule log_module = G_LOG_DOMAIN;
 
 /* Keys used for core preferences */
 #define GNC_PREF_FILE_COMPRESSION    "file-compression"
+#define GNC_PREF_FILE_DELTA_SAVE     "file-delta-save"
+#define GNC_PREF_SQL_WRITE_BEHIND    "sql-write-behind"
+#define GNC_PREF_SPLIT_BALANCES_LIMIT "split-balances-limit"
 #define GNC_PREF_RETAIN_TYPE_NEVER   "retain-type-never"
 #define GNC_PREF_RETAIN_TYPE_DAYS    "retain-type-days"
 #define GNC_PREF_RETAIN_TYPE_FOREVER "retain-type-forever"
@@ -78,6 +82,47 @@ file_compression_changed_cb(gpointer gsettings, gchar *key, gpointer user_data)
     }
 }
 
+static void
+file_delta_save_changed_cb(gpointer gsettings, gchar *key, gpointer user_data)
+{
+    if (gnc_prefs_is_set_up())
+    {
+        gboolean delta_save = gnc_prefs_get_bool(GNC_PREFS_GROUP_GENERAL, GNC_PREF_FILE_DELTA_SAVE);
+        gnc_prefs_set_file_save_delta (delta_save);
+    }
+}
+
+static void
+sql_write_behind_changed_cb(gpointer gsettings, gchar *key, gpointer user_data)
+{
+    if (gnc_prefs_is_set_up())
+    {
+        gboolean write_behind = gnc_prefs_get_bool(GNC_PREFS_GROUP_GENERAL, GNC_PREF_SQL_WRITE_BEHIND);
+        gnc_prefs_set_sql_write_behind (write_behind);
+    }
+}
+
+static void
+split_balances_limit_changed_cb(gpointer gsettings, gchar *key, gpointer user_data)
+{
+    if (gnc_prefs_is_set_up())
+    {
+        gint limit = gnc_prefs_get_int(GNC_PREFS_GROUP_GENERAL, GNC_PREF_SPLIT_BALANCES_LIMIT);
+        gnc_account_set_split_balances_limit (MAX (limit, 0));
+    }
+}
+
+#if GLIB_CHECK_VERSION(2,64,0)
+static void
+low_memory_warning_cb (GMemoryMonitor *monitor, GMemoryMonitorWarningLevel level,
+                       gpointer user_data)
+{
+    /* The running balances are only a cache, so they're the first thing
+     * to give back. */
+    gnc_account_drop_all_split_balances ();
+}
+#endif
+
 
 void gnc_prefs_init (void)
 {
@@ -89,6 +134,9 @@ void gnc_prefs_init (void)
     file_retain_changed_cb (NULL, NULL, NULL);
     file_retain_type_changed_cb (NULL, NULL, NULL);
     file_compression_changed_cb (NULL, NULL, NULL);
+    file_delta_save_changed_cb (NULL, NULL, NULL);
+    sql_write_behind_changed_cb (NULL, NULL, NULL);
+    split_balances_limit_changed_cb (NULL, NULL, NULL);
 
     /* Check for invalid retain_type (days)/retain_days (0) combo.
      * This can happen either because a user changed the preferences
@@ -122,7 +170,18 @@ void gnc_prefs_init (void)
                            file_retain_type_changed_cb, NULL);
     gnc_prefs_register_cb (GNC_PREFS_GROUP_GENERAL, GNC_PREF_FILE_COMPRESSION,
                            file_compression_changed_cb, NULL);
-
+    gnc_prefs_register_cb (GNC_PREFS_GROUP_GENERAL, GNC_PREF_FILE_DELTA_SAVE,
+                           file_delta_save_changed_cb, NULL);
+    gnc_prefs_register_cb (GNC_PREFS_GROUP_GENERAL, GNC_PREF_SQL_WRITE_BEHIND,
+                           sql_write_behind_changed_cb, NULL);
+    gnc_prefs_register_cb (GNC_PREFS_GROUP_GENERAL, GNC_PREF_SPLIT_BALANCES_LIMIT,
+                           split_balances_limit_changed_cb, NULL);
+
+#if GLIB_CHECK_VERSION(2,64,0)
+    /* Kept for the life of the program. */
+    g_signal_connect (g_memory_monitor_dup_default (), "low-memory-warning",
+                      G_CALLBACK (low_memory_warning_cb), NULL);
+#endif
 }
 
 void
@@ -139,4 +198,10 @@ gnc_prefs_remove_registered (void)
                            file_retain_type_changed_cb, NULL);
     gnc_prefs_remove_cb_by_func (GNC_PREFS_GROUP_GENERAL, GNC_PREF_FILE_COMPRESSION,
                            file_compression_changed_cb, NULL);
+    gnc_prefs_remove_cb_by_func (GNC_PREFS_GROUP_GENERAL, GNC_PREF_FILE_DELTA_SAVE,
+                           file_delta_save_changed_cb, NULL);
+    gnc_prefs_remove_cb_by_func (GNC_PREFS_GROUP_GENERAL, GNC_PREF_SQL_WRITE_BEHIND,
+                           sql_write_behind_changed_cb, NULL);
+    gnc_prefs_remove_cb_by_func (GNC_PREFS_GROUP_GENERAL, GNC_PREF_SPLIT_BALANCES_LIMIT,
+                           split_balances_limit_changed_cb, NULL);
 }
@@ -997,6 +997,96 @@ _get_template_split_account(const SchedXaction* sx,
     return success;
 }
 
+/* SX formulas are evaluated for every instance with only the variables
+ * changing, so they are compiled once and kept with the SX's book until
+ * it is destroyed. A NULL value marks a formula which
+ * gnc_exp_parser_compile couldn't handle. The cache is emptied should it
+ * ever grow past COMPILED_FORMULAS_MAX formulas. */
+#define COMPILED_FORMULAS_KEY "gnc-sx-compiled-formulas"
+#define COMPILED_FORMULAS_MAX 1024
+
+static void
+compiled_formulas_destroy (QofBook *book, gpointer key, gpointer user_data)
+{
+    g_hash_table_destroy ((GHashTable*)user_data);
+}
+
+static GncExpCompiled *
+compiled_formula_lookup (QofBook *book, const char *formula)
+{
+    GHashTable *compiled_formulas;
+    GncExpCompiled *exp = NULL;
+
+    compiled_formulas = qof_book_get_data (book, COMPILED_FORMULAS_KEY);
+    if (compiled_formulas == NULL)
+    {
+        compiled_formulas =
+            g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+                                   (GDestroyNotify)gnc_exp_parser_compiled_free);
+        qof_book_set_data_fin (book, COMPILED_FORMULAS_KEY, compiled_formulas,
+                               compiled_formulas_destroy);
+    }
+
+    if (!g_hash_table_lookup_extended (compiled_formulas, formula,
+                                       NULL, (gpointer*)&exp))
+    {
+        if (g_hash_table_size (compiled_formulas) >= COMPILED_FORMULAS_MAX)
+            g_hash_table_remove_all (compiled_formulas);
+        exp = gnc_exp_parser_compile (formula, NULL);
+        g_hash_table_insert (compiled_formulas, g_strdup (formula), exp);
+    }
+    return exp;
+}
+
+static gboolean
+_sx_formula_evaluate(QofBook *book,
+                     const char *formula,
+                     GHashTable *variable_bindings,
+                     gnc_numeric *numeric,
+                     char **error_loc)
+{
+    GncExpCompiled *exp = NULL;
+    GHashTable *parser_vars = NULL;
+    gnc_numeric *values;
+    guint i, num_vars;
+    gboolean ok;
+
+    exp = compiled_formula_lookup (book, formula);
+
+    num_vars = exp ? gnc_exp_parser_compiled_get_num_vars (exp) : 0;
+    values = g_new0 (gnc_numeric, num_vars);
+    for (i = 0; exp && i < num_vars; i++)
+    {
+        const char *name = gnc_exp_parser_compiled_get_var_name (exp, i);
+        GncSxVariable *var = variable_bindings ?
+            g_hash_table_lookup (variable_bindings, name) : NULL;
+
+        /* The parser would look the variable up among its own. */
+        if (var == NULL)
+            exp = NULL;
+        else
+            values[i] = var->value;
+    }
+
+    if (exp)
+    {
+        ok = gnc_exp_parser_evaluate (exp, values, numeric);
+        if (!ok)
+            *error_loc = (char*)formula;
+        g_free (values);
+        return ok;
+    }
+    g_free (values);
+
+    if (variable_bindings)
+        parser_vars = gnc_sx_instance_get_variables_for_parser(variable_bindings);
+    ok = gnc_exp_parser_parse_separate_vars(formula, numeric, error_loc,
+                                            parser_vars);
+    if (parser_vars != NULL)
+        g_hash_table_destroy(parser_vars);
+    return ok;
+}
+
 static void
 _get_sx_formula_value(const SchedXaction* sx,
 		      const Split *template_split,
@@ -1030,15 +1120,11 @@ _get_sx_formula_value(const SchedXaction* sx,
 
     if (formula_str != NULL && strlen(formula_str) != 0)
     {
-        GHashTable *parser_vars = NULL;
-        if (variable_bindings)
-        {
-            parser_vars = gnc_sx_instance_get_variables_for_parser(variable_bindings);
-        }
-        if (!gnc_exp_parser_parse_separate_vars(formula_str,
-                                                numeric,
-                                                &parseErrorLoc,
-                                                parser_vars))
+        if (!_sx_formula_evaluate(qof_instance_get_book (sx),
+                                  formula_str,
+                                  variable_bindings,
+                                  numeric,
+                                  &parseErrorLoc))
         {
             gchar *err = N_("Error parsing SX [%s] key [%s]=formula [%s] at [%s]: %s.");
             REPORT_ERROR(creation_errors, err,
@@ -1048,11 +1134,6 @@ _get_sx_formula_value(const SchedXaction* sx,
                     parseErrorLoc,
                     gnc_exp_parser_error_string());
        }
-
-        if (parser_vars != NULL)
-        {
-            g_hash_table_destroy(parser_vars);
-        }
     }
 }
 
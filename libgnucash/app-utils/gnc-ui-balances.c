@@ -139,13 +139,14 @@ gnc_ui_account_get_print_balance (xaccGetBalanceInCurrencyFn fn,
                                   gboolean recurse,
                                   gboolean *negative)
 {
-    GNCPrintAmountInfo print_info;
+    char buf[256];
     gnc_numeric balance;
 
     balance = gnc_ui_account_get_balance_full(fn, account, recurse,
               negative, NULL);
-    print_info = gnc_account_print_info(account, TRUE);
-    return g_strdup(xaccPrintAmount(balance, print_info));
+    gnc_amount_formatter_print (gnc_account_amount_formatter (account, TRUE),
+                                balance, buf, sizeof(buf));
+    return g_strdup(buf);
 }
 
 
@@ -169,15 +170,13 @@ gnc_ui_account_get_print_report_balance (xaccGetBalanceInCurrencyFn fn,
         gboolean recurse,
         gboolean *negative)
 {
-    GNCPrintAmountInfo print_info;
     gnc_numeric balance;
     gnc_commodity *report_commodity;
 
     report_commodity = gnc_default_report_currency();
     balance = gnc_ui_account_get_balance_full(fn, account, recurse,
               negative, report_commodity);
-    print_info = gnc_commodity_print_info(report_commodity, TRUE);
-    return g_strdup(xaccPrintAmount(balance, print_info));
+    return g_strdup(gnc_print_commodity_amount(balance, report_commodity, TRUE));
 }
 
 static gnc_numeric
@@ -307,11 +306,11 @@ gnc_ui_owner_get_print_balance (GncOwner *owner,
                                 gboolean *negative)
 {
     gnc_numeric balance;
-    GNCPrintAmountInfo print_info;
 
     balance = gnc_ui_owner_get_balance_full (owner, negative, NULL);
-    print_info = gnc_commodity_print_info (gncOwnerGetCurrency (owner), TRUE);
-    return g_strdup (xaccPrintAmount (balance, print_info));
+    return g_strdup (gnc_print_commodity_amount (balance,
+                                                 gncOwnerGetCurrency (owner),
+                                                 TRUE));
 }
 
 /**
@@ -329,15 +328,14 @@ gchar *
 gnc_ui_owner_get_print_report_balance (GncOwner *owner,
                                        gboolean *negative)
 {
-    GNCPrintAmountInfo print_info;
     gnc_numeric balance;
     gnc_commodity *report_commodity;
 
     report_commodity = gnc_default_report_currency ();
     balance = gnc_ui_owner_get_balance_full (owner, negative,
               report_commodity);
-    print_info = gnc_commodity_print_info (report_commodity, TRUE);
-    return g_strdup (xaccPrintAmount (balance, print_info));
+    return g_strdup (gnc_print_commodity_amount (balance, report_commodity,
+                                                 TRUE));
 }
 
 
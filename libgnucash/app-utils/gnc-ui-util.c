@@ -1280,11 +1280,14 @@ gnc_default_report_currency (void)
     return gnc_default_currency_common (user_report_currency, GNC_PREFS_GROUP_GENERAL_REPORT);
 }
 
+static void amount_formatters_clear (gpointer session, gpointer user_data);
+
 static void
 gnc_currency_changed_cb (GSettings *settings, gchar *key, gpointer user_data)
 {
     user_default_currency = NULL;
     user_report_currency = NULL;
+    amount_formatters_clear (NULL, NULL);
     gnc_hook_run(HOOK_CURRENCY_CHANGED, NULL);
 }
 
@@ -1342,22 +1345,18 @@ is_decimal_fraction (int fraction, guint8 *max_decimal_places_p)
     return TRUE;
 }
 
-GNCPrintAmountInfo
-gnc_commodity_print_info (const gnc_commodity *commodity,
-                          gboolean use_symbol)
+static GNCPrintAmountInfo
+gnc_print_info_for_scu (const gnc_commodity *commodity, int scu,
+                        gboolean use_symbol)
 {
     GNCPrintAmountInfo info;
     gboolean is_iso;
 
-    if (commodity == NULL)
-        return gnc_default_print_info (use_symbol);
-
     info.commodity = commodity;
 
     is_iso = gnc_commodity_is_iso (commodity);
 
-    if (is_decimal_fraction (gnc_commodity_get_fraction (commodity),
-                             &info.max_decimal_places))
+    if (is_decimal_fraction (scu, &info.max_decimal_places))
     {
         if (is_iso)
             info.min_decimal_places = info.max_decimal_places;
@@ -1377,42 +1376,28 @@ gnc_commodity_print_info (const gnc_commodity *commodity,
     return info;
 }
 
+GNCPrintAmountInfo
+gnc_commodity_print_info (const gnc_commodity *commodity,
+                          gboolean use_symbol)
+{
+    if (commodity == NULL)
+        return gnc_default_print_info (use_symbol);
+
+    return gnc_print_info_for_scu (commodity,
+                                   gnc_commodity_get_fraction (commodity),
+                                   use_symbol);
+}
+
 static GNCPrintAmountInfo
 gnc_account_print_info_helper(const Account *account, gboolean use_symbol,
                               gnc_commodity * (*efffunc)(const Account *),
                               int (*scufunc)(const Account*))
 {
-    GNCPrintAmountInfo info;
-    gboolean is_iso;
-    int scu;
-
     if (account == NULL)
         return gnc_default_print_info (use_symbol);
 
-    info.commodity = efffunc (account);
-
-    is_iso = gnc_commodity_is_iso (info.commodity);
-
-    scu = scufunc (account);
-
-    if (is_decimal_fraction (scu, &info.max_decimal_places))
-    {
-        if (is_iso)
-            info.min_decimal_places = info.max_decimal_places;
-        else
-            info.min_decimal_places = 0;
-    }
-    else
-        info.max_decimal_places = info.min_decimal_places = 0;
-
-    info.use_separators = 1;
-    info.use_symbol = use_symbol ? 1 : 0;
-    info.use_locale = is_iso ? 1 : 0;
-    info.monetary = 1;
-    info.force_fit = 0;
-    info.round = 0;
-
-    return info;
+    return gnc_print_info_for_scu (efffunc (account), scufunc (account),
+                                   use_symbol);
 }
 
 GNCPrintAmountInfo
@@ -1538,18 +1523,164 @@ gnc_integral_print_info (void)
     return info;
 }
 
+/* A GNCPrintAmountInfo with everything xaccSPrintAmount looks up for
+ * it: the locale's separators, signs and symbol placement and the
+ * commodity's symbol. The strings belong to gnc_localeconv and to the
+ * commodity, so a cached formatter must go when its commodity changes. */
+struct _GNCAmountFormatter
+{
+    GNCPrintAmountInfo info;
+
+    const char *symbol;
+    gsize symbol_len;
+
+    const char *separator;  /* only the first character is used */
+    gsize separator_len;
+    const char *grouping;
+    const char *decimal_point;
+    gsize decimal_point_len;
+
+    /* indexed by whether the amount is negative */
+    const char *sign[2];
+    gsize sign_len[2];
+    char sign_posn[2];
+    char cs_precedes[2];
+    char sep_by_space[2];
+};
+
+static gsize
+utf8_first_char_len (const char *str)
+{
+    return *str ? g_utf8_next_char (str) - str : 0;
+}
+
+static void
+amount_formatter_init (GNCAmountFormatter *fmt, GNCPrintAmountInfo info)
+{
+    struct lconv *lc = gnc_localeconv();
+    int neg;
+
+    fmt->info = info;
+
+    if (info.monetary)
+    {
+        fmt->separator = lc->mon_thousands_sep;
+        fmt->grouping = lc->mon_grouping;
+        fmt->decimal_point = lc->mon_decimal_point;
+    }
+    else
+    {
+        fmt->separator = lc->thousands_sep;
+        fmt->grouping = lc->grouping;
+        fmt->decimal_point = lc->decimal_point;
+    }
+    fmt->separator_len = utf8_first_char_len (fmt->separator);
+    fmt->decimal_point_len = utf8_first_char_len (fmt->decimal_point);
+
+    fmt->sign[0] = lc->positive_sign;
+    fmt->sign_posn[0] = lc->p_sign_posn;
+    fmt->sign[1] = lc->negative_sign;
+    fmt->sign_posn[1] = lc->n_sign_posn;
+
+    if (info.use_locale)
+    {
+        fmt->cs_precedes[0] = lc->p_cs_precedes;
+        fmt->sep_by_space[0] = lc->p_sep_by_space;
+        fmt->cs_precedes[1] = lc->n_cs_precedes;
+        fmt->sep_by_space[1] = lc->n_sep_by_space;
+    }
+    else
+    {
+        fmt->cs_precedes[0] = fmt->cs_precedes[1] = TRUE;
+        fmt->sep_by_space[0] = fmt->sep_by_space[1] = TRUE;
+    }
+
+    if (info.commodity && info.use_symbol)
+    {
+        fmt->symbol = gnc_commodity_get_nice_symbol (info.commodity);
+        if (!gnc_commodity_is_iso (info.commodity))
+        {
+            fmt->cs_precedes[0] = fmt->cs_precedes[1] = FALSE;
+            fmt->sep_by_space[0] = fmt->sep_by_space[1] = TRUE;
+        }
+    }
+    else /* !info.use_symbol || !info.commodity */
+        fmt->symbol = "";
+
+    if (!fmt->symbol)
+        fmt->symbol = "";
+    fmt->symbol_len = strlen (fmt->symbol);
+
+    for (neg = 0; neg < 2; neg++)
+        fmt->sign_len[neg] = fmt->sign[neg] ? strlen (fmt->sign[neg]) : 0;
+}
+
+/* Copy the digits to buf, putting the thousands separator between the
+ * groups the locale asks for. Returns the end of the copy. */
+static char *
+print_grouped_digits (char *buf, const char *digits, int num_digits,
+                      const GNCAmountFormatter *fmt)
+{
+    gboolean sep_before[32] = { FALSE };
+    const char *group = fmt->grouping;
+    int group_count = 0;
+    int i;
+
+    /* Walk from the last digit, as the groups are counted from the right */
+    for (i = num_digits - 1; i > 0 && *group != CHAR_MAX; i--)
+    {
+        group_count++;
+
+        if (group_count == *group)
+        {
+            sep_before[i] = TRUE;
+            group_count = 0;
+
+            /* Peek ahead at the next group code */
+            switch (group[1])
+            {
+                /* A null char means repeat the last group indefinitely */
+            case '\0':
+                break;
+                /* CHAR_MAX means no more grouping allowed */
+            case CHAR_MAX:
+                /* fall through */
+                /* Anything else means another group size */
+            default:
+                group++;
+                break;
+            }
+        }
+    }
+
+    for (i = 0; i < num_digits; i++)
+    {
+        if (sep_before[i])
+        {
+            memcpy (buf, fmt->separator, fmt->separator_len);
+            buf += fmt->separator_len;
+        }
+        *buf++ = digits[i];
+    }
+
+    return buf;
+}
+
 /* Utility function for printing non-negative amounts */
 static int
-PrintAmountInternal(char *buf, gnc_numeric val, const GNCPrintAmountInfo *info)
+PrintAmountInternal(char *buf, gnc_numeric val, const GNCAmountFormatter *fmt)
 {
-    struct lconv *lc = gnc_localeconv();
-    int num_whole_digits;
+    const GNCPrintAmountInfo *info = &fmt->info;
     char temp_buf[128];
+    char *buf_ptr = buf;
+    char *digit_ptr;
+    int num_whole_digits;
+    gint64 digits;
     gnc_numeric whole, rounding;
     int min_dp, max_dp;
     gboolean value_is_negative, value_is_decimal;
 
-    g_return_val_if_fail (info != NULL, 0);
+    g_return_val_if_fail (fmt != NULL, 0);
 
     if (gnc_numeric_check (val))
     {
@@ -1606,87 +1737,48 @@ PrintAmountInternal(char *buf, gnc_numeric val, const GNCPrintAmountInfo *info)
     }
 
     /* calculate the integer part and the remainder */
-    whole = gnc_numeric_convert(val, 1, GNC_HOW_RND_TRUNC);
-    val = gnc_numeric_sub (val, whole, GNC_DENOM_AUTO, GNC_HOW_RND_NEVER);
-    if (gnc_numeric_check (val))
+    if (value_is_decimal)
     {
-        PWARN ("Problem with remainder: %s.",
-               gnc_numeric_errorCode_to_string(gnc_numeric_check (val)));
-        *buf = '\0';
-        return 0;
+        /* The denominator is a power of ten (or anything at all if the
+         * value is zero), so plain integer division splits the value. */
+        whole = gnc_numeric_create (val.num / val.denom, 1);
+        val.num = val.num % val.denom;
     }
-    
-    // Value may now be decimal, for example if the factional part is zero
-    value_is_decimal = gnc_numeric_to_decimal(&val, NULL);
-    /* print the integer part without separators */
-    sprintf(temp_buf, "%" G_GINT64_FORMAT, whole.num);
-    num_whole_digits = strlen (temp_buf);
-
-    if (!info->use_separators)
-        strcpy (buf, temp_buf);
     else
     {
-        int group_count;
-        char *separator;
-        char *temp_ptr;
-        char *buf_ptr;
-        char *group;
-        gchar *rev_buf;
-
-        if (info->monetary)
-        {
-            separator = lc->mon_thousands_sep;
-            group = lc->mon_grouping;
-        }
-        else
+        whole = gnc_numeric_convert(val, 1, GNC_HOW_RND_TRUNC);
+        val = gnc_numeric_sub (val, whole, GNC_DENOM_AUTO, GNC_HOW_RND_NEVER);
+        if (gnc_numeric_check (val))
         {
-            separator = lc->thousands_sep;
-            group = lc->grouping;
+            PWARN ("Problem with remainder: %s.",
+                   gnc_numeric_errorCode_to_string(gnc_numeric_check (val)));
+            *buf = '\0';
+            return 0;
         }
 
-        buf_ptr = buf;
-        temp_ptr = &temp_buf[num_whole_digits - 1];
-        group_count = 0;
-
-        while (temp_ptr != temp_buf)
-        {
-            *buf_ptr++ = *temp_ptr--;
-
-            if (*group != CHAR_MAX)
-            {
-                group_count++;
-
-                if (group_count == *group)
-                {
-                    g_utf8_strncpy(buf_ptr, separator, 1);
-                    buf_ptr = g_utf8_find_next_char(buf_ptr, NULL);
-                    group_count = 0;
+        // Value may now be decimal, for example if the factional part is zero
+        value_is_decimal = gnc_numeric_to_decimal(&val, NULL);
+    }
 
-                    /* Peek ahead at the next group code */
-                    switch (group[1])
-                    {
-                        /* A null char means repeat the last group indefinitely */
-                    case '\0':
-                        break;
-                        /* CHAR_MAX means no more grouping allowed */
-                    case CHAR_MAX:
-                        /* fall through */
-                        /* Anything else means another group size */
-                    default:
-                        group++;
-                        break;
-                    }
-                }
-            }
-        }
+    /* print the integer part, digits first */
+    digit_ptr = &temp_buf[sizeof(temp_buf)];
+    digits = whole.num;
+    do
+    {
+        *--digit_ptr = '0' + digits % 10;
+        digits /= 10;
+    }
+    while (digits > 0);
+    num_whole_digits = &temp_buf[sizeof(temp_buf)] - digit_ptr;
 
-        /* We built the string backwards, now reverse */
-        *buf_ptr++ = *temp_ptr;
-        *buf_ptr = '\0';
-        rev_buf = g_utf8_strreverse(buf, -1);
-        strcpy (buf, rev_buf);
-        g_free(rev_buf);
-    } /* endif */
+    if (!info->use_separators)
+    {
+        memcpy (buf_ptr, digit_ptr, num_whole_digits);
+        buf_ptr += num_whole_digits;
+    }
+    else
+        buf_ptr = print_grouped_digits (buf_ptr, digit_ptr, num_whole_digits,
+                                        fmt);
 
     /* at this point, buf contains the whole part of the number */
 
@@ -1703,27 +1795,23 @@ PrintAmountInternal(char *buf, gnc_numeric val, const GNCPrintAmountInfo *info)
                      val.num, -val.denom);
 
         if (whole.num == 0)
-            *buf = '\0';
+            buf_ptr = buf;
         else if (value_is_negative)
-            strcat(buf, " - ");
+            buf_ptr = g_stpcpy (buf_ptr, " - ");
         else
-            strcat(buf, " + ");
+            buf_ptr = g_stpcpy (buf_ptr, " + ");
 
-        strcat (buf, temp_buf);
+        buf_ptr = g_stpcpy (buf_ptr, temp_buf);
     }
     else
     {
-        char *decimal_point;
+        char *decimal_ptr = buf_ptr;
         guint8 num_decimal_places = 0;
-        char *temp_ptr = temp_buf;
 
-        decimal_point = info->monetary
-                        ? lc->mon_decimal_point
-                        : lc->decimal_point;
-        g_utf8_strncpy(temp_ptr, decimal_point, 1);
-        temp_ptr = g_utf8_find_next_char(temp_ptr, NULL);
+        memcpy (buf_ptr, fmt->decimal_point, fmt->decimal_point_len);
+        buf_ptr += fmt->decimal_point_len;
 
-        while (!gnc_numeric_zero_p (val)
+        while (val.num != 0
                 && (val.denom != 1)
                 && (num_decimal_places < max_dp))
         {
@@ -1733,7 +1821,7 @@ PrintAmountInternal(char *buf, gnc_numeric val, const GNCPrintAmountInfo *info)
 
             digit = val.num / val.denom;
 
-            *temp_ptr++ = digit + '0';
+            *buf_ptr++ = digit + '0';
             num_decimal_places++;
 
             val.num = val.num - (digit * val.denom);
@@ -1741,163 +1829,161 @@ PrintAmountInternal(char *buf, gnc_numeric val, const GNCPrintAmountInfo *info)
 
         while (num_decimal_places < min_dp)
         {
-            *temp_ptr++ = '0';
+            *buf_ptr++ = '0';
             num_decimal_places++;
         }
 
-        /* cap the end and move to the last character */
-        *temp_ptr-- = '\0';
-
         /* Here we strip off trailing decimal zeros per the argument. */
-        while (*temp_ptr == '0' && num_decimal_places > min_dp)
+        while (buf_ptr[-1] == '0' && num_decimal_places > min_dp)
         {
-            *temp_ptr-- = '\0';
+            buf_ptr--;
             num_decimal_places--;
         }
 
         if (num_decimal_places > max_dp)
         {
-            PWARN ("max_decimal_places too small; limit %d, value %s%s",
-                   info->max_decimal_places, buf, temp_buf);
+            *buf_ptr = '\0';
+            PWARN ("max_decimal_places too small; limit %d, value %s",
+                   info->max_decimal_places, buf);
         }
 
-        if (num_decimal_places > 0)
-            strcat (buf, temp_buf);
+        if (num_decimal_places == 0)
+            buf_ptr = decimal_ptr;
     }
 
-    return strlen(buf);
+    *buf_ptr = '\0';
+    return buf_ptr - buf;
 }
 
-/**
- * @param bufp Should be at least 64 chars.
- **/
-int
-xaccSPrintAmount (char * bufp, gnc_numeric val, GNCPrintAmountInfo info)
+static gboolean
+amount_append (char *buf, gsize len, gsize *used, const char *str, gsize n)
 {
-    struct lconv *lc;
-
-    char *orig_bufp = bufp;
-    const char *currency_symbol;
-    const char *sign;
+    if (n >= len - *used)
+        return FALSE;
 
-    char cs_precedes;
-    char sep_by_space;
-    char sign_posn;
+    memcpy (buf + *used, str, n);
+    *used += n;
+    return TRUE;
+}
 
+#define AMOUNT_APPEND(str, n) \
+    do { \
+        if (!amount_append (buf, len, &used, (str), (n))) \
+            goto too_long; \
+    } while (0)
+
+static gsize
+amount_formatter_print (const GNCAmountFormatter *fmt, gnc_numeric val,
+                        char *buf, gsize len)
+{
+    char num_buf[256];
+    int num_len;
+    gsize used = 0;
+    int neg = gnc_numeric_negative_p (val) ? 1 : 0;
+    const char *sign = fmt->sign[neg];
+    gsize sign_len = fmt->sign_len[neg];
+    char sign_posn = fmt->sign_posn[neg];
+    char cs_precedes = fmt->cs_precedes[neg];
+    char sep_by_space = fmt->sep_by_space[neg];
     gboolean print_sign = TRUE;
     gboolean print_absolute = FALSE;
 
-    if (!bufp)
+    if (len == 0)
         return 0;
 
-    lc = gnc_localeconv();
-    if (info.use_locale)
-        if (gnc_numeric_negative_p (val))
-        {
-            cs_precedes  = lc->n_cs_precedes;
-            sep_by_space = lc->n_sep_by_space;
-        }
-        else
-        {
-            cs_precedes  = lc->p_cs_precedes;
-            sep_by_space = lc->p_sep_by_space;
-        }
-    else
-    {
-        cs_precedes = TRUE;
-        sep_by_space = TRUE;
-    }
-
-    if (info.commodity && info.use_symbol)
-    {
-        currency_symbol = gnc_commodity_get_nice_symbol (info.commodity);
-        if (!gnc_commodity_is_iso (info.commodity))
-        {
-            cs_precedes  = FALSE;
-            sep_by_space = TRUE;
-        }
-    }
-    else /* !info.use_symbol || !info.commodity */
-        currency_symbol = "";
-
-    if (gnc_numeric_negative_p (val))
-    {
-        sign = lc->negative_sign;
-        sign_posn = lc->n_sign_posn;
-    }
-    else
-    {
-        sign = lc->positive_sign;
-        sign_posn = lc->p_sign_posn;
-    }
-
-    if (gnc_numeric_zero_p (val) || (sign == NULL) || (sign[0] == 0))
+    if (gnc_numeric_zero_p (val) || (sign_len == 0))
         print_sign = FALSE;
 
     /* See if we print sign now */
     if (print_sign && (sign_posn == 1))
-        bufp = g_stpcpy(bufp, sign);
+        AMOUNT_APPEND (sign, sign_len);
 
     /* Now see if we print currency */
     if (cs_precedes)
     {
         /* See if we print sign now */
         if (print_sign && (sign_posn == 3))
-            bufp = g_stpcpy(bufp, sign);
+            AMOUNT_APPEND (sign, sign_len);
 
-        if (info.use_symbol)
+        if (fmt->info.use_symbol)
         {
-            bufp = g_stpcpy(bufp, currency_symbol);
+            AMOUNT_APPEND (fmt->symbol, fmt->symbol_len);
             if (sep_by_space)
-                bufp = g_stpcpy(bufp, " ");
+                AMOUNT_APPEND (" ", 1);
         }
 
         /* See if we print sign now */
         if (print_sign && (sign_posn == 4))
-            bufp = g_stpcpy(bufp, sign);
+            AMOUNT_APPEND (sign, sign_len);
     }
 
     /* Now see if we print parentheses */
     if (print_sign && (sign_posn == 0))
     {
-        bufp = g_stpcpy(bufp, "(");
+        AMOUNT_APPEND ("(", 1);
         print_absolute = TRUE;
     }
 
     /* Now print the value */
-    bufp += PrintAmountInternal(bufp,
-                                print_absolute ? gnc_numeric_abs(val) : val,
-                                &info);
+    num_len = PrintAmountInternal(num_buf,
+                                  print_absolute ? gnc_numeric_abs(val) : val,
+                                  fmt);
+    AMOUNT_APPEND (num_buf, num_len);
 
     /* Now see if we print parentheses */
     if (print_sign && (sign_posn == 0))
-        bufp = g_stpcpy(bufp, ")");
+        AMOUNT_APPEND (")", 1);
 
     /* Now see if we print currency */
     if (!cs_precedes)
     {
         /* See if we print sign now */
         if (print_sign && (sign_posn == 3))
-            bufp = g_stpcpy(bufp, sign);
+            AMOUNT_APPEND (sign, sign_len);
 
-        if (info.use_symbol)
+        if (fmt->info.use_symbol)
         {
             if (sep_by_space)
-                bufp = g_stpcpy(bufp, " ");
-            bufp = g_stpcpy(bufp, currency_symbol);
+                AMOUNT_APPEND (" ", 1);
+            AMOUNT_APPEND (fmt->symbol, fmt->symbol_len);
         }
 
         /* See if we print sign now */
         if (print_sign && (sign_posn == 4))
-            bufp = g_stpcpy(bufp, sign);
+            AMOUNT_APPEND (sign, sign_len);
     }
 
     /* See if we print sign now */
     if (print_sign && (sign_posn == 2))
-        bufp = g_stpcpy(bufp, sign);
+        AMOUNT_APPEND (sign, sign_len);
+
+    buf[used] = '\0';
 
     /* return length of printed string */
-    return (bufp - orig_bufp);
+    return used;
+
+too_long:
+    PINFO ("buffer of %" G_GSIZE_FORMAT " bytes too small for the amount",
+           len);
+    buf[0] = '\0';
+    return 0;
+}
+
+#undef AMOUNT_APPEND
+
+/**
+ * @param bufp Should be at least 64 chars.
+ **/
+int
+xaccSPrintAmount (char * bufp, gnc_numeric val, GNCPrintAmountInfo info)
+{
+    GNCAmountFormatter fmt;
+
+    if (!bufp)
+        return 0;
+
+    amount_formatter_init (&fmt, info);
+    return amount_formatter_print (&fmt, val, bufp, G_MAXSIZE);
 }
 
 const char *
@@ -1913,6 +1999,141 @@ xaccPrintAmount (gnc_numeric val, GNCPrintAmountInfo info)
     return buf;
 }
 
+/* The cached formatters, by commodity, smallest commodity unit and
+ * use_symbol. The default print info has no commodity and an scu of -1. */
+typedef struct
+{
+    const gnc_commodity *commodity;
+    int scu;
+    gboolean use_symbol;
+} AmountFormatterKey;
+
+typedef struct
+{
+    AmountFormatterKey key;
+    GNCAmountFormatter fmt;
+} AmountFormatterEntry;
+
+static GHashTable *amount_formatters = NULL;
+
+static guint
+amount_formatter_key_hash (gconstpointer key)
+{
+    const AmountFormatterKey *k = key;
+    return g_direct_hash (k->commodity) ^ ((guint)k->scu << 1) ^ k->use_symbol;
+}
+
+static gboolean
+amount_formatter_key_equal (gconstpointer a, gconstpointer b)
+{
+    const AmountFormatterKey *ka = a, *kb = b;
+    return ka->commodity == kb->commodity && ka->scu == kb->scu &&
+        ka->use_symbol == kb->use_symbol;
+}
+
+static gboolean
+amount_formatter_uses_commodity (gpointer key, gpointer value,
+                                 gpointer commodity)
+{
+    return ((AmountFormatterKey*)key)->commodity == commodity;
+}
+
+static void
+amount_formatter_event_handler (QofInstance *entity, QofEventId event_type,
+                                gpointer user_data, gpointer event_data)
+{
+    /* A changed symbol or fraction needs a new formatter, and the
+     * address of a destroyed commodity may be reused. */
+    if (!GNC_IS_COMMODITY (entity))
+        return;
+    if (0 == (event_type & (QOF_EVENT_MODIFY | QOF_EVENT_DESTROY)))
+        return;
+
+    g_hash_table_foreach_remove (amount_formatters,
+                                 amount_formatter_uses_commodity, entity);
+}
+
+static void
+amount_formatters_clear (gpointer session, gpointer user_data)
+{
+    if (amount_formatters)
+        g_hash_table_remove_all (amount_formatters);
+}
+
+static const GNCAmountFormatter *
+gnc_amount_formatter_lookup (const gnc_commodity *commodity, int scu,
+                             gboolean use_symbol)
+{
+    AmountFormatterKey key = { commodity, scu, use_symbol ? TRUE : FALSE };
+    AmountFormatterEntry *entry;
+
+    if (!amount_formatters)
+    {
+        amount_formatters = g_hash_table_new_full (amount_formatter_key_hash,
+                                                   amount_formatter_key_equal,
+                                                   NULL, g_free);
+        qof_event_register_handler (amount_formatter_event_handler, NULL);
+        gnc_hook_add_dangler (HOOK_BOOK_CLOSED, amount_formatters_clear,
+                              NULL, NULL);
+    }
+
+    entry = g_hash_table_lookup (amount_formatters, &key);
+    if (entry)
+        return &entry->fmt;
+
+    entry = g_new0 (AmountFormatterEntry, 1);
+    entry->key = key;
+    amount_formatter_init (&entry->fmt, commodity || scu >= 0 ?
+                           gnc_print_info_for_scu (commodity, scu, use_symbol) :
+                           gnc_default_print_info (use_symbol));
+    g_hash_table_insert (amount_formatters, &entry->key, entry);
+    return &entry->fmt;
+}
+
+const GNCAmountFormatter *
+gnc_commodity_amount_formatter (const gnc_commodity *commodity,
+                                gboolean use_symbol)
+{
+    if (commodity == NULL)
+        return gnc_amount_formatter_lookup (NULL, -1, use_symbol);
+
+    return gnc_amount_formatter_lookup (commodity,
+                                        gnc_commodity_get_fraction (commodity),
+                                        use_symbol);
+}
+
+const GNCAmountFormatter *
+gnc_account_amount_formatter (const Account *account, gboolean use_symbol)
+{
+    if (account == NULL)
+        return gnc_amount_formatter_lookup (NULL, -1, use_symbol);
+
+    return gnc_amount_formatter_lookup (xaccAccountGetCommodity (account),
+                                        xaccAccountGetCommoditySCU (account),
+                                        use_symbol);
+}
+
+gsize
+gnc_amount_formatter_print (const GNCAmountFormatter *fmt, gnc_numeric val,
+                            char *buf, gsize len)
+{
+    g_return_val_if_fail (fmt != NULL && buf != NULL, 0);
+
+    return amount_formatter_print (fmt, val, buf, len);
+}
+
+const char *
+gnc_print_commodity_amount (gnc_numeric val, const gnc_commodity *commodity,
+                            gboolean use_symbol)
+{
+    /* not thread safe either, see xaccPrintAmount */
+    static char buf[1024];
+
+    gnc_amount_formatter_print (gnc_commodity_amount_formatter (commodity,
+                                                                use_symbol),
+                                val, buf, sizeof(buf));
+    return buf;
+}
 
 /********************************************************************\
  ********************************************************************/
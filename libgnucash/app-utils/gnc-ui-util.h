@@ -346,6 +346,35 @@ GNCPrintAmountInfo gnc_integral_print_info (void);
 const char * xaccPrintAmount (gnc_numeric val, GNCPrintAmountInfo info);
 int xaccSPrintAmount (char *buf, gnc_numeric val, GNCPrintAmountInfo info);
 
+/*
+ * A GNCAmountFormatter prints amounts as xaccSPrintAmount does with
+ *    the print info of a commodity or an account, but has the locale
+ *    settings, the symbol and the decimal places looked up once. The
+ *    formatters are cached and owned by gnc-ui-util; they stay valid
+ *    until their commodity is changed or destroyed, the book is closed
+ *    or the default currency changes, so don't keep them around.
+ *
+ * gnc_amount_formatter_print() prints into buf, which is len bytes
+ *    long, without allocating. It returns the length of the printed
+ *    string, or 0 and an empty string if it doesn't fit.
+ *
+ * gnc_print_commodity_amount() is the xaccPrintAmount() of the cached
+ *    formatters, returning a static buffer.
+ */
+typedef struct _GNCAmountFormatter GNCAmountFormatter;
+
+const GNCAmountFormatter *gnc_commodity_amount_formatter (const gnc_commodity *commodity,
+        gboolean use_symbol);
+const GNCAmountFormatter *gnc_account_amount_formatter (const Account *account,
+        gboolean use_symbol);
+
+gsize gnc_amount_formatter_print (const GNCAmountFormatter *fmt,
+                                  gnc_numeric val, char *buf, gsize len);
+
+const char *gnc_print_commodity_amount (gnc_numeric val,
+                                        const gnc_commodity *commodity,
+                                        gboolean use_symbol);
+
 const gchar *printable_value(gdouble val, gint denom);
 gchar *number_to_words(gdouble val, gint64 denom);
 gchar *numeric_to_words(gnc_numeric val);
@@ -83,7 +83,7 @@ run_parser_test (TestNode *node)
     gboolean succeeded;
     gnc_numeric result;
     char *error_loc;
-    gchar *msg = "[func_op()] function eval error: [[func_op(]\n";
+    gchar *msg = "[apply_function()] function eval error: [[apply_function(]\n";
     guint loglevel = G_LOG_LEVEL_CRITICAL, hdlr;
     TestErrorStruct check = { loglevel, "gnc.gui", msg };
 
@@ -135,13 +135,76 @@ run_parser_test (TestNode *node)
     success (node->test_name);
 }
 
+/* A compiled expression must give the same result as parsing it, or fail
+ * to compile without an error location if it isn't supported. */
+static void
+run_compiled_test (TestNode *node)
+{
+    GncExpCompiled *exp;
+    gboolean succeeded;
+    gnc_numeric result;
+    char *error_loc = NULL;
+    gchar *msg = "[apply_function()] function eval error: [[apply_function(]\n";
+    guint loglevel = G_LOG_LEVEL_CRITICAL, hdlr;
+    TestErrorStruct check = { loglevel, "gnc.gui", msg };
+
+    result = gnc_numeric_error( -1 );
+    hdlr = g_log_set_handler ("gnc.gui", loglevel,
+                              (GLogFunc)test_checked_handler, &check);
+    exp = gnc_exp_parser_compile (node->exp, &error_loc);
+    if (exp)
+    {
+        succeeded = gnc_exp_parser_evaluate (exp, NULL, &result);
+        gnc_exp_parser_compiled_free (exp);
+    }
+    else
+        succeeded = FALSE;
+    g_log_remove_handler ("gnc.gui", hdlr);
+
+    if (!exp && node->exp && !error_loc)
+    {
+        success (node->test_name);
+        return;
+    }
+
+    if (succeeded != node->should_succeed)
+    {
+        failure_args (node->test_name, node->file, node->line,
+                      "compiled expression %s on \"%s\"",
+                      succeeded ? "succeeded" : "failed",
+                      node->exp);
+        return;
+    }
+
+    if (succeeded && !gnc_numeric_equal (result, node->expected_result))
+    {
+        failure_args (node->test_name, node->file, node->line,
+                      "wrong compiled result");
+        return;
+    }
+
+    if (!exp && node->expected_error_offset != -1 &&
+        error_loc != node->exp + node->expected_error_offset)
+    {
+        failure_args (node->test_name, node->file, node->line,
+                      "wrong compiled offset; expected %d, got %d",
+                      node->expected_error_offset, (error_loc - node->exp));
+        return;
+    }
+
+    success (node->test_name);
+}
+
 static void
 run_parser_tests (void)
 {
     GList *node;
 
     for (node = tests; node; node = node->next)
+    {
         run_parser_test (node->data);
+        run_compiled_test (node->data);
+    }
 }
 
 static void
@@ -246,12 +309,65 @@ test_variable_expressions()
     success("variable found");
 }
 
+static void
+test_compiled_variables (void)
+{
+    GncExpCompiled *exp;
+    gnc_numeric values[2], num;
+    GHashTable *vars;
+    gchar *errLoc = NULL;
+
+    exp = gnc_exp_parser_compile ("rate * (principal + 10)", &errLoc);
+    do_test (exp != NULL && errLoc == NULL, "compile with variables");
+    do_test (gnc_exp_parser_compiled_get_num_vars (exp) == 2, "two variables");
+    do_test (g_strcmp0 (gnc_exp_parser_compiled_get_var_name (exp, 0), "rate") == 0
+             && g_strcmp0 (gnc_exp_parser_compiled_get_var_name (exp, 1),
+                           "principal") == 0, "variables in order of use");
+
+    values[0] = gnc_numeric_create (3, 100);
+    values[1] = gnc_numeric_create (990, 1);
+    do_test (gnc_exp_parser_evaluate (exp, values, &num)
+             && gnc_numeric_equal (num, gnc_numeric_create (30, 1)),
+             "evaluate with variables");
+    values[1] = gnc_numeric_create (90, 1);
+    do_test (gnc_exp_parser_evaluate (exp, values, &num)
+             && gnc_numeric_equal (num, gnc_numeric_create (3, 1)),
+             "evaluate with other values");
+    values[1] = gnc_numeric_error (GNC_ERROR_ARG);
+    do_test (!gnc_exp_parser_evaluate (exp, values, &num),
+             "evaluate with an unset variable");
+    gnc_exp_parser_compiled_free (exp);
+
+    /* The parser negates variables in place, for the rest of the expression. */
+    vars = g_hash_table_new (g_str_hash, g_str_equal);
+    num = gnc_numeric_create (5, 1);
+    g_hash_table_insert (vars, "a", &num);
+    do_test (gnc_exp_parser_parse_separate_vars ("-a + a", &values[1], &errLoc, vars)
+             && gnc_numeric_equal (values[1], gnc_numeric_create (-10, 1)),
+             "parse negated variable");
+    g_hash_table_destroy (vars);
+    exp = gnc_exp_parser_compile ("-a + a", &errLoc);
+    do_test (exp != NULL && gnc_exp_parser_evaluate (exp, &num, &values[0])
+             && gnc_numeric_equal (values[0], values[1]),
+             "compiled negated variable");
+    gnc_exp_parser_compiled_free (exp);
+
+    exp = gnc_exp_parser_compile ("a * 2 + -a", &errLoc);
+    do_test (exp == NULL && errLoc == NULL, "variable negated after use");
+    exp = gnc_exp_parser_compile ("a = 2", &errLoc);
+    do_test (exp == NULL && errLoc == NULL, "assignment");
+    exp = gnc_exp_parser_compile ("1 +", &errLoc);
+    do_test (exp == NULL && errLoc != NULL, "parse error");
+    success ("compiled expressions");
+}
+
 static void
 real_main (void *closure, int argc, char **argv)
 {
     /* set_should_print_success (TRUE); */
     test_parser();
     test_variable_expressions();
+    test_compiled_variables();
     print_test_results();
     exit(get_rv());
 }
@@ -24,8 +24,10 @@
 
 #include <config.h>
 #include <glib.h>
+#include <string.h>
 #include <unittest-support.h>
 #include <qof.h>
+#include <gnc-locale-utils.h>
 #include "test-engine-stuff.h"
 
 #include "../gnc-ui-util.h"
@@ -254,9 +256,121 @@ test_book_use_book_currency( Fixture *fixture, gconstpointer pData )
     qof_book_commit_edit (fixture->book); */
 }
 
+static void
+check_formatter (const GNCAmountFormatter *fmt, GNCPrintAmountInfo info)
+{
+    gint64 nums[] = { 0, 1, -1, 5, -150, 123456789, -123456789,
+                      100000000000LL, 7 };
+    gint64 denoms[] = { 1, 10, 100, 1000 };
+    char buf[256];
+    guint i, j;
+
+    for (i = 0; i < G_N_ELEMENTS (nums); i++)
+        for (j = 0; j < G_N_ELEMENTS (denoms); j++)
+        {
+            gnc_numeric n = gnc_numeric_create (nums[i], denoms[j]);
+            gsize len = gnc_amount_formatter_print (fmt, n, buf, sizeof(buf));
+            g_assert_cmpstr (buf, ==, xaccPrintAmount (n, info));
+            g_assert_cmpuint (len, ==, strlen (buf));
+        }
+}
+
+static const char *
+format_amount (const GNCAmountFormatter *fmt, gint64 num, gint64 denom)
+{
+    static char buf[256];
+    gnc_amount_formatter_print (fmt, gnc_numeric_create (num, denom),
+                                buf, sizeof(buf));
+    return buf;
+}
+
+/* The literal amounts below are written in the conventions
+ * gnc_localeconv() falls back on when the locale has none. */
+static gboolean
+c_locale_conventions (void)
+{
+    struct lconv *lc = gnc_localeconv ();
+    return !g_strcmp0 (lc->mon_thousands_sep, ",") &&
+        !g_strcmp0 (lc->mon_decimal_point, ".") &&
+        !g_strcmp0 (lc->mon_grouping, "\003") &&
+        !g_strcmp0 (lc->negative_sign, "-") && lc->n_sign_posn == 1;
+}
+
+static void
+test_amount_formatter (Fixture *fixture, gconstpointer pData)
+{
+    gnc_commodity *usd = gnc_commodity_new (fixture->book, "US Dollar",
+                                            GNC_COMMODITY_NS_CURRENCY,
+                                            "USD", "840", 100);
+    gnc_commodity *stock = gnc_commodity_new (fixture->book, "Stock",
+                                              "NASDAQ", "STK", "", 1000);
+    Account *acct = xaccMallocAccount (fixture->book);
+    const GNCAmountFormatter *fmt;
+    char buf[8];
+
+    fmt = gnc_commodity_amount_formatter (usd, TRUE);
+    g_assert (fmt == gnc_commodity_amount_formatter (usd, TRUE));
+    check_formatter (fmt, gnc_commodity_print_info (usd, TRUE));
+    check_formatter (gnc_commodity_amount_formatter (usd, FALSE),
+                     gnc_commodity_print_info (usd, FALSE));
+    check_formatter (gnc_commodity_amount_formatter (stock, TRUE),
+                     gnc_commodity_print_info (stock, TRUE));
+    check_formatter (gnc_commodity_amount_formatter (NULL, TRUE),
+                     gnc_default_print_info (TRUE));
+
+    if (c_locale_conventions ())
+    {
+        g_test_message ("Grouping, signs and fractions");
+        fmt = gnc_commodity_amount_formatter (usd, FALSE);
+        g_assert_cmpstr (format_amount (fmt, 123456789, 100), ==, "1,234,567.89");
+        g_assert_cmpstr (format_amount (fmt, -123456789, 100), ==, "-1,234,567.89");
+        g_assert_cmpstr (format_amount (fmt, 100000000000LL, 1), ==,
+                         "100,000,000,000.00");
+        g_assert_cmpstr (format_amount (fmt, 5, 1), ==, "5.00");
+        g_assert_cmpstr (format_amount (fmt, 0, 1), ==, "0.00");
+        g_assert_cmpstr (format_amount (fmt, 1, 3), ==, "1/3");
+        g_assert_cmpstr (format_amount (fmt, 4, 3), ==, "1 + 1/3");
+        g_assert_cmpstr (format_amount (gnc_commodity_amount_formatter (stock, TRUE),
+                                        12345, 10), ==, "1,234.5 STK");
+    }
+    else
+        g_test_message ("Skipping literal amounts: the locale has its own "
+                        "monetary conventions");
+
+    g_test_message ("A changed commodity gets a new formatter");
+    gnc_commodity_set_user_symbol (stock, "shr");
+    fmt = gnc_commodity_amount_formatter (stock, TRUE);
+    check_formatter (fmt, gnc_commodity_print_info (stock, TRUE));
+    g_assert (strstr (format_amount (fmt, 12345, 10), "shr") != NULL);
+    g_assert (strstr (format_amount (fmt, 12345, 10), "STK") == NULL);
+    if (c_locale_conventions ())
+        g_assert_cmpstr (format_amount (fmt, 12345, 10), ==, "1,234.5 shr");
+    fmt = gnc_commodity_amount_formatter (usd, TRUE);
+
+    g_test_message ("Accounts use their own smallest commodity unit");
+    xaccAccountBeginEdit (acct);
+    xaccAccountSetCommodity (acct, stock);
+    xaccAccountSetCommoditySCU (acct, 10000);
+    xaccAccountCommitEdit (acct);
+    check_formatter (gnc_account_amount_formatter (acct, TRUE),
+                     gnc_account_print_info (acct, TRUE));
+
+    g_test_message ("Nothing is printed if the buffer is too small");
+    g_assert_cmpuint (gnc_amount_formatter_print (fmt,
+                                                  gnc_numeric_create (123456789, 100),
+                                                  buf, sizeof(buf)), ==, 0);
+    g_assert_cmpstr (buf, ==, "");
+
+    xaccAccountBeginEdit (acct);
+    xaccAccountDestroy (acct);
+    gnc_commodity_destroy (stock);
+    gnc_commodity_destroy (usd);
+}
+
 void
 test_suite_gnc_ui_util (void)
 {
     GNC_TEST_ADD( suitename, "use book-currency", Fixture, NULL, setup, test_book_use_book_currency, teardown );
+    GNC_TEST_ADD( suitename, "amount formatter", Fixture, NULL, setup, test_amount_formatter, teardown );
 
 }
@@ -66,6 +66,7 @@ extern "C"
 #include "gnc-locale-utils.h"
 
 #include "gnc-prefs.h"
+#include "qofbookslots.h"
 
 #ifdef S_SPLINT_S
 #include "splint-defs.h"
@@ -78,6 +79,7 @@ extern "C"
 
 #include <qofsession.hpp>
 #include <gnc-backend-prov.hpp>
+#include <kvp-frame.hpp>
 #include "gnc-backend-dbi.h"
 #include "gnc-backend-dbi.hpp"
 
@@ -863,6 +865,64 @@ GncDbiBackend<Type>::~GncDbiBackend()
 
 /* ================================================================= */
 
+/* Read the book's SQLite options, see business-prefs.scm. Multichoice
+ * options are stored as the symbol's name and booleans as "t" or "f"; an
+ * option that has never been set is absent and takes its default.
+ */
+static GncSqliteProfile
+get_sqlite_profile (QofBook* book)
+{
+    GncSqliteProfile profile;
+    auto slots = qof_instance_get_slots (QOF_INSTANCE (book));
+    auto option = [slots](const char* name) -> const char* {
+        auto value = slots->get_slot({KVP_OPTION_PATH, OPTION_SECTION_SQLITE,
+                                      name});
+        if (value == nullptr || value->get_type() != KvpValue::Type::STRING)
+            return nullptr;
+        return value->get<const char*>();
+    };
+
+    profile.tuned = g_strcmp0 (option (OPTION_NAME_SQLITE_PROFILE),
+                               "tuned") == 0;
+    auto synchronous = option (OPTION_NAME_SQLITE_SYNCHRONOUS);
+    if (g_strcmp0 (synchronous, "full") == 0)
+        profile.synchronous = "FULL";
+    else if (g_strcmp0 (synchronous, "off") == 0)
+        profile.synchronous = "OFF";
+    profile.memory_temp_store =
+        g_strcmp0 (option (OPTION_NAME_SQLITE_MEMORY_TEMP_STORE), "f") != 0;
+    return profile;
+}
+
+/* The SQLite profile is kept in the book's options, so it can't be set up
+ * before the book is loaded; it is applied before the accounts and
+ * transactions are, so that the rest of the load runs under it. */
+template <DbType Type> void
+GncDbiBackend<Type>::book_loaded (QofBook* book)
+{
+    if (Type != DbType::DBI_SQLITE)
+        return;
+    auto conn = dynamic_cast<GncDbiSqlConnection*>(m_conn);
+    if (conn == nullptr || conn->conn() == nullptr)
+    {
+        PWARN ("No SQLite connection to apply the book's profile to.");
+        return;
+    }
+    if (!conn->set_sqlite_profile (get_sqlite_profile (book)))
+        PWARN ("The book's SQLite profile was not applied.");
+}
+
+/* A book saved to a new file, as by Save As, isn't loaded from it, so its
+ * SQLite profile is applied once it has been written.
+ */
+template <DbType Type> void
+GncDbiBackend<Type>::sync (QofBook* book)
+{
+    GncSqlBackend::sync (book);
+    if (!check_error())
+        book_loaded (book);
+}
+
 /* GNUCASH_RESAVE_VERSION indicates the earliest database version
  * compatible with this version of Gnucash; the stored value is the
  * earliest version of Gnucash conpatible with the database. If the
@@ -965,6 +1025,7 @@ GncDbiBackend<Type>::safe_sync (QofBook* book)
     g_return_if_fail (book != nullptr);
 
     ENTER ("book=%p, primary=%p", book, m_book);
+    flush ();
     if (!conn->begin_transaction())
     {
         LEAVE("Failed to obtain a transaction.");
@@ -983,7 +1044,9 @@ GncDbiBackend<Type>::safe_sync (QofBook* book)
         return;
     }
 
-    sync(m_book);
+    /* The journal mode can't be changed inside the transaction; the
+     * profile was applied when the book was loaded anyway. */
+    GncSqlBackend::sync(m_book);
     if (check_error())
     {
         conn->rollback_transaction();
@@ -1008,6 +1071,7 @@ GncDbiBackend<DbType::DBI_MYSQL>::safe_sync (QofBook* book)
     g_return_if_fail (book != nullptr);
 
     ENTER ("book=%p, primary=%p", book, m_book);
+    flush ();
     if (!conn->table_operation (TableOpType::backup))
     {
         set_error(ERR_BACKEND_SERVER_ERR);
@@ -95,6 +95,7 @@ public:
     void session_begin(QofSession*, const char*, SessionOpenMode) override;
     void session_end() override;
     void load(QofBook*, QofBackendLoadType) override;
+    void sync(QofBook*) override;
     void safe_sync(QofBook*) override;
     bool connected() const noexcept { return m_conn != nullptr; }
     /** FIXME: Just a pass-through to m_conn: */
@@ -110,6 +111,8 @@ public:
     /*-----*/
     bool exists() { return m_exists; }
     void set_exists(bool exists) { m_exists = exists; }
+protected:
+    void book_loaded(QofBook*) override;
 private:
     dbi_conn conn_setup(PairVec& options, UriStrings& uri);
     bool conn_test_dbi_library(dbi_conn conn);
@@ -42,6 +42,19 @@ static QofLogModule log_module = G_LOG_DOMAIN;
 static const unsigned int DBI_MAX_CONN_ATTEMPTS = 5;
 const std::string lock_table = "gnclock";
 
+/* Tuned SQLite profile: 256 MiB of memory-mapped I/O and a 64 MiB page
+ * cache; a negative cache_size is in KiB rather than in pages. */
+static const int64_t SQLITE_MMAP_SIZE = 256 * 1024 * 1024;
+static const int SQLITE_CACHE_KIB = 64 * 1024;
+/* The indexes that create_tables makes for the most frequent lookups. Files
+ * written by other tools, or whose indexes were lost, may lack them. */
+static const StrVec sqlite_profile_indexes {
+    "splits_tx_guid_index ON splits(tx_guid)",
+    "splits_account_guid_index ON splits(account_guid)",
+    "slots_guid_index ON slots(obj_guid)",
+    "tx_post_date_index ON transactions(post_date)"
+};
+
 /* --------------------------------------------------------- */
 class GncDbiSqlStatement : public GncSqlStatement
 {
@@ -124,7 +137,7 @@ GncDbiSqlConnection::lock_database (bool break_lock)
         if (dbi_conn_error (m_conn, &errstr))
         {
             PERR ("Error %s creating lock table", errstr);
-            qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+            report_error (ERR_BACKEND_SERVER_ERR);
             return false;
         }
     }
@@ -139,7 +152,7 @@ GncDbiSqlConnection::lock_database (bool break_lock)
         result = nullptr;
         if (!break_lock)
         {
-            qof_backend_set_error (m_qbe, ERR_BACKEND_LOCKED);
+            report_error (ERR_BACKEND_LOCKED);
             /* FIXME: After enhancing the qof_backend_error mechanism, report in the dialog what is the hostname of the machine holding the lock. */
             rollback_transaction();
             return false;
@@ -147,7 +160,7 @@ GncDbiSqlConnection::lock_database (bool break_lock)
         result = dbi_conn_queryf (m_conn, "DELETE FROM %s", lock_table.c_str());
         if (!result)
         {
-            qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+            report_error (ERR_BACKEND_SERVER_ERR);
             m_qbe->set_message("Failed to delete lock record");
             rollback_transaction();
             return false;
@@ -163,7 +176,7 @@ GncDbiSqlConnection::lock_database (bool break_lock)
                               lock_table.c_str(), hostname, (int)GETPID ());
     if (!result)
     {
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
         m_qbe->set_message("Failed to create lock record");
         rollback_transaction();
         return false;
@@ -209,7 +222,7 @@ GncDbiSqlConnection::unlock_database ()
             if (!result)
             {
                 PERR ("Failed to delete the lock entry");
-                m_qbe->set_error (ERR_BACKEND_SERVER_ERR);
+                report_error (ERR_BACKEND_SERVER_ERR);
                 rollback_transaction();
                 return;
             }
@@ -226,7 +239,7 @@ GncDbiSqlConnection::unlock_database ()
         return;
     }
     PWARN ("Unable to get a lock on LOCK, so failed to clear the lock entry.");
-    m_qbe->set_error (ERR_BACKEND_SERVER_ERR);
+    report_error (ERR_BACKEND_SERVER_ERR);
 }
 
 bool
@@ -247,6 +260,15 @@ GncDbiSqlConnection::check_and_rollback_failed_save()
     return table_operation(recover);
 }
 
+void
+GncDbiSqlConnection::report_error (QofBackendError error) noexcept
+{
+    if (!m_hold_errors)
+        qof_backend_set_error (m_qbe, error);
+    else if (m_held_error == ERR_BACKEND_NO_ERR)
+        m_held_error = error;
+}
+
 GncDbiSqlConnection::~GncDbiSqlConnection()
 {
     if (m_conn)
@@ -275,9 +297,9 @@ GncDbiSqlConnection::execute_select_statement (const GncSqlStatementPtr& stmt)
     {
         PERR ("Error executing SQL %s\n", stmt->to_sql());
         if(m_last_error)
-            m_qbe->set_error(m_last_error);
+            report_error (m_last_error);
         else
-            m_qbe->set_error(ERR_BACKEND_SERVER_ERR);
+            report_error (ERR_BACKEND_SERVER_ERR);
     }
     gnc_pop_locale (LC_NUMERIC, locale);
     return GncSqlResultPtr(new GncDbiSqlResult (this, result));
@@ -300,9 +322,9 @@ GncDbiSqlConnection::execute_nonselect_statement (const GncSqlStatementPtr& stmt
     {
         PERR ("Error executing SQL %s\n", stmt->to_sql());
         if(m_last_error)
-            m_qbe->set_error(m_last_error);
+            report_error (m_last_error);
         else
-            m_qbe->set_error(ERR_BACKEND_SERVER_ERR);
+            report_error (ERR_BACKEND_SERVER_ERR);
         return -1;
     }
     if (!result)
@@ -313,9 +335,9 @@ GncDbiSqlConnection::execute_nonselect_statement (const GncSqlStatementPtr& stmt
     {
         PERR ("Error in dbi_result_free() result\n");
         if(m_last_error)
-            m_qbe->set_error(m_last_error);
+            report_error (m_last_error);
         else
-            m_qbe->set_error(ERR_BACKEND_SERVER_ERR);
+            report_error (ERR_BACKEND_SERVER_ERR);
     }
     return num_rows;
 }
@@ -344,7 +366,7 @@ GncDbiSqlConnection::begin_transaction () noexcept
     if (!verify ())
     {
         PERR ("gnc_dbi_verify_conn() failed\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
         return false;
     }
 
@@ -366,13 +388,13 @@ GncDbiSqlConnection::begin_transaction () noexcept
     if (!result)
     {
         PERR ("BEGIN transaction failed()\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
         return false;
     }
     if (dbi_result_free (result) < 0)
     {
         PERR ("Error in dbi_result_free() result\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
         return false;
     }
     ++m_sql_savepoint;
@@ -397,14 +419,14 @@ GncDbiSqlConnection::rollback_transaction () noexcept
     if (!result)
     {
         PERR ("Error in conn_rollback_transaction()\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
         return false;
     }
 
     if (dbi_result_free (result) < 0)
     {
         PERR ("Error in dbi_result_free() result\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
         return false;
     }
 
@@ -431,14 +453,14 @@ GncDbiSqlConnection::commit_transaction () noexcept
     if (!result)
     {
         PERR ("Error in conn_commit_transaction()\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
         return false;
     }
 
     if (dbi_result_free (result) < 0)
     {
         PERR ("Error in dbi_result_free() result\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
         return false;
     }
     --m_sql_savepoint;
@@ -473,7 +495,7 @@ GncDbiSqlConnection::create_table (const std::string& table_name,
     if (status < 0)
     {
         PERR ("Error in dbi_result_free() result\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
     }
 
     return true;
@@ -511,7 +533,7 @@ GncDbiSqlConnection::create_index(const std::string& index_name,
     if (status < 0)
     {
         PERR ("Error in dbi_result_free() result\n");
-        qof_backend_set_error (m_qbe, ERR_BACKEND_SERVER_ERR);
+        report_error (ERR_BACKEND_SERVER_ERR);
     }
 
     return true;
@@ -532,7 +554,7 @@ GncDbiSqlConnection::add_columns_to_table(const std::string& table_name,
     if (status < 0)
     {
         PERR( "Error in dbi_result_free() result\n" );
-        qof_backend_set_error(m_qbe, ERR_BACKEND_SERVER_ERR );
+        report_error (ERR_BACKEND_SERVER_ERR);
     }
 
     return true;
@@ -683,7 +705,7 @@ GncDbiSqlConnection::table_operation(TableOpType op) noexcept
         if (!backup_tables.empty())
         {
             PERR("Unable to backup database, an existing backup is present.");
-            qof_backend_set_error(m_qbe, ERR_BACKEND_DATA_CORRUPT);
+            report_error (ERR_BACKEND_DATA_CORRUPT);
             return false;
         }
         for (auto table : data_tables)
@@ -749,6 +771,45 @@ GncDbiSqlConnection::drop_indexes() noexcept
     return true;
 }
 
+bool
+GncDbiSqlConnection::set_sqlite_profile (const GncSqliteProfile& profile) noexcept
+{
+    StrVec statements;
+    /* The journal mode is stored in the file, so it has to be set back when
+     * the profile is turned off again. Neither can be done read-only. */
+    if (!m_readonly)
+        statements.push_back (profile.tuned ? "PRAGMA journal_mode=WAL" :
+                              "PRAGMA journal_mode=DELETE");
+    if (profile.tuned)
+    {
+        statements.push_back ("PRAGMA synchronous=" + profile.synchronous);
+        statements.push_back ("PRAGMA mmap_size=" +
+                              std::to_string (SQLITE_MMAP_SIZE));
+        statements.push_back ("PRAGMA cache_size=-" +
+                              std::to_string (SQLITE_CACHE_KIB));
+        if (profile.memory_temp_store)
+            statements.push_back ("PRAGMA temp_store=MEMORY");
+        if (!m_readonly)
+            for (const auto& index : sqlite_profile_indexes)
+                statements.push_back ("CREATE INDEX IF NOT EXISTS " + index);
+    }
+    for (const auto& sql : statements)
+    {
+        DEBUG ("SQL: %s\n", sql.c_str());
+        auto result = dbi_conn_query (m_conn, sql.c_str());
+        const char* errmsg;
+        if (dbi_conn_error (m_conn, &errmsg) != DBI_ERROR_NONE)
+        {
+            PERR ("Failed to apply the SQLite profile: %s", errmsg);
+            if (result)
+                dbi_result_free (result);
+            return false;
+        }
+        dbi_result_free (result);
+    }
+    return true;
+}
+
 std::string
 GncDbiSqlConnection::add_columns_ddl(const std::string& table_name,
                                      const ColVec& info_vec) const noexcept
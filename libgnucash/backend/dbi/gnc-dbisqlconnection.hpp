@@ -35,6 +35,16 @@
 using StrVec = std::vector<std::string>;
 class GncDbiProvider;
 
+/**
+ * Connection settings chosen by a book's SQLite options.
+ */
+struct GncSqliteProfile
+{
+    bool tuned = false;               /**< Apply the settings below */
+    std::string synchronous{"NORMAL"}; /**< FULL, NORMAL or OFF */
+    bool memory_temp_store = true;
+};
+
 /**
  * Encapsulate a libdbi dbi_conn connection.
  */
@@ -80,12 +90,25 @@ public:
      */
     bool verify() noexcept override;
     bool retry_connection(const char* msg) noexcept override;
+    void hold_errors(bool hold) noexcept override { m_hold_errors = hold; }
+    QofBackendError take_held_error() noexcept override
+    {
+        auto error = m_held_error;
+        m_held_error = ERR_BACKEND_NO_ERR;
+        return error;
+    }
 
     bool table_operation (TableOpType op) noexcept;
     std::string add_columns_ddl(const std::string& table_name,
                                 const ColVec& info_vec) const noexcept;
     bool drop_indexes() noexcept;
+    /** Apply a book's SQLite profile to the connection and, if it is tuned,
+     * create any of the lookup indexes that the file is missing.
+     */
+    bool set_sqlite_profile(const GncSqliteProfile& profile) noexcept;
 private:
+    /** Set @a error on the backend or, while errors are held, keep it. */
+    void report_error(QofBackendError error) noexcept;
     QofBackend* m_qbe = nullptr;
     dbi_conn m_conn;
     std::unique_ptr<GncDbiProvider> m_provider;
@@ -109,6 +132,8 @@ private:
     bool m_retry;
     unsigned int m_sql_savepoint;
     bool m_readonly; 
+    bool m_hold_errors = false;
+    QofBackendError m_held_error = ERR_BACKEND_NO_ERR;
     bool lock_database(bool break_lock);
     void unlock_database();
     bool rename_table(const std::string& old_name, const std::string& new_name);
@@ -605,6 +605,252 @@ test_dbi_business_store_and_reload (Fixture* fixture, gconstpointer pData)
     qof_session_destroy (session_3);
 }
 
+/* Editing one slot of an object loaded from the database should write
+ * just that slot rather than deleting and reinserting all of them. */
+static void
+test_dbi_slots_diff (Fixture* fixture, gconstpointer pData)
+{
+    auto url = (const gchar*)pData;
+    auto msg = "[GncDbiSqlConnection::unlock_database()] There was no lock entry in the Lock table";
+    auto log_domain = nullptr;
+    auto loglevel = static_cast<GLogLevelFlags> (G_LOG_LEVEL_WARNING |
+                                                 G_LOG_FLAG_FATAL);
+    TestErrorStruct* check = test_error_struct_new (log_domain, loglevel, msg);
+    fixture->hdlrs = test_log_set_fatal_handler (fixture->hdlrs, check,
+                                                 (GLogFunc)test_checked_handler);
+    if (fixture->filename)
+        url = fixture->filename;
+
+    auto root = gnc_book_get_root_account (qof_session_get_book (fixture->session));
+    auto acct = gnc_account_lookup_by_name (root, "Bank 1");
+    g_assert (acct != NULL);
+    auto guid = *qof_instance_get_guid (QOF_INSTANCE (acct));
+
+    // Save the session data
+    auto session_1 = qof_session_new (qof_book_new());
+    qof_session_begin (session_1, url, SESSION_NEW_OVERWRITE);
+    g_assert_cmpint (qof_session_get_error (session_1), == , ERR_BACKEND_NO_ERR);
+    qof_session_swap_data (fixture->session, session_1);
+    qof_book_mark_session_dirty (qof_session_get_book (session_1));
+    qof_session_save (session_1, NULL);
+    g_assert_cmpint (qof_session_get_error (session_1), == , ERR_BACKEND_NO_ERR);
+    qof_session_end (session_1);
+    qof_session_destroy (session_1);
+
+    // Reload it and change one slot at a time
+    auto session_2 = qof_session_new (qof_book_new());
+    qof_session_begin (session_2, url, SESSION_NORMAL_OPEN);
+    qof_session_load (session_2, NULL);
+    g_assert_cmpint (qof_session_get_error (session_2), == , ERR_BACKEND_NO_ERR);
+    acct = xaccAccountLookup (&guid, qof_session_get_book (session_2));
+    g_assert (acct != NULL);
+
+    qof_stats_set_enabled (TRUE);
+    qof_stats_reset ();
+    xaccAccountSetNotes (acct, "First note");
+    g_assert_cmpuint (qof_stats_get_count ("backend.sql.slots.statement"), == , 1);
+    qof_stats_reset ();
+    xaccAccountSetNotes (acct, "Second note");
+    g_assert_cmpuint (qof_stats_get_count ("backend.sql.slots.statement"), == , 1);
+    qof_stats_reset ();
+    xaccAccountSetColor (acct, "red");
+    g_assert_cmpuint (qof_stats_get_count ("backend.sql.slots.statement"), == , 1);
+    qof_stats_reset ();
+    xaccAccountSetColor (acct, NULL);
+    g_assert_cmpuint (qof_stats_get_count ("backend.sql.slots.statement"), == , 1);
+    auto stats = qof_stats_to_string ();
+    g_test_message ("%s", stats);
+    g_free (stats);
+    qof_stats_set_enabled (FALSE);
+    qof_session_end (session_2);
+    qof_session_destroy (session_2);
+
+    // The database should hold the edited slots and the untouched ones
+    auto session_3 = qof_session_new (qof_book_new());
+    qof_session_begin (session_3, url, SESSION_READ_ONLY);
+    qof_session_load (session_3, NULL);
+    g_assert_cmpint (qof_session_get_error (session_3), == , ERR_BACKEND_NO_ERR);
+    acct = xaccAccountLookup (&guid, qof_session_get_book (session_3));
+    g_assert (acct != NULL);
+    g_assert_cmpstr (xaccAccountGetNotes (acct), == , "Second note");
+    g_assert (xaccAccountGetColor (acct) == NULL);
+    auto frame = qof_instance_get_slots (QOF_INSTANCE (acct));
+    g_assert_cmpstr (frame->get_slot ({"string-val"})->get<const char*> (), == ,
+                     "abcdefghijklmnop");
+    qof_session_end (session_3);
+    qof_session_destroy (session_3);
+}
+
+static void
+set_sqlite_option (QofBook* book, const char* name, const char* value)
+{
+    auto path = g_slist_append (nullptr, (gpointer)OPTION_SECTION_SQLITE);
+    path = g_slist_append (path, (gpointer)name);
+    qof_book_set_option (book, new KvpValue {g_strdup (value)}, path);
+    g_slist_free (path);
+}
+
+static void
+test_dbi_sqlite_profile (Fixture* fixture, gconstpointer pData)
+{
+    auto msg = "[GncDbiSqlConnection::unlock_database()] There was no lock entry in the Lock table";
+    auto log_domain = nullptr;
+    auto loglevel = static_cast<GLogLevelFlags> (G_LOG_LEVEL_WARNING |
+                                                 G_LOG_FLAG_FATAL);
+    TestErrorStruct* check = test_error_struct_new (log_domain, loglevel, msg);
+    fixture->hdlrs = test_log_set_fatal_handler (fixture->hdlrs, check,
+                                                 (GLogFunc)test_checked_handler);
+    auto url = fixture->filename;
+    auto wal = g_strdup_printf ("%s-wal", url);
+    auto root = gnc_book_get_root_account (qof_session_get_book (fixture->session));
+    auto acct = gnc_account_lookup_by_name (root, "Bank 1");
+    g_assert (acct != NULL);
+    auto guid = *qof_instance_get_guid (QOF_INSTANCE (acct));
+
+    // Save the session data with the tuned profile selected
+    set_sqlite_option (qof_session_get_book (fixture->session),
+                       OPTION_NAME_SQLITE_PROFILE, "tuned");
+    set_sqlite_option (qof_session_get_book (fixture->session),
+                       OPTION_NAME_SQLITE_SYNCHRONOUS, "full");
+    auto session_1 = qof_session_new (qof_book_new());
+    qof_session_begin (session_1, url, SESSION_NEW_OVERWRITE);
+    g_assert_cmpint (qof_session_get_error (session_1), == , ERR_BACKEND_NO_ERR);
+    qof_session_swap_data (fixture->session, session_1);
+    qof_book_mark_session_dirty (qof_session_get_book (session_1));
+    qof_session_save (session_1, NULL);
+    g_assert_cmpint (qof_session_get_error (session_1), == , ERR_BACKEND_NO_ERR);
+    // The new file gets the profile without having to be reopened
+    g_assert (g_file_test (wal, G_FILE_TEST_EXISTS));
+    qof_session_end (session_1);
+    qof_session_destroy (session_1);
+
+    // Reopened, the file is written through a write-ahead log
+    auto session_2 = qof_session_new (qof_book_new());
+    qof_session_begin (session_2, url, SESSION_NORMAL_OPEN);
+    qof_session_load (session_2, NULL);
+    g_assert_cmpint (qof_session_get_error (session_2), == , ERR_BACKEND_NO_ERR);
+    acct = xaccAccountLookup (&guid, qof_session_get_book (session_2));
+    g_assert (acct != NULL);
+    xaccAccountSetNotes (acct, "Tuned");
+    g_assert_cmpint (qof_session_get_error (session_2), == , ERR_BACKEND_NO_ERR);
+    g_assert (g_file_test (wal, G_FILE_TEST_EXISTS));
+    set_sqlite_option (qof_session_get_book (session_2),
+                       OPTION_NAME_SQLITE_PROFILE, "default");
+    qof_session_end (session_2);
+    qof_session_destroy (session_2);
+
+    // Back on the default profile the rollback journal is used again
+    auto session_3 = qof_session_new (qof_book_new());
+    qof_session_begin (session_3, url, SESSION_NORMAL_OPEN);
+    qof_session_load (session_3, NULL);
+    g_assert_cmpint (qof_session_get_error (session_3), == , ERR_BACKEND_NO_ERR);
+    acct = xaccAccountLookup (&guid, qof_session_get_book (session_3));
+    g_assert (acct != NULL);
+    g_assert_cmpstr (xaccAccountGetNotes (acct), == , "Tuned");
+    xaccAccountSetNotes (acct, "Default");
+    g_assert_cmpint (qof_session_get_error (session_3), == , ERR_BACKEND_NO_ERR);
+    g_assert (!g_file_test (wal, G_FILE_TEST_EXISTS));
+    qof_session_end (session_3);
+    qof_session_destroy (session_3);
+    g_free (wal);
+}
+
+static void
+add_transfer (Account* from, Account* to, time64 date, gnc_numeric amount)
+{
+    auto book = gnc_account_get_book (from);
+    auto tx = xaccMallocTransaction (book);
+    xaccTransBeginEdit (tx);
+    xaccTransSetCurrency (tx, xaccAccountGetCommodity (from));
+    xaccTransSetDatePostedSecsNormalized (tx, date);
+    auto spl1 = xaccMallocSplit (book);
+    xaccSplitSetParent (spl1, tx);
+    xaccSplitSetAccount (spl1, to);
+    xaccSplitSetAmount (spl1, amount);
+    xaccSplitSetValue (spl1, amount);
+    auto spl2 = xaccMallocSplit (book);
+    xaccSplitSetParent (spl2, tx);
+    xaccSplitSetAccount (spl2, from);
+    xaccSplitSetAmount (spl2, gnc_numeric_neg (amount));
+    xaccSplitSetValue (spl2, gnc_numeric_neg (amount));
+    xaccTransCommitEdit (tx);
+}
+
+static void
+test_dbi_sum_split_amounts (Fixture* fixture, gconstpointer pData)
+{
+    auto url = (const gchar*)pData;
+    auto msg = "[GncDbiSqlConnection::unlock_database()] There was no lock entry in the Lock table";
+    auto log_domain = nullptr;
+    auto loglevel = static_cast<GLogLevelFlags> (G_LOG_LEVEL_WARNING |
+                                                 G_LOG_FLAG_FATAL);
+    TestErrorStruct* check = test_error_struct_new (log_domain, loglevel, msg);
+    fixture->hdlrs = test_log_set_fatal_handler (fixture->hdlrs, check,
+                                                 (GLogFunc)test_checked_handler);
+    if (fixture->filename)
+        url = fixture->filename;
+
+    auto book = qof_session_get_book (fixture->session);
+    auto root = gnc_book_get_root_account (book);
+    auto bank = gnc_account_lookup_by_name (root, "Bank 1");
+    g_assert (bank != NULL);
+    auto other = xaccMallocAccount (book);
+    xaccAccountSetType (other, ACCT_TYPE_EXPENSE);
+    xaccAccountSetName (other, "Expense 1");
+    xaccAccountSetCommodity (other, xaccAccountGetCommodity (bank));
+    gnc_account_append_child (root, other);
+    auto guid = *qof_instance_get_guid (QOF_INSTANCE (bank));
+    time64 dates[] {gnc_dmy2time64 (1, 3, 2016), gnc_dmy2time64 (1, 4, 2016),
+                    gnc_dmy2time64 (1, 5, 2016)};
+    add_transfer (other, bank, dates[0], gnc_numeric_create (1050, 100));
+    add_transfer (other, bank, dates[1], gnc_numeric_create (325, 100));
+    add_transfer (bank, other, dates[2], gnc_numeric_create (210, 100));
+
+    // Save the session data
+    auto session_1 = qof_session_new (qof_book_new());
+    qof_session_begin (session_1, url, SESSION_NEW_OVERWRITE);
+    g_assert_cmpint (qof_session_get_error (session_1), == , ERR_BACKEND_NO_ERR);
+    qof_session_swap_data (fixture->session, session_1);
+    qof_book_mark_session_dirty (qof_session_get_book (session_1));
+    qof_session_save (session_1, NULL);
+    g_assert_cmpint (qof_session_get_error (session_1), == , ERR_BACKEND_NO_ERR);
+    qof_session_end (session_1);
+    qof_session_destroy (session_1);
+
+    // The database's sums match the engine's balances
+    auto session_2 = qof_session_new (qof_book_new());
+    qof_session_begin (session_2, url, SESSION_READ_ONLY);
+    qof_session_load (session_2, NULL);
+    g_assert_cmpint (qof_session_get_error (session_2), == , ERR_BACKEND_NO_ERR);
+    book = qof_session_get_book (session_2);
+    bank = xaccAccountLookup (&guid, book);
+    g_assert (bank != NULL);
+    auto be = dynamic_cast<GncSqlBackend*> (qof_book_get_backend (book));
+    g_assert (be != nullptr);
+    g_assert (be->transactions_loaded ());
+
+    const time64 day = 24 * 3600;
+    time64 as_of[] {dates[0], dates[0] + day, dates[1] + day, dates[2] + day,
+                    INT64_MAX};
+    for (auto date : as_of)
+    {
+        gnc_numeric total;
+        g_assert (be->sum_split_amounts (QOF_INSTANCE (bank), INT64_MIN, date,
+                                         total));
+        g_assert (gnc_numeric_equal (total,
+                                     xaccAccountGetBalanceAsOfDate (bank, date)));
+    }
+    gnc_numeric total;
+    g_assert (be->sum_split_amounts (QOF_INSTANCE (bank), dates[1],
+                                     dates[2] + day, total));
+    g_assert (gnc_numeric_equal (total, gnc_numeric_create (115, 100)));
+    g_assert (be->sum_split_amounts (QOF_INSTANCE (bank), dates[2] + day,
+                                     INT64_MAX, total));
+    g_assert (gnc_numeric_zero_p (total));
+    qof_session_end (session_2);
+    qof_session_destroy (session_2);
+}
+
 static void
 test_adjust_sql_options_string (void)
 {
@@ -650,6 +896,13 @@ create_dbi_test_suite (const char* dbm_name, const char* url)
                   test_dbi_version_control, teardown);
     GNC_TEST_ADD (subsuite, "business_store_and_reload", Fixture, url,
                   setup_business, test_dbi_version_control, teardown);
+    GNC_TEST_ADD (subsuite, "slots_diff", Fixture, url, setup_memory,
+                  test_dbi_slots_diff, teardown);
+    GNC_TEST_ADD (subsuite, "sum_split_amounts", Fixture, url, setup_memory,
+                  test_dbi_sum_split_amounts, teardown);
+    if (g_strcmp0 (dbm_name, "sqlite3") == 0)
+        GNC_TEST_ADD (subsuite, "sqlite_profile", Fixture, url, setup_memory,
+                      test_dbi_sqlite_profile, teardown);
     g_free (subsuite);
 
 }
@@ -159,6 +159,7 @@ GncSqlCommodityBackend::load_all (GncSqlBackend* sql_be)
             if (qof_instance_is_dirty (QOF_INSTANCE (pCommodity)))
                 sql_be->commodity_for_postload_processing(pCommodity);
             qof_instance_set_guid (QOF_INSTANCE (pCommodity), &guid);
+            sql_be->set_commodity_in_db (pCommodity, true);
         }
 
     }
@@ -207,6 +208,9 @@ do_commit_commodity (GncSqlBackend* sql_be, QofInstance* inst,
             is_ok = gnc_sql_slots_delete (sql_be, guid);
         }
     }
+    if (is_ok)
+        sql_be->set_commodity_in_db (GNC_COMMODITY (inst),
+                                     !qof_instance_get_destroying (inst));
 
     return is_ok;
 }
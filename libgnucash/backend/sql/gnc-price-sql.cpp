@@ -110,20 +110,20 @@ GncSqlPriceBackend::load_all (GncSqlBackend* sql_be)
         if (result->begin() == result->end())
             return;
 
-        GNCPrice* pPrice;
+        GList* prices = nullptr;
 
-        gnc_pricedb_set_bulk_update (pPriceDB, TRUE);
         for (auto row : *result)
         {
-            pPrice = load_single_price (sql_be, row);
+            auto pPrice = load_single_price (sql_be, row);
 
             if (pPrice != NULL)
-            {
-                (void)gnc_pricedb_add_price (pPriceDB, pPrice);
-                gnc_price_unref (pPrice);
-            }
+                prices = g_list_prepend (prices, pPrice);
         }
+        prices = g_list_reverse (prices);
+        gnc_pricedb_set_bulk_update (pPriceDB, TRUE);
+        (void)gnc_pricedb_add_prices_bulk (pPriceDB, prices);
         gnc_pricedb_set_bulk_update (pPriceDB, FALSE);
+        g_list_free_full (prices, (GDestroyNotify)gnc_price_unref);
 	std::string pkey(col_table[0]->name());
         sql = "SELECT DISTINCT ";
 	sql += pkey + " FROM " TABLE_NAME;
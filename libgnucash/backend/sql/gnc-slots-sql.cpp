@@ -577,6 +577,15 @@ slot_info_copy (slot_info_t* pInfo, GncGUID* guid)
     return newSlot;
 }
 
+static bool
+slot_db_operation (E_DB_OPERATION op, slot_info_t& slot_info,
+                   const EntryVec& table)
+{
+    QOF_STAT_COUNT ("backend.sql.slots.statement");
+    return slot_info.be->do_db_operation (op, TABLE_NAME, TABLE_NAME,
+                                          &slot_info, table);
+}
+
 static void
 save_slot (const char* key, KvpValue* value, slot_info_t & slot_info)
 {
@@ -600,11 +609,7 @@ save_slot (const char* key, KvpValue* value, slot_info_t & slot_info)
         slot_info_t* pNewInfo = slot_info_copy (&slot_info, guid);
         KvpValue* oldValue = slot_info.pKvpValue;
         slot_info.pKvpValue = new KvpValue {guid};
-        slot_info.is_ok = slot_info.be->do_db_operation(OP_DB_INSERT,
-                                                            TABLE_NAME,
-                                                            TABLE_NAME,
-                                                            &slot_info,
-                                                            col_table);
+        slot_info.is_ok = slot_db_operation (OP_DB_INSERT, slot_info, col_table);
         g_return_if_fail (slot_info.is_ok);
         pKvpFrame->for_each_slot_temp (save_slot, *pNewInfo);
         delete slot_info.pKvpValue;
@@ -618,11 +623,7 @@ save_slot (const char* key, KvpValue* value, slot_info_t & slot_info)
         slot_info_t* pNewInfo = slot_info_copy (&slot_info, guid);
         KvpValue* oldValue = slot_info.pKvpValue;
         slot_info.pKvpValue = new KvpValue {guid};  // Transfer ownership!
-        slot_info.is_ok = slot_info.be->do_db_operation(OP_DB_INSERT,
-                                                            TABLE_NAME,
-                                                            TABLE_NAME,
-                                                            &slot_info,
-                                                            col_table);
+        slot_info.is_ok = slot_db_operation (OP_DB_INSERT, slot_info, col_table);
         g_return_if_fail (slot_info.is_ok);
         for (auto cursor = value->get<GList*> (); cursor; cursor = cursor->next)
         {
@@ -636,16 +637,161 @@ save_slot (const char* key, KvpValue* value, slot_info_t & slot_info)
     break;
     default:
     {
-        slot_info.is_ok = slot_info.be->do_db_operation (OP_DB_INSERT,
-                                                             TABLE_NAME,
-                                                             TABLE_NAME,
-                                                             &slot_info,
-                                                             col_table);
+        slot_info.is_ok = slot_db_operation (OP_DB_INSERT, slot_info, col_table);
     }
     break;
     }
 }
 
+/* The obj_guid and name columns, which between them identify a slot's row. */
+static PairVec
+get_slot_key (slot_info_t& slot_info)
+{
+    PairVec key;
+    col_table[obj_guid_col]->add_to_query (TABLE_NAME, &slot_info, key);
+    col_table[name_col]->add_to_query (TABLE_NAME, &slot_info, key);
+    return key;
+}
+
+static bool
+update_slot (slot_info_t& slot_info)
+{
+    PairVec values;
+    for (auto col = static_cast<int>(slot_type_col); col <= gdate_val_col; ++col)
+        col_table[col]->add_to_query (TABLE_NAME, &slot_info, values);
+
+    std::string sql {"UPDATE " TABLE_NAME " SET "};
+    for (auto const& col_value : values)
+    {
+        if (col_value != *values.begin())
+            sql += ",";
+        sql += col_value.first + "=" + col_value.second;
+    }
+    auto stmt = slot_info.be->create_statement_from_sql (sql);
+    if (stmt == nullptr)
+        return false;
+    stmt->add_where_cond (TABLE_NAME, get_slot_key (slot_info));
+    QOF_STAT_COUNT ("backend.sql.slots.statement");
+    return slot_info.be->execute_nonselect_statement (stmt) != -1;
+}
+
+/* Frame and list slots keep their contents under a guid of their own. */
+static bool
+get_child_guid (slot_info_t& slot_info, GncGUID* child_guid)
+{
+    std::string sql {"SELECT guid_val FROM " TABLE_NAME};
+    auto stmt = slot_info.be->create_statement_from_sql (sql);
+    if (stmt == nullptr)
+        return false;
+    stmt->add_where_cond (TABLE_NAME, get_slot_key (slot_info));
+    QOF_STAT_COUNT ("backend.sql.slots.statement");
+    auto result = slot_info.be->execute_select_statement (stmt);
+    if (result == nullptr)
+        return false;
+    for (auto row : *result)
+    {
+        try
+        {
+            auto val = row.get_string_at_col (col_table[guid_val_col]->name());
+            return string_to_guid (val.c_str(), child_guid);
+        }
+        catch (std::invalid_argument&)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+static void
+remove_slot (const std::string& key, KvpValue* value, slot_info_t& slot_info)
+{
+    if (!slot_info.is_ok)
+        return;
+    slot_info.pKvpValue = value;
+    slot_info.path = slot_info.parent_path + key;
+    slot_info.value_type = value->get_type ();
+
+    if (slot_info.value_type == KvpValue::Type::FRAME ||
+        slot_info.value_type == KvpValue::Type::GLIST)
+    {
+        GncGUID child_guid;
+        if (get_child_guid (slot_info, &child_guid))
+            slot_info.is_ok = gnc_sql_slots_delete (slot_info.be, &child_guid);
+        if (!slot_info.is_ok)
+            return;
+    }
+
+    std::string sql {"DELETE FROM " TABLE_NAME};
+    auto stmt = slot_info.be->create_statement_from_sql (sql);
+    if (stmt == nullptr)
+    {
+        slot_info.is_ok = FALSE;
+        return;
+    }
+    stmt->add_where_cond (TABLE_NAME, get_slot_key (slot_info));
+    QOF_STAT_COUNT ("backend.sql.slots.statement");
+    slot_info.is_ok = slot_info.be->execute_nonselect_statement (stmt) != -1;
+}
+
+/* Bring the rows stored for old_frame into line with new_frame, leaving
+ * alone the slots that haven't changed. Frames are compared key by key;
+ * a changed list is replaced whole. */
+static void
+diff_slots (KvpFrame* old_frame, KvpFrame* new_frame, slot_info_t& slot_info)
+{
+    for (auto const& key : old_frame->get_keys ())
+    {
+        if (new_frame->get_slot ({key}) == nullptr)
+            remove_slot (key, old_frame->get_slot ({key}), slot_info);
+    }
+
+    for (auto const& key : new_frame->get_keys ())
+    {
+        if (!slot_info.is_ok)
+            return;
+        auto new_value = new_frame->get_slot ({key});
+        auto old_value = old_frame->get_slot ({key});
+        if (old_value == nullptr)
+        {
+            save_slot (key.c_str(), new_value, slot_info);
+            continue;
+        }
+        if (compare (*old_value, *new_value) == 0)
+            continue;
+
+        auto type = new_value->get_type ();
+        if (type == KvpValue::Type::FRAME &&
+            old_value->get_type () == KvpValue::Type::FRAME)
+        {
+            GncGUID child_guid;
+            slot_info.pKvpValue = new_value;
+            slot_info.path = slot_info.parent_path + key;
+            slot_info.value_type = type;
+            if (get_child_guid (slot_info, &child_guid))
+            {
+                auto pNewInfo = slot_info_copy (&slot_info, &child_guid);
+                diff_slots (old_value->get<KvpFrame*> (),
+                            new_value->get<KvpFrame*> (), *pNewInfo);
+                slot_info.is_ok = pNewInfo->is_ok;
+                delete pNewInfo;
+                continue;
+            }
+        }
+        else if (type == old_value->get_type () &&
+                 type != KvpValue::Type::GLIST)
+        {
+            slot_info.pKvpValue = new_value;
+            slot_info.path = slot_info.parent_path + key;
+            slot_info.value_type = type;
+            slot_info.is_ok = update_slot (slot_info);
+            continue;
+        }
+        remove_slot (key, old_value, slot_info);
+        save_slot (key.c_str(), new_value, slot_info);
+    }
+}
+
 gboolean
 gnc_sql_slots_save (GncSqlBackend* sql_be, const GncGUID* guid, gboolean is_infant,
                     QofInstance* inst)
@@ -658,14 +804,26 @@ gnc_sql_slots_save (GncSqlBackend* sql_be, const GncGUID* guid, gboolean is_infa
     g_return_val_if_fail (guid != NULL, FALSE);
     g_return_val_if_fail (pFrame != NULL, FALSE);
 
-    // If this is not saving into a new db, clear out the old saved slots first
+    slot_info.be = sql_be;
+    slot_info.guid = guid;
+
+    /* If the slots were noted when the edit began, write only the
+     * difference; otherwise clear out the old saved slots first, unless
+     * this is saving into a new db. */
+    auto snapshot = sql_be->slots_snapshot (guid);
+    if (snapshot != nullptr && !sql_be->pristine() && !is_infant)
+    {
+        diff_slots (snapshot, pFrame, slot_info);
+        sql_be->set_slots_snapshot (guid, nullptr);
+        return slot_info.is_ok;
+    }
+    sql_be->set_slots_snapshot (guid, nullptr);
+
     if (!sql_be->pristine() && !is_infant)
     {
         (void)gnc_sql_slots_delete (sql_be, guid);
     }
 
-    slot_info.be = sql_be;
-    slot_info.guid = guid;
     pFrame->for_each_slot_temp (save_slot, slot_info);
 
     return slot_info.is_ok;
@@ -690,6 +848,7 @@ gnc_sql_slots_delete (GncSqlBackend* sql_be, const GncGUID* guid)
     g_free (buf);
     if (stmt != nullptr)
     {
+        QOF_STAT_COUNT ("backend.sql.slots.statement");
         auto result = sql_be->execute_select_statement(stmt);
         for (auto row : *result)
         {
@@ -712,13 +871,31 @@ gnc_sql_slots_delete (GncSqlBackend* sql_be, const GncGUID* guid)
     slot_info.be = sql_be;
     slot_info.guid = guid;
     slot_info.is_ok = TRUE;
-    slot_info.is_ok = sql_be->do_db_operation(OP_DB_DELETE, TABLE_NAME,
-                                              TABLE_NAME, &slot_info,
-                                              obj_guid_col_table);
+    slot_info.is_ok = slot_db_operation (OP_DB_DELETE, slot_info,
+                                         obj_guid_col_table);
+    sql_be->set_slots_snapshot (guid, nullptr);
 
     return slot_info.is_ok;
 }
 
+void
+gnc_sql_slots_begin_edit (GncSqlBackend* sql_be, QofInstance* inst)
+{
+    g_return_if_fail (sql_be != NULL);
+    g_return_if_fail (inst != NULL);
+
+    auto guid = qof_instance_get_guid (inst);
+    auto pFrame = qof_instance_get_slots (inst);
+
+    /* A clean instance's slots match what's in the database; a dirty or
+     * infant one's may not, so its slots get rewritten in full. */
+    if (pFrame == nullptr || qof_instance_get_infant (inst) ||
+        qof_instance_get_dirty_flag (inst))
+        sql_be->set_slots_snapshot (guid, nullptr);
+    else
+        sql_be->set_slots_snapshot (guid, new KvpFrame {*pFrame});
+}
+
 static void
 load_slot (slot_info_t* pInfo, GncSqlRow& row)
 {
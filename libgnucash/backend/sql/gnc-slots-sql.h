@@ -70,6 +70,15 @@ gboolean gnc_sql_slots_save (GncSqlBackend* sql_be, const GncGUID* guid,
  */
 gboolean gnc_sql_slots_delete (GncSqlBackend* sql_be, const GncGUID* guid);
 
+/**
+ * gnc_sql_slots_begin_edit - Notes an object's slots as it begins an edit so
+ * that gnc_sql_slots_save can write only the slots that change.
+ *
+ * @param sql_be SQL backend
+ * @param inst The QofInstance being edited.
+ */
+void gnc_sql_slots_begin_edit (GncSqlBackend* sql_be, QofInstance* inst);
+
 /** Loads slots for an object from the db.
  *
  * @param sql_be SQL backend
@@ -32,16 +32,20 @@ extern "C"
 #include <gncTaxTable.h>
 #include <gncInvoice.h>
 #include <gnc-pricedb.h>
+#include <Transaction.h>
 }
 
 #include <algorithm>
 #include <cassert>
 
+#include <kvp-frame.hpp>
+
 #include "gnc-sql-connection.hpp"
 #include "gnc-sql-backend.hpp"
 #include "gnc-sql-object-backend.hpp"
 #include "gnc-sql-column-table-entry.hpp"
 #include "gnc-sql-result.hpp"
+#include "gnc-sql-write-queue.hpp"
 
 #include "gnc-account-sql.h"
 #include "gnc-book-sql.h"
@@ -88,13 +92,72 @@ GncSqlBackend::GncSqlBackend(GncSqlConnection *conn, QofBook* book) :
         connect (conn);
 }
 
+GncSqlBackend::~GncSqlBackend()
+{
+    m_write_queue.reset();
+}
+
 void
 GncSqlBackend::connect(GncSqlConnection *conn) noexcept
 {
+    set_write_behind (false);
     if (m_conn != nullptr && m_conn != conn)
         delete m_conn;
     finalize_version_info();
+    m_commodities_in_db.clear();
     m_conn = conn;
+    if (m_conn != nullptr && gnc_prefs_get_sql_write_behind ())
+        set_write_behind (true);
+}
+
+void
+GncSqlBackend::set_write_behind(bool enable) noexcept
+{
+    if (enable)
+    {
+        if (m_write_queue == nullptr && m_conn != nullptr)
+            m_write_queue.reset (new GncSqlWriteQueue {m_conn});
+        return;
+    }
+    if (m_write_queue == nullptr)
+        return;
+    flush ();
+    m_write_queue.reset ();
+}
+
+bool
+GncSqlBackend::sum_split_amounts(const QofInstance* account, time64 start,
+                                 time64 end, gnc_numeric& total)
+{
+    g_return_val_if_fail (GNC_IS_ACCOUNT (account), false);
+    return gnc_sql_transaction_sum_amounts (this, GNC_ACCOUNT (account),
+                                            start, end, total);
+}
+
+void
+GncSqlBackend::flush() noexcept
+{
+    if (m_write_queue == nullptr)
+        return;
+    m_write_queue->flush ();
+    take_write_behind_error ();
+}
+
+/* The instances whose queued SQL was lost are already marked clean, so the
+ * book is marked dirty instead: the user is asked to save and the save
+ * rewrites the whole book. */
+bool
+GncSqlBackend::take_write_behind_error() noexcept
+{
+    auto error = m_write_queue->take_error ();
+    if (error == ERR_BACKEND_NO_ERR)
+        return false;
+    set_error (error);
+    m_write_behind_failed = true;
+    m_commodities_in_db.clear();
+    if (m_book != nullptr)
+        qof_book_mark_session_dirty (m_book);
+    return true;
 }
 
 GncSqlStatementPtr
@@ -112,6 +175,10 @@ GncSqlBackend::create_statement_from_sql(const std::string& str) const noexcept
 GncSqlResultPtr
 GncSqlBackend::execute_select_statement(const GncSqlStatementPtr& stmt) const noexcept
 {
+    QOF_STAT_COUNT ("backend.sql.select");
+    /* A query has to see every write queued before it. */
+    if (m_write_queue)
+        m_write_queue->flush ();
     auto result = m_conn ? m_conn->execute_select_statement(stmt) : nullptr;
     if (result == nullptr)
     {
@@ -124,6 +191,16 @@ GncSqlBackend::execute_select_statement(const GncSqlStatementPtr& stmt) const no
 int
 GncSqlBackend::execute_nonselect_statement(const GncSqlStatementPtr& stmt) const noexcept
 {
+    QOF_STAT_COUNT ("backend.sql.nonselect");
+    if (m_write_queue)
+    {
+        if (m_write_queue->collecting ())
+        {
+            m_write_queue->add (stmt->to_sql ());
+            return 1;
+        }
+        m_write_queue->flush ();
+    }
     int result = m_conn ? m_conn->execute_nonselect_statement(stmt) : -1;
     if (result == -1)
     {
@@ -277,8 +354,10 @@ GncSqlBackend::load (QofBook* book, QofBackendLoadType loadType)
 
     g_return_if_fail (book != NULL);
 
+    QOF_STAT_SCOPED_TIMER ("backend.sql.load");
     ENTER ("sql_be=%p, book=%p", this, book);
 
+    flush ();
     m_loading = TRUE;
 
     if (loadType == LOAD_TYPE_INITIAL_LOAD)
@@ -299,6 +378,8 @@ GncSqlBackend::load (QofBook* book, QofBackendLoadType loadType)
                 update_progress(num_done * 100 / num_types);
                 obe->load_all(this);
             }
+            if (type == GNC_ID_BOOK)
+                book_loaded(book);
         }
         for (auto type : business_fixed_load_order)
         {
@@ -316,7 +397,10 @@ GncSqlBackend::load (QofBook* book, QofBackendLoadType loadType)
                                        nullptr);
 
         m_backend_registry.load_remaining(this);
+        /* GNC_ID_TRANS is in fixed_load_order, so all of them are in. */
+        m_transactions_loaded = true;
 
+        gnc_book_finalize_load (book);
         gnc_account_foreach_descendant(root, (AccountCb)xaccAccountCommitEdit,
                                        nullptr);
     }
@@ -325,6 +409,7 @@ GncSqlBackend::load (QofBook* book, QofBackendLoadType loadType)
         // Load all transactions
         auto obe = m_backend_registry.get_object_backend (GNC_ID_TRANS);
         obe->load_all (this);
+        m_transactions_loaded = true;
     }
 
     m_loading = FALSE;
@@ -461,7 +546,16 @@ GncSqlBackend::sync(QofBook* book)
     g_return_if_fail (book != NULL);
     g_return_if_fail (m_conn != nullptr);
 
+    flush ();
+    if (m_write_behind_failed)
+    {
+        /* The tables hold an unknown part of the book; replace them. */
+        m_write_behind_failed = false;
+        safe_sync (book);
+        return;
+    }
     reset_version_info();
+    m_commodities_in_db.clear();
     ENTER ("book=%p, sql_be->book=%p", book, m_book);
     update_progress(101.0);
 
@@ -471,6 +565,7 @@ GncSqlBackend::sync(QofBook* book)
 
     /* Save all contents */
     m_book = book;
+    m_transactions_loaded = true;
     auto is_ok = m_conn->begin_transaction();
 
     // FIXME: should write the set of commodities that are used
@@ -518,6 +613,7 @@ GncSqlBackend::sync(QofBook* book)
     {
         set_error (ERR_BACKEND_SERVER_ERR);
         m_conn->rollback_transaction ();
+        m_commodities_in_db.clear();
     }
     finish_progress();
     LEAVE ("book=%p", book);
@@ -529,19 +625,93 @@ GncSqlBackend::sync(QofBook* book)
 void
 GncSqlBackend::begin(QofInstance* inst)
 {
-    //g_return_if_fail (inst != NULL);
+    g_return_if_fail (inst != NULL);
 
-    //ENTER (" ");
-    //LEAVE ("");
+    if (m_loading || m_is_pristine_db)
+        return;
+
+    /* Note the slots as they are in the database so that the commit only
+     * writes the ones that change. A transaction's splits are committed
+     * along with it without an edit of their own. */
+    gnc_sql_slots_begin_edit (this, inst);
+    if (GNC_IS_TRANSACTION (inst))
+    {
+        for (auto node = xaccTransGetSplitList (GNC_TRANSACTION (inst));
+             node != nullptr; node = g_list_next (node))
+            gnc_sql_slots_begin_edit (this, QOF_INSTANCE (node->data));
+    }
 }
 
 void
 GncSqlBackend::rollback(QofInstance* inst)
 {
-    //g_return_if_fail (inst != NULL);
+    g_return_if_fail (inst != NULL);
 
-    //ENTER (" ");
-    //LEAVE ("");
+    drop_slots_snapshots (inst);
+}
+
+/* Drop the copies begin() took: the instance's own and, for a
+ * transaction, its splits'. */
+void
+GncSqlBackend::drop_slots_snapshots(QofInstance* inst) noexcept
+{
+    set_slots_snapshot (qof_instance_get_guid (inst), nullptr);
+    if (GNC_IS_TRANSACTION (inst))
+    {
+        for (auto node = xaccTransGetSplitList (GNC_TRANSACTION (inst));
+             node != nullptr; node = g_list_next (node))
+            set_slots_snapshot (qof_instance_get_guid (node->data), nullptr);
+    }
+}
+
+KvpFrame*
+GncSqlBackend::slots_snapshot(const GncGUID* guid) const noexcept
+{
+    g_return_val_if_fail (guid != nullptr, nullptr);
+
+    gchar guid_buf[GUID_ENCODING_LENGTH + 1];
+    guid_to_string_buff (guid, guid_buf);
+    auto iter = m_slots_snapshots.find (guid_buf);
+    return iter == m_slots_snapshots.end () ? nullptr : iter->second.get ();
+}
+
+void
+GncSqlBackend::set_slots_snapshot(const GncGUID* guid, KvpFrame* frame) noexcept
+{
+    g_return_if_fail (guid != nullptr);
+
+    gchar guid_buf[GUID_ENCODING_LENGTH + 1];
+    guid_to_string_buff (guid, guid_buf);
+    if (frame == nullptr)
+        m_slots_snapshots.erase (guid_buf);
+    else
+        m_slots_snapshots[guid_buf] = std::shared_ptr<KvpFrame>{frame};
+}
+
+void
+GncSqlBackend::begin_batch()
+{
+    g_return_if_fail (m_conn != nullptr);
+    /* The write-behind queue already groups commits into transactions. */
+    if (m_in_batch || m_write_queue || qof_book_is_readonly (m_book))
+        return;
+    m_in_batch = m_conn->begin_transaction ();
+    if (!m_in_batch)
+        PERR ("begin_transaction failed\n");
+}
+
+void
+GncSqlBackend::end_batch()
+{
+    if (!m_in_batch)
+        return;
+    m_in_batch = false;
+    if (!m_conn->commit_transaction ())
+    {
+        PERR ("commit_transaction failed\n");
+        set_error (ERR_BACKEND_SERVER_ERR);
+        m_commodities_in_db.clear();
+    }
 }
 
 void
@@ -571,6 +741,7 @@ GncSqlBackend::commit (QofInstance* inst)
     g_return_if_fail (inst != NULL);
     g_return_if_fail (m_conn != nullptr);
 
+    QOF_STAT_SCOPED_TIMER ("backend.sql.commit");
     if (qof_book_is_readonly(m_book))
     {
         set_error (ERR_BACKEND_READONLY);
@@ -605,11 +776,22 @@ GncSqlBackend::commit (QofInstance* inst)
 
     if (!is_dirty && !is_destroying)
     {
+        drop_slots_snapshots (inst);
         LEAVE ("!dirty OR !destroying");
         return;
     }
 
-    if (!m_conn->begin_transaction ())
+    if (m_write_queue)
+    {
+        /* Report a failed queued write before taking on more. */
+        if (take_write_behind_error ())
+        {
+            LEAVE ("Write-behind error");
+            return;
+        }
+        m_write_queue->begin_group ();
+    }
+    else if (!m_conn->begin_transaction ())
     {
         PERR ("begin_transaction failed\n");
         LEAVE ("Rolled back - database transaction begin error");
@@ -624,7 +806,10 @@ GncSqlBackend::commit (QofInstance* inst)
     else
     {
         PERR ("Unknown object type '%s'\n", inst->e_type);
-        (void)m_conn->rollback_transaction ();
+        if (m_write_queue)
+            m_write_queue->end_group (false);
+        else
+            (void)m_conn->rollback_transaction ();
 
         // Don't let unknown items still mark the book as being dirty
         qof_book_mark_session_saved(m_book);
@@ -634,15 +819,23 @@ GncSqlBackend::commit (QofInstance* inst)
     }
     if (!is_ok)
     {
+        /* A commodity inserted along the way goes with the rest. */
+        m_commodities_in_db.clear();
         // Error - roll it back
-        (void)m_conn->rollback_transaction();
+        if (m_write_queue)
+            m_write_queue->end_group (false);
+        else
+            (void)m_conn->rollback_transaction();
 
         // This *should* leave things marked dirty
         LEAVE ("Rolled back - database error");
         return;
     }
 
-    (void)m_conn->commit_transaction ();
+    if (m_write_queue)
+        m_write_queue->end_group (true);
+    else
+        (void)m_conn->commit_transaction ();
 
     qof_book_mark_session_saved(m_book);
     qof_instance_mark_clean (inst);
@@ -871,12 +1064,31 @@ GncSqlBackend::save_commodity(gnc_commodity* comm) noexcept
 {
     if (comm == nullptr) return false;
     QofInstance* inst = QOF_INSTANCE(comm);
+    gchar guid_buf[GUID_ENCODING_LENGTH + 1];
+    guid_to_string_buff (qof_instance_get_guid (inst), guid_buf);
+    /* Asking the database would wait for every queued write. */
+    if (m_commodities_in_db.count (guid_buf))
+        return true;
     auto obe = m_backend_registry.get_object_backend(std::string(inst->e_type));
     if (obe && !obe->instance_in_db(this, inst))
         return obe->commit(this, inst);
+    m_commodities_in_db.insert (guid_buf);
     return true;
 }
 
+void
+GncSqlBackend::set_commodity_in_db(const gnc_commodity* comm, bool in_db) noexcept
+{
+    g_return_if_fail (comm != nullptr);
+
+    gchar guid_buf[GUID_ENCODING_LENGTH + 1];
+    guid_to_string_buff (qof_instance_get_guid (comm), guid_buf);
+    if (in_db)
+        m_commodities_in_db.insert (guid_buf);
+    else
+        m_commodities_in_db.erase (guid_buf);
+}
+
 GncSqlStatementPtr
 GncSqlBackend::build_insert_statement (const char* table_name,
                                        QofIdTypeConst obj_name,
@@ -32,6 +32,9 @@ extern "C"
 #include <memory>
 #include <exception>
 #include <sstream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <qof-backend.hpp>
 
@@ -43,6 +46,7 @@ using GncSqlObjectBackendPtr = std::shared_ptr<GncSqlObjectBackend>;
 using OBEEntry = std::tuple<std::string, GncSqlObjectBackendPtr>;
 using OBEVec = std::vector<OBEEntry>;
 class GncSqlConnection;
+class GncSqlWriteQueue;
 class GncSqlStatement;
 using GncSqlStatementPtr = std::unique_ptr<GncSqlStatement>;
 class GncSqlResult;
@@ -66,7 +70,7 @@ class GncSqlBackend : public QofBackend
 {
 public:
     GncSqlBackend(GncSqlConnection *conn, QofBook* book);
-    virtual ~GncSqlBackend() = default;
+    virtual ~GncSqlBackend();
     /**
      * Load the contents of an SQL database into a book.
      *
@@ -97,6 +101,37 @@ public:
      * @param inst Object being edited
      */
     void rollback(QofInstance*) override;
+    /**
+     * Wrap the commits deferred by a bulk load in one database
+     * transaction; each object's commit becomes a savepoint within it.
+     */
+    void begin_batch() override;
+    void end_batch() override;
+    /**
+     * Whether every transaction in the database has been loaded.
+     */
+    bool transactions_loaded() const override { return m_transactions_loaded; }
+    /**
+     * Sum an account's split amounts for a period in the database, see
+     * gnc_sql_transaction_sum_amounts().
+     */
+    bool sum_split_amounts(const QofInstance* account, time64 start,
+                           time64 end, gnc_numeric& total) override;
+    /**
+     * Turn write-behind on or off. With write-behind on, commit() queues
+     * the SQL for each object and returns at once; a worker thread writes
+     * the queue to the database in grouped transactions. Turning it off
+     * waits for the queue to be written first.
+     *
+     * @param enable Whether to write behind.
+     */
+    void set_write_behind(bool enable) noexcept;
+    /**
+     * Wait until all queued writes are in the database. An error from a
+     * queued write is reported as this backend's error, and the book is
+     * marked dirty so that the next save rewrites it in full.
+     */
+    void flush() noexcept;
     /** Connect the backend to a GncSqlConnection.
      * Sets up version info. Calling with nullptr clears the connection and
      * destroys the version info.
@@ -234,21 +269,56 @@ public:
      * @return true if the commodity needed to be saved.
      */
     bool save_commodity(gnc_commodity* comm) noexcept;
+    /**
+     * Note whether a commodity is known to be in the database, so that
+     * save_commodity() needn't query for it.
+     *
+     * @param comm The commodity
+     * @param in_db Whether it has been loaded or saved, or deleted
+     */
+    void set_commodity_in_db(const gnc_commodity* comm, bool in_db) noexcept;
     QofBook* book() const noexcept { return m_book; }
     void set_loading(bool loading) noexcept { m_loading = loading; }
     bool pristine() const noexcept { return m_is_pristine_db; }
+    /**
+     * Retrieve the copy of an object's slots taken when its edit began.
+     *
+     * @param guid The object's GncGUID
+     * @return The slots as they were in the database, or nullptr if there
+     * is no copy.
+     */
+    KvpFrame* slots_snapshot(const GncGUID* guid) const noexcept;
+    /**
+     * Keep a copy of an object's slots, replacing any earlier copy.
+     *
+     * @param guid The object's GncGUID
+     * @param frame The copy, which the backend takes over; nullptr just
+     * drops the earlier copy.
+     */
+    void set_slots_snapshot(const GncGUID* guid, KvpFrame* frame) noexcept;
     void update_progress(double pct) const noexcept;
     void finish_progress() const noexcept;
 
 protected:
+    /**
+     * Called during an initial load once the book itself, with its
+     * options, is in and before anything else is loaded.
+     *
+     * @param book The book being loaded
+     */
+    virtual void book_loaded(QofBook* book) {}
     GncSqlConnection* m_conn = nullptr;  /**< SQL connection */
     QofBook* m_book = nullptr;           /**< The primary, main open book */
     bool m_loading;        /**< We are performing an initial load */
     bool m_in_query;       /**< We are processing a query */
     bool m_is_pristine_db; /**< Are we saving to a new pristine db? */
+    bool m_in_batch = false; /**< A begin_batch() transaction is open */
+    bool m_transactions_loaded = false; /**< All transactions are in the book */
     const char* m_time_format = nullptr; /**< Server-specific date-time string format */
     VersionVec m_versions;    /**< Version number for each table */
 private:
+    bool take_write_behind_error() noexcept;
+    void drop_slots_snapshots(QofInstance* inst) noexcept;
     bool write_account_tree(Account*);
     bool write_accounts();
     bool write_transactions();
@@ -288,6 +358,15 @@ private:
     };
     ObjectBackendRegistry m_backend_registry;
     std::vector<gnc_commodity*> m_postload_commodities;
+    std::unique_ptr<GncSqlWriteQueue> m_write_queue; /**< Write-behind queue, if on */
+    /** A queued write failed, so the database is missing changes that the
+     * book has; the next sync() has to rewrite it all. */
+    bool m_write_behind_failed = false;
+    /** Slots of the objects being edited, keyed by guid string. */
+    std::unordered_map<std::string, std::shared_ptr<KvpFrame>> m_slots_snapshots;
+    /** Commodities loaded from or written to the database this session,
+     * keyed by guid string. */
+    std::unordered_set<std::string> m_commodities_in_db;
 };
 
 #endif //__GNC_SQL_BACKEND_HPP__
@@ -97,6 +97,16 @@ public:
                            bool retry) noexcept = 0;
     virtual bool verify() noexcept = 0;
     virtual bool retry_connection(const char* msg) noexcept = 0;
+    /** While errors are held the connection keeps the errors it would set
+     * on its backend instead, so that it can be used from a thread other
+     * than the backend's; see GncSqlWriteQueue.
+     */
+    virtual void hold_errors(bool hold) noexcept {}
+    /** Return the first error kept while errors were held, and clear it. */
+    virtual QofBackendError take_held_error() noexcept
+    {
+        return ERR_BACKEND_NO_ERR;
+    }
 
 };
 
@@ -0,0 +1,166 @@
+/***********************************************************************\
+ * gnc-sql-write-queue.cpp: Write-behind queue for the SQL backend     *
+ *                                                                     *
+ * This program is free software; you can redistribute it and/or       *
+ * modify it under the terms of the GNU General Public License as      *
+ * published by the Free Software Foundation; either version 2 of      *
+ * the License, or (at your option) any later version.                 *
+ *                                                                     *
+ * This program is distributed in the hope that it will be useful,     *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of      *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the       *
+ * GNU General Public License for more details.                        *
+ *                                                                     *
+ * You should have received a copy of the GNU General Public License   *
+ * along with this program; if not, contact:                           *
+ *                                                                     *
+ * Free Software Foundation           Voice:  +1-617-542-5942          *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652          *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                      *
+\***********************************************************************/
+extern "C"
+{
+#include <config.h>
+#include <glib.h>
+}
+
+#include "gnc-sql-connection.hpp"
+#include "gnc-sql-write-queue.hpp"
+
+static QofLogModule log_module = G_LOG_DOMAIN;
+
+GncSqlWriteQueue::GncSqlWriteQueue(GncSqlConnection* conn) :
+    m_conn{conn}, m_worker{&GncSqlWriteQueue::run, this}
+{
+}
+
+GncSqlWriteQueue::~GncSqlWriteQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_stop = true;
+    }
+    m_work.notify_one();
+    m_worker.join();
+}
+
+void
+GncSqlWriteQueue::begin_group() noexcept
+{
+    m_group.clear();
+    m_collecting = true;
+}
+
+void
+GncSqlWriteQueue::add(std::string&& sql)
+{
+    m_group.push_back(std::move(sql));
+}
+
+void
+GncSqlWriteQueue::end_group(bool keep) noexcept
+{
+    m_collecting = false;
+    if (!keep || m_group.empty())
+    {
+        m_group.clear();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_queue.push_back(std::move(m_group));
+    }
+    m_group.clear();
+    m_work.notify_one();
+}
+
+void
+GncSqlWriteQueue::flush() noexcept
+{
+    QOF_STAT_SCOPED_TIMER ("backend.sql.write-behind.flush");
+    std::unique_lock<std::mutex> lock{m_mutex};
+    m_idle.wait(lock, [this]{ return m_queue.empty() && !m_busy; });
+}
+
+QofBackendError
+GncSqlWriteQueue::take_error() noexcept
+{
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto error = m_error;
+    m_error = ERR_BACKEND_NO_ERR;
+    return error;
+}
+
+void
+GncSqlWriteQueue::run() noexcept
+{
+    std::unique_lock<std::mutex> lock{m_mutex};
+    while (true)
+    {
+        m_work.wait(lock, [this]{ return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+            break;
+        std::deque<Group> groups;
+        groups.swap(m_queue);
+        /* Commits that follow a failed write may depend on it, so they're
+         * dropped until the error has been reported. */
+        if (m_error == ERR_BACKEND_NO_ERR)
+        {
+            m_busy = true;
+            lock.unlock();
+            auto error = write_held(groups);
+            lock.lock();
+            m_busy = false;
+            m_error = error;
+        }
+        if (m_queue.empty())
+            m_idle.notify_all();
+    }
+    m_idle.notify_all();
+}
+
+QofBackendError
+GncSqlWriteQueue::write_held(const std::deque<Group>& groups) noexcept
+{
+    QOF_STAT_SCOPED_TIMER ("backend.sql.write-behind.write");
+    QOF_STAT_COUNT ("backend.sql.write-behind.transaction");
+    /* The backend's error belongs to its own thread. */
+    m_conn->hold_errors (true);
+    auto ok = write (groups);
+    m_conn->hold_errors (false);
+    auto error = m_conn->take_held_error ();
+    if (ok)
+        return ERR_BACKEND_NO_ERR;
+    return error != ERR_BACKEND_NO_ERR ? error : ERR_BACKEND_SERVER_ERR;
+}
+
+bool
+GncSqlWriteQueue::write(const std::deque<Group>& groups) noexcept
+{
+    if (!m_conn->begin_transaction())
+    {
+        PERR ("begin_transaction failed\n");
+        return false;
+    }
+    for (const auto& group : groups)
+    {
+        for (const auto& sql : group)
+        {
+            auto stmt = m_conn->create_statement_from_sql(sql);
+            if (stmt == nullptr ||
+                m_conn->execute_nonselect_statement(stmt) == -1)
+            {
+                PERR ("SQL error: %s\n", sql.c_str());
+                (void)m_conn->rollback_transaction();
+                return false;
+            }
+        }
+    }
+    if (!m_conn->commit_transaction())
+    {
+        PERR ("commit_transaction failed\n");
+        (void)m_conn->rollback_transaction();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,102 @@
+/***********************************************************************\
+ * gnc-sql-write-queue.hpp: Write-behind queue for the SQL backend     *
+ *                                                                     *
+ * This program is free software; you can redistribute it and/or       *
+ * modify it under the terms of the GNU General Public License as      *
+ * published by the Free Software Foundation; either version 2 of      *
+ * the License, or (at your option) any later version.                 *
+ *                                                                     *
+ * This program is distributed in the hope that it will be useful,     *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of      *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the       *
+ * GNU General Public License for more details.                        *
+ *                                                                     *
+ * You should have received a copy of the GNU General Public License   *
+ * along with this program; if not, contact:                           *
+ *                                                                     *
+ * Free Software Foundation           Voice:  +1-617-542-5942          *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652          *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                      *
+\***********************************************************************/
+
+#ifndef __GNC_SQL_WRITE_QUEUE_HPP__
+#define __GNC_SQL_WRITE_QUEUE_HPP__
+
+extern "C"
+{
+#include <qof.h>
+}
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class GncSqlConnection;
+
+/**
+ * Ordered queue of the SQL written by object commits, drained into the
+ * database by a worker thread.
+ *
+ * The statements of one commit are collected between begin_group() and
+ * end_group() and queued together once the commit has succeeded. The
+ * worker writes everything queued since its last pass inside one database
+ * transaction, so a run of commits costs one round trip per statement but
+ * only one BEGIN/COMMIT pair.
+ *
+ * The worker is the only user of the connection while there is anything
+ * queued; callers must flush() before using the connection themselves.
+ * The connection holds its errors while the worker uses it, so that the
+ * backend is only touched from its own thread. If a write fails the worker
+ * rolls its transaction back, drops whatever is still queued and keeps the
+ * error for take_error(); the caller must then arrange for the dropped
+ * changes to be written another way.
+ */
+class GncSqlWriteQueue
+{
+public:
+    GncSqlWriteQueue(GncSqlConnection* conn);
+    /** Writes whatever is still queued before stopping the worker. */
+    ~GncSqlWriteQueue();
+    GncSqlWriteQueue(const GncSqlWriteQueue&) = delete;
+    GncSqlWriteQueue& operator=(const GncSqlWriteQueue&) = delete;
+
+    /** Start collecting the statements of one commit. */
+    void begin_group() noexcept;
+    /** True between begin_group() and end_group(). */
+    bool collecting() const noexcept { return m_collecting; }
+    /** Add a statement to the group being collected. */
+    void add(std::string&& sql);
+    /**
+     * Finish the group being collected.
+     *
+     * @param keep Queue the group's statements if true, discard them if
+     * false.
+     */
+    void end_group(bool keep) noexcept;
+    /** Wait until everything queued has been written or dropped. */
+    void flush() noexcept;
+    /** Return the error from a failed write, if any, and clear it. */
+    QofBackendError take_error() noexcept;
+
+private:
+    using Group = std::vector<std::string>;
+    void run() noexcept;
+    QofBackendError write_held(const std::deque<Group>& groups) noexcept;
+    bool write(const std::deque<Group>& groups) noexcept;
+
+    GncSqlConnection* m_conn;
+    Group m_group;             /**< The commit being collected */
+    bool m_collecting = false;
+    std::mutex m_mutex;        /**< Guards the members below */
+    std::condition_variable m_work;
+    std::condition_variable m_idle;
+    std::deque<Group> m_queue;
+    bool m_busy = false;       /**< The worker is writing */
+    bool m_stop = false;
+    QofBackendError m_error = ERR_BACKEND_NO_ERR;
+    std::thread m_worker;
+};
+
+#endif //__GNC_SQL_WRITE_QUEUE_HPP__
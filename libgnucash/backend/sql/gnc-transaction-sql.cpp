@@ -705,6 +705,82 @@ void gnc_sql_transaction_load_tx_for_account (GncSqlBackend* sql_be,
     query_transactions (sql_be, sql);
 }
 
+/* Read an integer aggregate, which some databases return as a decimal
+ * string rather than as an integer. */
+static int64_t
+get_aggregate_int (const GncSqlRow& row, const char* col)
+{
+    try
+    {
+        return row.get_int_at_col (col);
+    }
+    catch (std::invalid_argument&)
+    {
+        return std::stoll (row.get_string_at_col (col));
+    }
+}
+
+bool
+gnc_sql_transaction_sum_amounts (GncSqlBackend* sql_be, const Account* account,
+                                 time64 start, time64 end, gnc_numeric& total)
+{
+    g_return_val_if_fail (sql_be != NULL, false);
+    g_return_val_if_fail (account != NULL, false);
+
+    auto guid = qof_instance_get_guid (QOF_INSTANCE (account));
+    const std::string tpkey(tx_col_table[0]->name());    //guid
+    const std::string pdkey(tx_col_table[3]->name());    //post_date
+    const std::string stkey(split_col_table[1]->name()); //tx_guid
+    const std::string sakey(split_col_table[2]->name()); //account_guid
+    const std::string sqkey(split_col_table[8]->name()); //quantity
+    /* Integer sums are exact, so the amounts are summed per denominator in
+     * the database and only the per-denominator totals are added here. */
+    std::string sql("SELECT s." + sqkey + "_denom AS amount_denom, SUM(s." +
+                    sqkey + "_num) AS amount_num FROM " SPLIT_TABLE " s, "
+                    TRANSACTION_TABLE " t WHERE s." + stkey + " = t." + tpkey +
+                    " AND s." + sakey + " = '" + gnc::GUID(*guid).to_string() +
+                    "'");
+    if (start > MINTIME)
+        sql += " AND t." + pdkey + " >= '" +
+            GncDateTime(start).format_iso8601() + "'";
+    if (end < MAXTIME)
+        sql += " AND t." + pdkey + " < '" +
+            GncDateTime(end).format_iso8601() + "'";
+    sql += " GROUP BY s." + sqkey + "_denom";
+
+    QOF_STAT_SCOPED_TIMER ("backend.sql.sum-amounts");
+    auto stmt = sql_be->create_statement_from_sql (sql);
+    auto result = sql_be->execute_select_statement (stmt);
+    if (result == nullptr)
+        return false;
+
+    auto sum = gnc_numeric_zero ();
+    try
+    {
+        for (auto row : *result)
+        {
+            auto denom = get_aggregate_int (row, "amount_denom");
+            auto num = get_aggregate_int (row, "amount_num");
+            sum = gnc_numeric_add (sum, gnc_numeric_create (num, denom),
+                                   GNC_DENOM_AUTO,
+                                   GNC_HOW_DENOM_LCD | GNC_HOW_RND_NEVER);
+        }
+    }
+    catch (std::exception& err)
+    {
+        PERR ("Unable to read split totals: %s", err.what ());
+        return false;
+    }
+    if (gnc_numeric_check (sum) != GNC_ERROR_OK)
+    {
+        PWARN ("Split totals for account %s overflow",
+               xaccAccountGetName (account));
+        return false;
+    }
+    total = sum;
+    return true;
+}
+
 /**
  * Loads all transactions.  This might be used during a save-as operation to ensure that
  * all data is in memory and ready to be saved.
@@ -720,6 +796,7 @@ GncSqlTransBackend::load_all (GncSqlBackend* sql_be)
     gnc_account_foreach_descendant(root, (AccountCb)xaccAccountBeginEdit,
                                    nullptr);
     query_transactions (sql_be, "");
+    gnc_book_finalize_load (sql_be->book());
     gnc_account_foreach_descendant(root, (AccountCb)xaccAccountCommitEdit,
                                    nullptr);
 }
@@ -61,6 +61,21 @@ public:
  */
 void gnc_sql_transaction_load_tx_for_account (GncSqlBackend* sql_be,
                                               Account* account);
+/**
+ * Sums, in the database, the amounts of an account's splits in transactions
+ * posted at or after start and before end. The sum is exact.
+ *
+ * @param sql_be SQL backend
+ * @param account Account
+ * @param start Start of the period, or INT64_MIN for none
+ * @param end End of the period, or INT64_MAX for none
+ * @param total Set to the sum on success
+ * @return false if the sum couldn't be computed
+ */
+bool gnc_sql_transaction_sum_amounts (GncSqlBackend* sql_be,
+                                      const Account* account,
+                                      time64 start, time64 end,
+                                      gnc_numeric& total);
 typedef struct
 {
     Account* acct;
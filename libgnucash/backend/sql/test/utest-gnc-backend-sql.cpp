@@ -26,7 +26,10 @@ extern "C"
 #include <string.h>
 #include <glib.h>
 #include <unittest-support.h>
+#include <gnc-commodity.h>
+#include <Transaction.h>
 }
+#include <atomic>
 /* Add specific headers for this class */
 #include "../gnc-sql-connection.hpp"
 #include "../gnc-sql-backend.hpp"
@@ -244,10 +247,55 @@ test_gnc_sql_begin_edit (Fixture *fixture, gconstpointer pData)
 /* gnc_sql_rollback_edit
 void
 gnc_sql_rollback_edit (GncSqlBackend *sql_be, QofInstance *inst)// C: 1 */
-/* static void
-test_gnc_sql_rollback_edit (Fixture *fixture, gconstpointer pData)
+static void
+test_gnc_sql_rollback_edit (void)
 {
-}*/
+    GncMockSqlConnection conn;
+
+    qof_object_initialize ();
+    auto book = qof_book_new();
+    auto sql_be = new GncMockSqlBackend (&conn, book);
+    auto currency = gnc_commodity_new (book, "US Dollar",
+                                       GNC_COMMODITY_NS_CURRENCY, "USD",
+                                       "840", 100);
+    auto trans = xaccMallocTransaction (book);
+    auto split = xaccMallocSplit (book);
+    xaccTransBeginEdit (trans);
+    xaccTransSetCurrency (trans, currency);
+    xaccSplitSetParent (split, trans);
+
+    /* Only objects already in the database get their slots noted. */
+    qof_book_set_backend (book, sql_be);
+    for (auto inst : {QOF_INSTANCE (trans), QOF_INSTANCE (split)})
+    {
+        qof_instance_set_dirty_flag (inst, FALSE);
+        qof_commit_edit_part2 (inst, nullptr, nullptr, nullptr);
+        g_assert (!qof_instance_get_infant (inst));
+    }
+    auto trans_guid = qof_instance_get_guid (trans);
+    auto split_guid = qof_instance_get_guid (split);
+
+    /* Neither a rolled back edit nor one that changed nothing may leave
+     * the copies of the splits' slots behind. */
+    sql_be->begin (QOF_INSTANCE (trans));
+    g_assert (sql_be->slots_snapshot (trans_guid) != nullptr);
+    g_assert (sql_be->slots_snapshot (split_guid) != nullptr);
+    sql_be->rollback (QOF_INSTANCE (trans));
+    g_assert (sql_be->slots_snapshot (trans_guid) == nullptr);
+    g_assert (sql_be->slots_snapshot (split_guid) == nullptr);
+
+    sql_be->begin (QOF_INSTANCE (trans));
+    g_assert (sql_be->slots_snapshot (split_guid) != nullptr);
+    sql_be->commit (QOF_INSTANCE (trans));
+    g_assert (sql_be->slots_snapshot (trans_guid) == nullptr);
+    g_assert (sql_be->slots_snapshot (split_guid) == nullptr);
+
+    qof_book_set_backend (book, nullptr);
+    xaccTransDestroy (trans);
+    xaccTransCommitEdit (trans);
+    g_object_unref (book);
+    delete sql_be;
+}
 /* commit_cb
 static void
 commit_cb (const gchar* type, gpointer data_p, gpointer be_data_p)// 2
@@ -337,6 +385,184 @@ test_gnc_sql_commit_edit (void)
     g_object_unref (book);
     delete sql_be;
 }
+/* A connection that takes a while over each statement, as a database
+ * server across a network would. */
+class GncSlowSqlConnection : public GncMockSqlConnection
+{
+public:
+    GncSlowSqlConnection(gulong latency) : m_latency{latency} {}
+    GncSqlResultPtr execute_select_statement (const GncSqlStatementPtr& stmt)
+        noexcept override
+    {
+        g_usleep (m_latency);
+        ++m_selects;
+        return GncMockSqlConnection::execute_select_statement (stmt);
+    }
+    int execute_nonselect_statement (const GncSqlStatementPtr&)
+        noexcept override
+    {
+        g_usleep (m_latency);
+        ++m_executed;
+        if (!m_fail)
+            return 1;
+        if (m_hold_errors)
+            m_held_error = ERR_BACKEND_CONN_LOST;
+        else
+            ++m_unheld_errors;
+        return -1;
+    }
+    bool begin_transaction () noexcept override
+    {
+        g_usleep (m_latency);
+        ++m_transactions;
+        return true;
+    }
+    bool commit_transaction () noexcept override
+    {
+        g_usleep (m_latency);
+        return true;
+    }
+    void hold_errors (bool hold) noexcept override { m_hold_errors = hold; }
+    QofBackendError take_held_error () noexcept override
+    {
+        auto error = m_held_error;
+        m_held_error = ERR_BACKEND_NO_ERR;
+        return error;
+    }
+    void fail (bool fail) { m_fail = fail; }
+    unsigned unheld_errors () const { return m_unheld_errors; }
+    unsigned executed () const { return m_executed; }
+    unsigned transactions () const { return m_transactions; }
+    unsigned selects () const { return m_selects; }
+private:
+    gulong m_latency;
+    unsigned m_selects = 0;
+    std::atomic<unsigned> m_executed{0};
+    std::atomic<unsigned> m_transactions{0};
+    std::atomic<bool> m_fail{false};
+    bool m_hold_errors = false;
+    QofBackendError m_held_error = ERR_BACKEND_NO_ERR;
+    std::atomic<unsigned> m_unheld_errors{0};
+};
+
+static gint64
+commit_book (GncSqlBackend* sql_be, QofBook* book, int count)
+{
+    auto start = g_get_monotonic_time ();
+    for (int i = 0; i < count; ++i)
+    {
+        qof_instance_set_dirty_flag (QOF_INSTANCE (book), TRUE);
+        sql_be->commit (QOF_INSTANCE (book));
+        g_assert (!qof_instance_get_dirty_flag (QOF_INSTANCE (book)));
+    }
+    return g_get_monotonic_time () - start;
+}
+
+static void
+test_gnc_sql_write_behind (void)
+{
+    const gulong latency = 20000;
+    const int commits = 10;
+    GncSlowSqlConnection conn {latency};
+    const char* msg1 = "[GncSqlWriteQueue::write()] SQL error: SELECT * FROM foo\n";
+    GLogLevelFlags loglevel = static_cast<decltype (loglevel)>
+                              (G_LOG_LEVEL_CRITICAL | G_LOG_FLAG_FATAL);
+    const char* logdomain = "gnc.backend.sql";
+    TestErrorStruct check1 = { loglevel, const_cast<char*> (logdomain),
+                               const_cast<char*> (msg1), 0
+                             };
+    test_add_error (&check1);
+    auto hdlr1 = g_log_set_handler (logdomain, loglevel,
+                                    (GLogFunc)test_list_handler, NULL);
+    g_test_log_set_fatal_handler ((GTestLogFatalFunc)test_list_handler, NULL);
+
+    qof_object_initialize ();
+    auto book = qof_book_new();
+    auto sql_be = new GncMockSqlBackend (&conn, book);
+
+    /* Each commit waits for its statements and its own transaction. */
+    auto sync_time = commit_book (sql_be, book, commits);
+    auto sync_executed = conn.executed ();
+    g_assert_cmpuint (sync_executed, >=, commits);
+    g_assert_cmpuint (conn.transactions (), ==, commits);
+    g_assert_cmpint (sync_time, >=, commits * latency);
+
+    /* Write-behind commits return at once and the same statements reach
+     * the database after a flush, in fewer transactions. */
+    sql_be->set_write_behind (true);
+    auto queued_time = commit_book (sql_be, book, commits);
+    g_test_message ("%d commits took %" G_GINT64_FORMAT "us synchronously, "
+                    "%" G_GINT64_FORMAT "us with write-behind",
+                    commits, sync_time, queued_time);
+    g_assert_cmpint (queued_time, <, sync_time / 2);
+    sql_be->flush ();
+    g_assert_cmpuint (conn.executed (), ==, 2 * sync_executed);
+    g_assert_cmpuint (conn.transactions (), <, 2 * commits);
+    g_assert_cmpint (sql_be->get_error (), ==, ERR_BACKEND_NO_ERR);
+
+    /* A failed write is reported once everything has been written, with
+     * the error the connection held rather than set from the worker, and
+     * leaves the book to be saved again. */
+    qof_book_mark_session_saved (book);
+    conn.fail (true);
+    commit_book (sql_be, book, 1);
+    sql_be->flush ();
+    g_assert_cmpint (sql_be->get_error (), ==, ERR_BACKEND_CONN_LOST);
+    g_assert_cmpuint (conn.unheld_errors (), ==, 0);
+    g_assert (qof_book_session_not_saved (book));
+    g_assert_cmpint (check1.hits, ==, 2);
+
+    conn.fail (false);
+    auto executed = conn.executed ();
+    commit_book (sql_be, book, 1);
+    sql_be->set_write_behind (false);
+    g_assert_cmpuint (conn.executed (), >, executed);
+    g_assert_cmpint (sql_be->get_error (), ==, ERR_BACKEND_NO_ERR);
+
+    g_log_remove_handler (logdomain, hdlr1);
+    test_clear_error_list ();
+    g_object_unref (book);
+    delete sql_be;
+}
+static void
+test_gnc_sql_write_behind_currency (void)
+{
+    const gulong latency = 20000;
+    const int commits = 10;
+    GncSlowSqlConnection conn {latency};
+
+    qof_object_initialize ();
+    auto book = qof_book_new();
+    auto sql_be = new GncMockSqlBackend (&conn, book);
+    auto currency = gnc_commodity_new (book, "US Dollar",
+                                       GNC_COMMODITY_NS_CURRENCY, "USD",
+                                       "840", 100);
+    auto trans = xaccMallocTransaction (book);
+    xaccTransBeginEdit (trans);
+    xaccTransSetCurrency (trans, currency);
+
+    /* Only the first commit asks the database for the currency; the
+     * others mustn't wait for the queued writes to get there. */
+    sql_be->set_write_behind (true);
+    auto start = g_get_monotonic_time ();
+    for (int i = 0; i < commits; ++i)
+    {
+        qof_instance_set_dirty_flag (QOF_INSTANCE (trans), TRUE);
+        sql_be->commit (QOF_INSTANCE (trans));
+        g_assert (!qof_instance_get_dirty_flag (QOF_INSTANCE (trans)));
+    }
+    auto queued_time = g_get_monotonic_time () - start;
+    g_assert_cmpuint (conn.selects (), ==, 1);
+    g_assert_cmpint (queued_time, <, commits * latency / 2);
+    sql_be->set_write_behind (false);
+    g_assert_cmpuint (conn.executed (), >=, commits);
+    g_assert_cmpint (sql_be->get_error (), ==, ERR_BACKEND_NO_ERR);
+
+    xaccTransDestroy (trans);
+    xaccTransCommitEdit (trans);
+    g_object_unref (book);
+    delete sql_be;
+}
 /* handle_and_term
 static void
 handle_and_term (QofQueryTerm* pTerm, GString* sql)// 2
@@ -854,9 +1080,11 @@ test_suite_gnc_backend_sql (void)
 // GNC_TEST_ADD (suitename, "finish progress", Fixture, nullptr, test_finish_progress,  teardown);
 // GNC_TEST_ADD (suitename, "gnc sql sync all", Fixture, nullptr, test_gnc_sql_sync_all,  teardown);
 // GNC_TEST_ADD (suitename, "gnc sql begin edit", Fixture, nullptr, test_gnc_sql_begin_edit,  teardown);
-// GNC_TEST_ADD (suitename, "gnc sql rollback edit", Fixture, nullptr, test_gnc_sql_rollback_edit,  teardown);
+    GNC_TEST_ADD_FUNC (suitename, "gnc sql rollback edit", test_gnc_sql_rollback_edit);
 // GNC_TEST_ADD (suitename, "commit cb", Fixture, nullptr, test_commit_cb,  teardown);
     GNC_TEST_ADD_FUNC (suitename, "gnc sql commit edit", test_gnc_sql_commit_edit);
+    GNC_TEST_ADD_FUNC (suitename, "gnc sql write behind", test_gnc_sql_write_behind);
+    GNC_TEST_ADD_FUNC (suitename, "gnc sql write behind currency", test_gnc_sql_write_behind_currency);
 // GNC_TEST_ADD (suitename, "handle and term", Fixture, nullptr, test_handle_and_term,  teardown);
 // GNC_TEST_ADD (suitename, "compile query cb", Fixture, nullptr, test_compile_query_cb,  teardown);
 // GNC_TEST_ADD (suitename, "gnc sql compile query", Fixture, nullptr, test_gnc_sql_compile_query,  teardown);
@@ -33,6 +33,8 @@ extern "C"
 #include <Account.h>
 }
 
+#include <qofinstance-p.h>
+
 #include "gnc-xml-helper.h"
 #include "sixtp.h"
 #include "sixtp-utils.h"
@@ -40,6 +42,7 @@ extern "C"
 #include "sixtp-utils.h"
 #include "sixtp-dom-parsers.h"
 #include "sixtp-dom-generators.h"
+#include "sixtp-stream-writer.hpp"
 
 #include "gnc-xml.h"
 #include "io-gncxml-gen.h"
@@ -166,6 +169,71 @@ gnc_account_dom_tree_create (Account* act,
     return ret;
 }
 
+/* The same as gnc_account_dom_tree_create, written straight to
+   @a writer. */
+void
+gnc_account_write_xml (SixtpStreamWriter& writer, Account* act,
+                       gboolean exporting, gboolean allow_incompat)
+{
+    const char* str;
+    GList* lots;
+    Account* parent;
+    gnc_commodity* acct_commodity;
+
+    ENTER ("(account=%p)", act);
+
+    writer.start_element (gnc_account_string);
+    writer.attribute ("version", account_version_string);
+
+    writer.content_element (act_name_string, xaccAccountGetName (act));
+    writer.guid_element (act_id_string, xaccAccountGetGUID (act));
+    writer.content_element (act_type_string,
+                            xaccAccountTypeEnumAsString (xaccAccountGetType (act)));
+
+    acct_commodity = xaccAccountGetCommodity (act);
+    if (acct_commodity != NULL)
+    {
+        writer.commodity_ref_element (act_commodity_string, acct_commodity);
+        writer.int_element (act_commodity_scu_string,
+                            xaccAccountGetCommoditySCUi (act));
+        if (xaccAccountGetNonStdSCU (act))
+        {
+            writer.start_element (act_non_standard_scu_string);
+            writer.end_element ();
+        }
+    }
+
+    str = xaccAccountGetCode (act);
+    if (str && strlen (str) > 0)
+        writer.content_element (act_code_string, str);
+
+    str = xaccAccountGetDescription (act);
+    if (str && strlen (str) > 0)
+        writer.content_element (act_description_string, str);
+
+    writer.slots_element (act_slots_string, QOF_INSTANCE (act));
+
+    parent = gnc_account_get_parent (act);
+    if (parent)
+    {
+        if (!gnc_account_is_root (parent) || allow_incompat)
+            writer.guid_element (act_parent_string, xaccAccountGetGUID (parent));
+    }
+
+    lots = xaccAccountGetLotList (act);
+    if (lots && !exporting)
+    {
+        writer.start_element (act_lots_string);
+        lots = g_list_sort (lots, qof_instance_guid_compare);
+        for (auto n = lots; n; n = n->next)
+            gnc_lot_write_xml (writer, static_cast<GNCLot*> (n->data));
+        writer.end_element ();
+    }
+    g_list_free (lots);
+
+    LEAVE ("");
+}
+
 /***********************************************************************/
 
 struct account_pdata
@@ -552,6 +620,55 @@ dom_tree_to_account (xmlNodePtr node, QofBook* book)
     return accToRet;
 }
 
+/* Apply an account element to @a book.  An account that already exists is
+ * updated in place, so that its splits, lots and children stay attached;
+ * the element replaces its slots, code and description wholesale. */
+Account*
+dom_tree_update_account (xmlNodePtr node, QofBook* book)
+{
+    struct account_pdata act_pdata;
+    Account* acc = NULL;
+    xmlNodePtr mark;
+    gboolean successful;
+
+    for (mark = node->xmlChildrenNode; mark; mark = mark->next)
+    {
+        if (g_strcmp0 (act_id_string, (char*) mark->name) == 0)
+        {
+            GncGUID* guid = dom_tree_to_guid (mark);
+            if (guid)
+            {
+                acc = xaccAccountLookup (guid, book);
+                guid_free (guid);
+            }
+            break;
+        }
+    }
+
+    if (!acc)
+        return dom_tree_to_account (node, book);
+
+    xaccAccountBeginEdit (acc);
+    qof_instance_set_slots (QOF_INSTANCE (acc), new KvpFrame);
+    xaccAccountSetCode (acc, "");
+    xaccAccountSetDescription (acc, "");
+    xaccAccountSetNonStdSCU (acc, FALSE);
+
+    act_pdata.account = acc;
+    act_pdata.book = book;
+
+    successful = dom_tree_generic_parse (node, account_handlers_v2,
+                                         &act_pdata);
+    xaccAccountCommitEdit (acc);
+    if (!successful)
+    {
+        PERR ("failed to parse account tree");
+        return NULL;
+    }
+
+    return acc;
+}
+
 sixtp*
 gnc_account_sixtp_parser_create (void)
 {
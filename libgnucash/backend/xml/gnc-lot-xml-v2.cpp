@@ -40,6 +40,7 @@ extern "C"
 #include "sixtp-utils.h"
 #include "sixtp-dom-parsers.h"
 #include "sixtp-dom-generators.h"
+#include "sixtp-stream-writer.hpp"
 
 #include "gnc-xml.h"
 #include "io-gncxml-gen.h"
@@ -73,6 +74,18 @@ gnc_lot_dom_tree_create (GNCLot* lot)
     return ret;
 }
 
+void
+gnc_lot_write_xml (SixtpStreamWriter& writer, GNCLot* lot)
+{
+    ENTER ("(lot=%p)", lot);
+    writer.start_element (gnc_lot_string);
+    writer.attribute ("version", lot_version_string);
+    writer.guid_element (lot_id_string, gnc_lot_get_guid (lot));
+    writer.slots_element (lot_slots_string, QOF_INSTANCE (lot));
+    writer.end_element ();
+    LEAVE ("");
+}
+
 /* =================================================================== */
 
 struct lot_pdata
@@ -35,6 +35,7 @@ extern "C"
 #include "sixtp-parsers.h"
 #include "sixtp-dom-parsers.h"
 #include "sixtp-dom-generators.h"
+#include "sixtp-stream-parser.hpp"
 #include "io-gncxml-gen.h"
 #include "io-gncxml-v2.h"
 
@@ -78,7 +79,8 @@ static QofLogModule log_module = GNC_MOD_IO;
 /****************************************************************************/
 /* <price>
 
-  restores a price.  Does so via a walk of the XML tree in memory.
+  restores a price.  Does so straight from the SAX events, see
+  sixtp-stream-parser.hpp.
   Returns a GNCPrice * in result.
 
   Right now, a price is legitimate even if all of it's fields are not
@@ -86,156 +88,238 @@ static QofLogModule log_module = GNC_MOD_IO;
 
 */
 
-static gboolean
-price_parse_xml_sub_node (GNCPrice* p, xmlNodePtr sub_node, QofBook* book)
+static void
+cleanup_gnc_price (sixtp_child_result* result)
 {
-    if (!p || !sub_node) return FALSE;
+    if (result->data) gnc_price_unref ((GNCPrice*) result->data);
+}
 
-    gnc_price_begin_edit (p);
-    if (g_strcmp0 ("price:id", (char*)sub_node->name) == 0)
-    {
-        GncGUID* c = dom_tree_to_guid (sub_node);
-        if (!c) return FALSE;
-        gnc_price_set_guid (p, c);
-        guid_free (c);
-    }
-    else if (g_strcmp0 ("price:commodity", (char*)sub_node->name) == 0)
-    {
-        gnc_commodity* c = dom_tree_to_commodity_ref (sub_node, book);
-        if (!c) return FALSE;
-        gnc_price_set_commodity (p, c);
-    }
-    else if (g_strcmp0 ("price:currency", (char*)sub_node->name) == 0)
-    {
-        gnc_commodity* c = dom_tree_to_commodity_ref (sub_node, book);
-        if (!c) return FALSE;
-        gnc_price_set_currency (p, c);
-    }
-    else if (g_strcmp0 ("price:time", (char*)sub_node->name) == 0)
-    {
-        time64 time = dom_tree_to_time64 (sub_node);
-        if (!dom_tree_valid_time64 (time, sub_node->name)) time = 0;
-        gnc_price_set_time64 (p, time);
-    }
-    else if (g_strcmp0 ("price:source", (char*)sub_node->name) == 0)
+static constexpr guint32 price_id_hash = sixtp_tag_hash ("price:id");
+static constexpr guint32 price_commodity_hash = sixtp_tag_hash ("price:commodity");
+static constexpr guint32 price_currency_hash = sixtp_tag_hash ("price:currency");
+static constexpr guint32 price_time_hash = sixtp_tag_hash ("price:time");
+static constexpr guint32 price_source_hash = sixtp_tag_hash ("price:source");
+static constexpr guint32 price_type_hash = sixtp_tag_hash ("price:type");
+static constexpr guint32 price_value_hash = sixtp_tag_hash ("price:value");
+static constexpr guint32 price_cmdty_space_hash = sixtp_tag_hash ("cmdty:space");
+static constexpr guint32 price_cmdty_id_hash = sixtp_tag_hash ("cmdty:id");
+static constexpr guint32 price_ts_date_hash = sixtp_tag_hash ("ts:date");
+
+static const SixtpTagTable price_stream_tags
+{
+    "price:id", "price:commodity", "price:currency", "price:time",
+    "price:source", "price:type", "price:value", "cmdty:space", "cmdty:id",
+    "ts:date",
+};
+
+class PriceStreamHandler : public SixtpStreamHandler
+{
+public:
+    explicit PriceStreamHandler (QofBook* book) :
+        SixtpStreamHandler{price_stream_tags}, m_book{book}, m_price{gnc_price_create (book)}
     {
-        char* text = dom_tree_to_text (sub_node);
-        if (!text) return FALSE;
-        gnc_price_set_source_string (p, text);
-        g_free (text);
+        gnc_price_begin_edit (m_price);
     }
-    else if (g_strcmp0 ("price:type", (char*)sub_node->name) == 0)
+    ~PriceStreamHandler ()
     {
-        char* text = dom_tree_to_text (sub_node);
-        if (!text) return FALSE;
-        gnc_price_set_typestr (p, text);
-        g_free (text);
+        if (m_price)
+        {
+            gnc_price_commit_edit (m_price);
+            gnc_price_unref (m_price);
+        }
     }
-    else if (g_strcmp0 ("price:value", (char*)sub_node->name) == 0)
+    bool start_element (guint depth, guint32 hash, const gchar* tag,
+                        const gchar** attrs) override;
+    bool end_element (guint depth, guint32 hash, const gchar* tag,
+                      const std::string& text) override;
+    bool finish (gpointer global_data, gpointer* result,
+                 const gchar* tag) override;
+
+private:
+    gnc_commodity* lookup_commodity ();
+
+    QofBook* m_book;
+    GNCPrice* m_price;
+    bool m_ok = true;
+    bool m_children = false;
+    bool m_guid_ok = false;
+    std::string m_cmdty_space;
+    std::string m_cmdty_id;
+    int m_cmdty_parts = 0;
+    int m_dates = 0;
+    time64 m_date = INT64_MAX;
+};
+
+bool
+PriceStreamHandler::start_element (guint depth, guint32 hash, const gchar* tag,
+                                   const gchar** attrs)
+{
+    if (depth != 1)
+        return true;
+
+    m_children = true;
+    switch (hash)
     {
-        gnc_numeric* value = dom_tree_to_gnc_numeric (sub_node);
-        if (!value) return FALSE;
-        gnc_price_set_value (p, *value);
-        g_free (value);
+    case price_id_hash:
+        m_guid_ok = sixtp_stream_guid_type_ok (attrs);
+        break;
+    case price_commodity_hash:
+    case price_currency_hash:
+        m_cmdty_parts = 0;
+        break;
+    case price_time_hash:
+        m_dates = 0;
+        m_date = INT64_MAX;
+        break;
+    default:
+        break;
     }
-    gnc_price_commit_edit (p);
-    return TRUE;
+    return true;
 }
 
-static gboolean
-price_parse_xml_end_handler (gpointer data_for_children,
-                             GSList* data_from_children,
-                             GSList* sibling_data,
-                             gpointer parent_data,
-                             gpointer global_data,
-                             gpointer* result,
-                             const gchar* tag)
+gnc_commodity*
+PriceStreamHandler::lookup_commodity ()
 {
-    gboolean ok = TRUE;
-    xmlNodePtr price_xml = (xmlNodePtr) data_for_children;
-    xmlNodePtr child;
-    GNCPrice* p = NULL;
-    gxpf_data* gdata = static_cast<decltype (gdata)> (global_data);
-    QofBook* book = static_cast<decltype (book)> (gdata->bookdata);
-
-    /* we haven't been handed the *top* level node yet... */
-    if (parent_data) return TRUE;
+    if (m_cmdty_parts != 2)
+        return NULL;
+    auto table = gnc_commodity_table_get_table (m_book);
+    g_return_val_if_fail (table != NULL, NULL);
+    auto ret = gnc_commodity_table_lookup (table, m_cmdty_space.c_str (),
+                                           m_cmdty_id.c_str ());
+    g_return_val_if_fail (ret != NULL, NULL);
+    return ret;
+}
 
-    *result = NULL;
+bool
+PriceStreamHandler::end_element (guint depth, guint32 hash, const gchar* tag,
+                                 const std::string& text)
+{
+    if (!m_ok)
+        return true;
 
-    if (!price_xml) return FALSE;
-    if (price_xml->next)
-    {
-        ok = FALSE;
-        goto cleanup_and_exit;
-    }
-    if (price_xml->prev)
+    if (depth == 2)
     {
-        ok = FALSE;
-        goto cleanup_and_exit;
-    }
-    if (!price_xml->xmlChildrenNode)
-    {
-        ok = FALSE;
-        goto cleanup_and_exit;
+        if (hash == price_cmdty_space_hash || hash == price_cmdty_id_hash)
+        {
+            auto& str = hash == price_cmdty_space_hash ? m_cmdty_space : m_cmdty_id;
+            auto begin = text.find_first_not_of (" \t\n\r");
+            auto end = text.find_last_not_of (" \t\n\r");
+            if (begin == std::string::npos)
+                str.clear ();
+            else
+                str.assign (text, begin, end - begin + 1);
+            ++m_cmdty_parts;
+        }
+        else if (hash == price_ts_date_hash)
+        {
+            /* Only one ts:date element is permitted, see dom_tree_to_time64. */
+            m_date = m_dates++ ? INT64_MAX
+                     : gnc_iso8601_to_time64_gmt (text.c_str ());
+        }
+        return true;
     }
 
-    p = gnc_price_create (book);
-    if (!p)
-    {
-        ok = FALSE;
-        goto cleanup_and_exit;
-    }
+    if (depth != 1)
+        return true;
 
-    for (child = price_xml->xmlChildrenNode; child; child = child->next)
+    switch (hash)
+    {
+    case price_id_hash:
     {
-        switch (child->type)
+        if (!m_guid_ok)
         {
-        case XML_COMMENT_NODE:
-        case XML_TEXT_NODE:
-            break;
-        case XML_ELEMENT_NODE:
-            if (!price_parse_xml_sub_node (p, child, book))
-            {
-                ok = FALSE;
-                goto cleanup_and_exit;
-            }
-            break;
-        default:
-            PERR ("Unknown node type (%d) while parsing gnc-price xml.", child->type);
-            child = NULL;
-            ok = FALSE;
-            goto cleanup_and_exit;
+            m_ok = false;
             break;
         }
+        auto guid = sixtp_stream_text_to_guid (text);
+        gnc_price_set_guid (m_price, &guid);
+        break;
     }
-
-cleanup_and_exit:
-    if (ok)
+    case price_commodity_hash:
+    case price_currency_hash:
     {
-        *result = p;
+        auto c = lookup_commodity ();
+        if (!c)
+            m_ok = false;
+        else if (hash == price_commodity_hash)
+            gnc_price_set_commodity (m_price, c);
+        else
+            gnc_price_set_currency (m_price, c);
+        break;
     }
-    else
+    case price_time_hash:
+    {
+        auto time = m_date;
+        if (!m_dates)
+            PERR ("no ts:date node found.");
+        if (!dom_tree_valid_time64 (time, BAD_CAST tag))
+            time = 0;
+        gnc_price_set_time64 (m_price, time);
+        break;
+    }
+    case price_source_hash:
+        gnc_price_set_source_string (m_price, text.c_str ());
+        break;
+    case price_type_hash:
+        gnc_price_set_typestr (m_price, text.c_str ());
+        break;
+    case price_value_hash:
+    {
+        gnc_numeric value;
+        if (!string_to_gnc_numeric (text.c_str (), &value))
+            value = gnc_numeric_zero ();
+        gnc_price_set_value (m_price, value);
+        break;
+    }
+    default:
+        break;
+    }
+    return true;
+}
+
+bool
+PriceStreamHandler::finish (gpointer global_data, gpointer* result,
+                            const gchar* tag)
+{
+    auto p = m_price;
+
+    m_price = nullptr;
+    gnc_price_commit_edit (p);
+    *result = NULL;
+    if (!m_ok || !m_children)
     {
-        *result = NULL;
         gnc_price_unref (p);
+        return false;
     }
-    xmlFreeNode (price_xml);
-    return ok;
+    *result = p;
+    return true;
 }
 
-static void
-cleanup_gnc_price (sixtp_child_result* result)
+static gboolean
+price_stream_start_handler (GSList* sibling_data,
+                            gpointer parent_data,
+                            gpointer global_data,
+                            gpointer* data_for_children,
+                            gpointer* result,
+                            const gchar* tag,
+                            gchar** attrs)
 {
-    if (result->data) gnc_price_unref ((GNCPrice*) result->data);
+    gxpf_data* gdata = static_cast<decltype (gdata)> (global_data);
+    QofBook* book = static_cast<decltype (book)> (gdata->bookdata);
+
+    if (!tag)
+        return TRUE;
+
+    *data_for_children = new PriceStreamHandler (book);
+    return TRUE;
 }
 
 static sixtp*
 gnc_price_parser_new (void)
 {
-    return sixtp_dom_parser_new (price_parse_xml_end_handler,
-                                 cleanup_gnc_price,
-                                 cleanup_gnc_price);
+    return sixtp_stream_parser_new (price_stream_start_handler,
+                                    cleanup_gnc_price,
+                                    cleanup_gnc_price);
 }
 
 
@@ -508,6 +592,12 @@ gnc_pricedb_to_dom_tree (const xmlChar* tag, GNCPriceDB* db)
     return db_xml;
 }
 
+xmlNodePtr
+gnc_price_dom_tree_create (GNCPrice* price)
+{
+    return gnc_price_to_dom_tree (BAD_CAST "price", price);
+}
+
 xmlNodePtr
 gnc_pricedb_dom_tree_create (GNCPriceDB* db)
 {
@@ -41,6 +41,8 @@ extern "C"
 #include "sixtp-utils.h"
 #include "sixtp-dom-parsers.h"
 #include "sixtp-dom-generators.h"
+#include "sixtp-stream-parser.hpp"
+#include "sixtp-stream-writer.hpp"
 
 #include "gnc-xml.h"
 
@@ -48,6 +50,8 @@ extern "C"
 
 #include "sixtp-dom-parsers.h"
 
+static QofLogModule log_module = GNC_MOD_IO;
+
 const gchar* transaction_version_string = "2.0.0";
 
 static void
@@ -192,6 +196,72 @@ gnc_transaction_dom_tree_create (Transaction* trn)
     return ret;
 }
 
+/* The same as gnc_transaction_dom_tree_create, written straight to
+   @a writer. */
+
+static void
+write_split (SixtpStreamWriter& writer, const gchar* tag, Split* spl)
+{
+    writer.start_element (tag);
+
+    writer.guid_element ("split:id", xaccSplitGetGUID (spl));
+
+    auto memo = xaccSplitGetMemo (spl);
+    if (memo && *memo)
+        writer.text_element ("split:memo", memo);
+
+    auto action = xaccSplitGetAction (spl);
+    if (action && *action)
+        writer.text_element ("split:action", action);
+
+    char tmp[2] = { xaccSplitGetReconcile (spl), '\0' };
+    writer.text_element ("split:reconciled-state", tmp);
+
+    if (auto time = xaccSplitGetDateReconciled (spl))
+        writer.time64_element ("split:reconcile-date", time);
+
+    writer.numeric_element ("split:value", xaccSplitGetValue (spl));
+    writer.numeric_element ("split:quantity", xaccSplitGetAmount (spl));
+    writer.guid_element ("split:account",
+                         xaccAccountGetGUID (xaccSplitGetAccount (spl)));
+
+    if (auto lot = xaccSplitGetLot (spl))
+        writer.guid_element ("split:lot", gnc_lot_get_guid (lot));
+
+    writer.slots_element ("split:slots", QOF_INSTANCE (spl));
+    writer.end_element ();
+}
+
+void
+gnc_transaction_write_xml (SixtpStreamWriter& writer, Transaction* trn)
+{
+    writer.start_element ("gnc:transaction");
+    writer.attribute ("version", transaction_version_string);
+
+    writer.guid_element ("trn:id", xaccTransGetGUID (trn));
+    writer.commodity_ref_element ("trn:currency", xaccTransGetCurrency (trn));
+
+    auto num = xaccTransGetNum (trn);
+    if (num && *num)
+        writer.text_element ("trn:num", num);
+
+    writer.time64_element ("trn:date-posted", xaccTransRetDatePosted (trn));
+    writer.time64_element ("trn:date-entered", xaccTransRetDateEntered (trn));
+
+    auto description = xaccTransGetDescription (trn);
+    if (description)
+        writer.text_element ("trn:description", description);
+
+    writer.slots_element ("trn:slots", QOF_INSTANCE (trn));
+
+    writer.start_element ("trn:splits");
+    for (auto n = xaccTransGetSplitList (trn); n; n = n->next)
+        write_split (writer, "trn:split", static_cast<Split*> (n->data));
+    writer.end_element ();
+
+    writer.end_element ();
+}
+
 /***********************************************************************/
 
 struct split_pdata
@@ -572,42 +642,6 @@ struct dom_tree_handler trn_dom_handlers[] =
     { NULL, NULL, 0, 0 },
 };
 
-static gboolean
-gnc_transaction_end_handler (gpointer data_for_children,
-                             GSList* data_from_children, GSList* sibling_data,
-                             gpointer parent_data, gpointer global_data,
-                             gpointer* result, const gchar* tag)
-{
-    Transaction* trn = NULL;
-    xmlNodePtr tree = (xmlNodePtr)data_for_children;
-    gxpf_data* gdata = (gxpf_data*)global_data;
-
-    if (parent_data)
-    {
-        return TRUE;
-    }
-
-    /* OK.  For some messed up reason this is getting called again with a
-       NULL tag.  So we ignore those cases */
-    if (!tag)
-    {
-        return TRUE;
-    }
-
-    g_return_val_if_fail (tree, FALSE);
-
-    trn = dom_tree_to_transaction (tree,
-                                   static_cast<QofBook*> (gdata->bookdata));
-    if (trn != NULL)
-    {
-        gdata->cb (tag, gdata->parsedata, trn);
-    }
-
-    xmlFreeNode (tree);
-
-    return trn != NULL;
-}
-
 Transaction*
 dom_tree_to_transaction (xmlNodePtr node, QofBook* book)
 {
@@ -641,8 +675,514 @@ dom_tree_to_transaction (xmlNodePtr node, QofBook* book)
     return trn;
 }
 
+/***********************************************************************/
+/* Streaming parser: the same as dom_tree_to_transaction and
+ * dom_tree_to_split above, but run on the SAX events so that loading a
+ * book doesn't create a DOM tree per transaction. Only the slots are
+ * still captured as DOM. */
+
+static constexpr guint32 trn_id_hash = sixtp_tag_hash ("trn:id");
+static constexpr guint32 trn_currency_hash = sixtp_tag_hash ("trn:currency");
+static constexpr guint32 trn_num_hash = sixtp_tag_hash ("trn:num");
+static constexpr guint32 trn_date_posted_hash = sixtp_tag_hash ("trn:date-posted");
+static constexpr guint32 trn_date_entered_hash = sixtp_tag_hash ("trn:date-entered");
+static constexpr guint32 trn_description_hash = sixtp_tag_hash ("trn:description");
+static constexpr guint32 trn_slots_hash = sixtp_tag_hash ("trn:slots");
+static constexpr guint32 trn_splits_hash = sixtp_tag_hash ("trn:splits");
+static constexpr guint32 trn_split_hash = sixtp_tag_hash ("trn:split");
+static constexpr guint32 spl_id_hash = sixtp_tag_hash ("split:id");
+static constexpr guint32 spl_memo_hash = sixtp_tag_hash ("split:memo");
+static constexpr guint32 spl_action_hash = sixtp_tag_hash ("split:action");
+static constexpr guint32 spl_reconciled_state_hash = sixtp_tag_hash ("split:reconciled-state");
+static constexpr guint32 spl_reconcile_date_hash = sixtp_tag_hash ("split:reconcile-date");
+static constexpr guint32 spl_value_hash = sixtp_tag_hash ("split:value");
+static constexpr guint32 spl_quantity_hash = sixtp_tag_hash ("split:quantity");
+static constexpr guint32 spl_account_hash = sixtp_tag_hash ("split:account");
+static constexpr guint32 spl_lot_hash = sixtp_tag_hash ("split:lot");
+static constexpr guint32 spl_slots_hash = sixtp_tag_hash ("split:slots");
+static constexpr guint32 cmdty_space_hash = sixtp_tag_hash ("cmdty:space");
+static constexpr guint32 cmdty_id_hash = sixtp_tag_hash ("cmdty:id");
+static constexpr guint32 ts_date_hash = sixtp_tag_hash ("ts:date");
+
+static const SixtpTagTable trn_stream_tags
+{
+    "trn:id", "trn:currency", "trn:num", "trn:date-posted",
+    "trn:date-entered", "trn:description", "trn:slots", "trn:splits",
+    "trn:split", "split:id", "split:memo", "split:action",
+    "split:reconciled-state", "split:reconcile-date", "split:value",
+    "split:quantity", "split:account", "split:lot", "split:slots",
+    "cmdty:space", "cmdty:id", "ts:date",
+};
+
+/* Bits for the required elements, cf. the dom_tree_handler tables. */
+enum
+{
+    TRN_GOT_ID = 1 << 0,
+    TRN_GOT_DATE_POSTED = 1 << 1,
+    TRN_GOT_DATE_ENTERED = 1 << 2,
+    TRN_GOT_SPLITS = 1 << 3,
+    TRN_GOT_ALL = (1 << 4) - 1,
+    SPL_GOT_ID = 1 << 0,
+    SPL_GOT_RECONCILED_STATE = 1 << 1,
+    SPL_GOT_VALUE = 1 << 2,
+    SPL_GOT_QUANTITY = 1 << 3,
+    SPL_GOT_ACCOUNT = 1 << 4,
+    SPL_GOT_ALL = (1 << 5) - 1,
+};
+
+class TransactionStreamHandler : public SixtpStreamHandler
+{
+public:
+    explicit TransactionStreamHandler (QofBook* book);
+    ~TransactionStreamHandler ();
+    bool start_element (guint depth, guint32 hash, const gchar* tag,
+                        const gchar** attrs) override;
+    bool end_element (guint depth, guint32 hash, const gchar* tag,
+                      const std::string& text) override;
+    bool end_captured (guint depth, guint32 hash, xmlNodePtr node) override;
+    bool finish (gpointer global_data, gpointer* result,
+                 const gchar* tag) override;
+
+private:
+    bool start_trn_child (guint32 hash, const gchar* tag, const gchar** attrs);
+    void end_trn_child (guint32 hash, const gchar* tag, const std::string& text);
+    bool start_split_child (guint32 hash, const gchar* tag, const gchar** attrs);
+    void end_split_child (guint32 hash, const gchar* tag, const std::string& text);
+    void end_split ();
+    void add_ts_date (const std::string& text);
+    time64 take_date (const gchar* tag);
+    void set_split_account (const GncGUID* id);
+    void set_split_lot (const GncGUID* id);
+
+    QofBook* m_book;
+    Transaction* m_trn;
+    Split* m_split = nullptr;
+    bool m_ok = true;
+    bool m_split_ok = true;
+    bool m_splits_ok = true;
+    bool m_guid_ok = false;
+    unsigned m_trn_got = 0;
+    unsigned m_split_got = 0;
+    std::string m_cmdty_space;
+    std::string m_cmdty_id;
+    int m_cmdty_parts = 0;
+    int m_dates = 0;
+    time64 m_date = INT64_MAX;
+};
+
+TransactionStreamHandler::TransactionStreamHandler (QofBook* book) :
+    SixtpStreamHandler{trn_stream_tags}, m_book{book},
+    m_trn{xaccMallocTransaction (book)}
+{
+    xaccTransBeginEdit (m_trn);
+}
+
+TransactionStreamHandler::~TransactionStreamHandler ()
+{
+    /* Only still set if the parse was abandoned before finish(). */
+    if (m_split)
+        xaccSplitDestroy (m_split);
+    if (m_trn)
+    {
+        xaccTransDestroy (m_trn);
+        xaccTransCommitEdit (m_trn);
+    }
+}
+
+void
+TransactionStreamHandler::add_ts_date (const std::string& text)
+{
+    /* Only one ts:date element is permitted, see dom_tree_to_time64. */
+    m_date = m_dates++ ? INT64_MAX : gnc_iso8601_to_time64_gmt (text.c_str ());
+}
+
+time64
+TransactionStreamHandler::take_date (const gchar* tag)
+{
+    auto time = m_date;
+    if (!m_dates)
+        PERR ("no ts:date node found.");
+    if (!dom_tree_valid_time64 (time, BAD_CAST tag))
+        time = 0;
+    m_dates = 0;
+    m_date = INT64_MAX;
+    return time;
+}
+
+bool
+TransactionStreamHandler::start_trn_child (guint32 hash, const gchar* tag,
+                                           const gchar** attrs)
+{
+    switch (hash)
+    {
+    case trn_id_hash:
+        m_guid_ok = sixtp_stream_guid_type_ok (attrs);
+        return true;
+    case trn_currency_hash:
+        m_cmdty_parts = 0;
+        return true;
+    case trn_date_posted_hash:
+    case trn_date_entered_hash:
+        m_dates = 0;
+        m_date = INT64_MAX;
+        return true;
+    case trn_slots_hash:
+        capture ();
+        return true;
+    case trn_num_hash:
+    case trn_description_hash:
+    case trn_splits_hash:
+        return true;
+    default:
+        PERR ("Unhandled tag: %s", tag);
+        m_ok = false;
+        return true;
+    }
+}
+
+void
+TransactionStreamHandler::end_trn_child (guint32 hash, const gchar* tag,
+                                         const std::string& text)
+{
+    switch (hash)
+    {
+    case trn_id_hash:
+        if (m_guid_ok)
+        {
+            auto guid = sixtp_stream_text_to_guid (text);
+            xaccTransSetGUID (m_trn, &guid);
+        }
+        else
+            g_critical ("Invalid GUID in <%s>", tag);
+        m_trn_got |= TRN_GOT_ID;
+        break;
+    case trn_currency_hash:
+    {
+        gnc_commodity* ref = NULL;
+        if (m_cmdty_parts == 2)
+        {
+            auto table = gnc_commodity_table_get_table (m_book);
+            ref = gnc_commodity_table_lookup (table, m_cmdty_space.c_str (),
+                                              m_cmdty_id.c_str ());
+        }
+        if (!ref)
+            PERR ("Unknown currency in transaction");
+        xaccTransSetCurrency (m_trn, ref);
+        break;
+    }
+    case trn_num_hash:
+        xaccTransSetNum (m_trn, text.c_str ());
+        break;
+    case trn_date_posted_hash:
+        xaccTransSetDatePostedSecs (m_trn, take_date (tag));
+        m_trn_got |= TRN_GOT_DATE_POSTED;
+        break;
+    case trn_date_entered_hash:
+        xaccTransSetDateEnteredSecs (m_trn, take_date (tag));
+        m_trn_got |= TRN_GOT_DATE_ENTERED;
+        break;
+    case trn_description_hash:
+        xaccTransSetDescription (m_trn, text.c_str ());
+        break;
+    case trn_splits_hash:
+        m_trn_got |= TRN_GOT_SPLITS;
+        break;
+    default:
+        break;
+    }
+}
+
+bool
+TransactionStreamHandler::start_split_child (guint32 hash, const gchar* tag,
+                                             const gchar** attrs)
+{
+    switch (hash)
+    {
+    case spl_id_hash:
+    case spl_account_hash:
+    case spl_lot_hash:
+        m_guid_ok = sixtp_stream_guid_type_ok (attrs);
+        return true;
+    case spl_reconcile_date_hash:
+        m_dates = 0;
+        m_date = INT64_MAX;
+        return true;
+    case spl_slots_hash:
+        capture ();
+        return true;
+    case spl_memo_hash:
+    case spl_action_hash:
+    case spl_reconciled_state_hash:
+    case spl_value_hash:
+    case spl_quantity_hash:
+        return true;
+    default:
+        PERR ("Unhandled tag: %s", tag);
+        m_split_ok = false;
+        return true;
+    }
+}
+
+void
+TransactionStreamHandler::set_split_account (const GncGUID* id)
+{
+    auto account = xaccAccountLookup (id, m_book);
+    if (!account && gnc_transaction_xml_v2_testing &&
+        !guid_equal (id, guid_null ()))
+    {
+        account = xaccMallocAccount (m_book);
+        xaccAccountSetGUID (account, id);
+        xaccAccountSetCommoditySCU (account,
+                                    xaccSplitGetAmount (m_split).denom);
+    }
+    xaccAccountInsertSplit (account, m_split);
+}
+
+void
+TransactionStreamHandler::set_split_lot (const GncGUID* id)
+{
+    auto lot = gnc_lot_lookup (id, m_book);
+    if (!lot && gnc_transaction_xml_v2_testing &&
+        !guid_equal (id, guid_null ()))
+    {
+        lot = gnc_lot_new (m_book);
+        gnc_lot_set_guid (lot, *id);
+    }
+    gnc_lot_add_split (lot, m_split);
+}
+
+void
+TransactionStreamHandler::end_split_child (guint32 hash, const gchar* tag,
+                                           const std::string& text)
+{
+    gnc_numeric num;
+
+    switch (hash)
+    {
+    case spl_id_hash:
+    case spl_account_hash:
+    case spl_lot_hash:
+    {
+        if (!m_guid_ok)
+        {
+            g_critical ("Invalid GUID in <%s>", tag);
+        }
+        else
+        {
+            auto guid = sixtp_stream_text_to_guid (text);
+            if (hash == spl_id_hash)
+                xaccSplitSetGUID (m_split, &guid);
+            else if (hash == spl_account_hash)
+                set_split_account (&guid);
+            else
+                set_split_lot (&guid);
+        }
+        if (hash == spl_id_hash)
+            m_split_got |= SPL_GOT_ID;
+        else if (hash == spl_account_hash)
+            m_split_got |= SPL_GOT_ACCOUNT;
+        break;
+    }
+    case spl_memo_hash:
+        xaccSplitSetMemo (m_split, text.c_str ());
+        break;
+    case spl_action_hash:
+        xaccSplitSetAction (m_split, text.c_str ());
+        break;
+    case spl_reconciled_state_hash:
+        xaccSplitSetReconcile (m_split, text.empty () ? '\0' : text[0]);
+        m_split_got |= SPL_GOT_RECONCILED_STATE;
+        break;
+    case spl_reconcile_date_hash:
+        xaccSplitSetDateReconciledSecs (m_split, take_date (tag));
+        break;
+    case spl_value_hash:
+        if (!string_to_gnc_numeric (text.c_str (), &num))
+            num = gnc_numeric_zero ();
+        xaccSplitSetValue (m_split, num);
+        m_split_got |= SPL_GOT_VALUE;
+        break;
+    case spl_quantity_hash:
+        if (!string_to_gnc_numeric (text.c_str (), &num))
+            num = gnc_numeric_zero ();
+        xaccSplitSetAmount (m_split, num);
+        m_split_got |= SPL_GOT_QUANTITY;
+        break;
+    default:
+        break;
+    }
+}
+
+void
+TransactionStreamHandler::end_split ()
+{
+    if (!m_split)
+        return;
+
+    if (m_split_got != SPL_GOT_ALL)
+    {
+        PERR ("didn't find all of the expected tags in the input");
+        m_split_ok = false;
+    }
+
+    if (m_split_ok)
+    {
+        xaccTransAppendSplit (m_trn, m_split);
+    }
+    else
+    {
+        /* Like trn_splits_handler, drop the remaining splits too. */
+        xaccSplitDestroy (m_split);
+        m_splits_ok = false;
+    }
+    m_split = nullptr;
+}
+
+bool
+TransactionStreamHandler::start_element (guint depth, guint32 hash,
+                                         const gchar* tag, const gchar** attrs)
+{
+    auto parent = parent_hash (depth);
+
+    if (depth == 1)
+        return start_trn_child (hash, tag, attrs);
+
+    if (depth == 2 && parent == trn_splits_hash)
+    {
+        if (hash == trn_split_hash && m_splits_ok)
+        {
+            m_split = xaccMallocSplit (m_book);
+            m_split_ok = true;
+            m_split_got = 0;
+        }
+        else
+        {
+            m_splits_ok = false;
+        }
+        return true;
+    }
+
+    if (depth == 3 && parent == trn_split_hash && m_split)
+        return start_split_child (hash, tag, attrs);
+
+    return true;
+}
+
+bool
+TransactionStreamHandler::end_element (guint depth, guint32 hash,
+                                       const gchar* tag, const std::string& text)
+{
+    auto parent = parent_hash (depth);
+
+    switch (depth)
+    {
+    case 1:
+        end_trn_child (hash, tag, text);
+        break;
+    case 2:
+        if (parent == trn_currency_hash)
+        {
+            if (hash == cmdty_space_hash || hash == cmdty_id_hash)
+            {
+                auto& str = hash == cmdty_space_hash ? m_cmdty_space : m_cmdty_id;
+                auto stripped = text.find_first_not_of (" \t\n\r");
+                auto end = text.find_last_not_of (" \t\n\r");
+                str.assign (text, stripped == std::string::npos ? 0 : stripped,
+                            stripped == std::string::npos ? 0 : end - stripped + 1);
+                ++m_cmdty_parts;
+            }
+        }
+        else if (hash == ts_date_hash &&
+                 (parent == trn_date_posted_hash || parent == trn_date_entered_hash))
+        {
+            add_ts_date (text);
+        }
+        else if (parent == trn_splits_hash && hash == trn_split_hash)
+        {
+            end_split ();
+        }
+        break;
+    case 3:
+        if (parent == trn_split_hash && m_split)
+            end_split_child (hash, tag, text);
+        break;
+    case 4:
+        if (hash == ts_date_hash && parent == spl_reconcile_date_hash && m_split)
+            add_ts_date (text);
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+bool
+TransactionStreamHandler::end_captured (guint depth, guint32 hash,
+                                        xmlNodePtr node)
+{
+    QofInstance* inst = NULL;
+    if (depth == 1 && hash == trn_slots_hash)
+        inst = QOF_INSTANCE (m_trn);
+    else if (depth == 3 && hash == spl_slots_hash && m_split)
+        inst = QOF_INSTANCE (m_split);
+
+    if (inst && !dom_tree_create_instance_slots (node, inst))
+        g_critical ("Failed to parse <%s>", (char*)node->name);
+    return true;
+}
+
+bool
+TransactionStreamHandler::finish (gpointer global_data, gpointer* result,
+                                  const gchar* tag)
+{
+    gxpf_data* gdata = (gxpf_data*)global_data;
+    auto trn = m_trn;
+
+    m_trn = nullptr;
+    if (m_trn_got != TRN_GOT_ALL)
+    {
+        PERR ("didn't find all of the expected tags in the input");
+        m_ok = false;
+    }
+
+    xaccTransCommitEdit (trn);
+
+    if (!m_ok)
+    {
+        PERR ("Failed to parse transaction %s",
+              guid_to_string (xaccTransGetGUID (trn)));
+        xaccTransBeginEdit (trn);
+        xaccTransDestroy (trn);
+        xaccTransCommitEdit (trn);
+        return false;
+    }
+
+    gdata->cb (tag, gdata->parsedata, trn);
+    return true;
+}
+
+static gboolean
+gnc_transaction_stream_start_handler (GSList* sibling_data,
+                                      gpointer parent_data,
+                                      gpointer global_data,
+                                      gpointer* data_for_children,
+                                      gpointer* result,
+                                      const gchar* tag, gchar** attrs)
+{
+    gxpf_data* gdata = (gxpf_data*)global_data;
+
+    /* The document's top frame, when parsing a lone transaction. */
+    if (!tag)
+        return TRUE;
+
+    *data_for_children =
+        new TransactionStreamHandler (static_cast<QofBook*> (gdata->bookdata));
+    return TRUE;
+}
+
 sixtp*
 gnc_transaction_sixtp_parser_create (void)
 {
-    return sixtp_dom_parser_new (gnc_transaction_end_handler, NULL, NULL);
+    return sixtp_stream_parser_new (gnc_transaction_stream_start_handler,
+                                    NULL, NULL);
 }
@@ -30,15 +30,24 @@ extern "C"
 #include <glib.h>
 #include <glib/gstdio.h>
 #include <regex.h>
+#ifdef HAVE_LINUX_FS_H
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
 
 #include <gnc-engine.h> //for GNC_MOD_BACKEND
 #include <gnc-uri-utils.h>
 #include <TransLog.h>
 #include <gnc-prefs.h>
+#include <Account.h>
+#include <Transaction.h>
+#include <gnc-pricedb.h>
+#include <SX-book.h>
 
 }
 
 #include <sstream>
+#include <vector>
 
 #include "gnc-xml-backend.hpp"
 #include "gnc-backend-xml.h"
@@ -188,6 +197,8 @@ GncXmlBackend::session_end()
     m_fullpath.clear();
     m_lockfile.clear();
     m_linkfile.clear();
+    m_delta.clear();
+    m_delta_complete = false;
 }
 
 static QofBookFileType
@@ -289,6 +300,9 @@ GncXmlBackend::load(QofBook* book, QofBackendLoadType loadType)
 
     /* We just got done loading, it can't possibly be dirty !! */
     qof_book_mark_session_saved (book);
+
+    if (error == ERR_BACKEND_NO_ERR)
+        replay_delta();
 }
 
 void
@@ -310,17 +324,180 @@ GncXmlBackend::sync(QofBook* book)
         return;
     }
 
-    write_to_file (true);
+    if (gnc_prefs_get_file_save_delta() && write_delta())
+        return;
+
+    if (write_to_file (true))
+        clear_delta();
     remove_old_files();
 }
 
+void
+GncXmlBackend::safe_sync(QofBook* book)
+{
+    /* XML sync is inherently safe, but the new file must be complete. */
+    m_delta_complete = false;
+    sync(book);
+}
+
 void
 GncXmlBackend::commit(QofInstance* instance)
 {
+    if (m_delta_complete &&
+        (qof_instance_is_dirty(instance) || qof_instance_get_destroying(instance)))
+        record_change(instance);
+
     if (qof_instance_is_dirty(instance))
         qof_instance_mark_clean(instance);
 }
 
+static bool
+is_template_account (Account* acc)
+{
+    return acc && gnc_account_get_root (acc) ==
+        gnc_book_get_template_root (gnc_account_get_book (acc));
+}
+
+/* Note a committed instance for the next incremental save.  Only
+ * transactions, accounts and prices can be written to the delta file; any
+ * other change means the next save has to rewrite the whole book.  The
+ * PriceDB itself carries nothing to save: it is committed alongside each
+ * price that is added or removed, and that price's commit is recorded. */
+void
+GncXmlBackend::record_change(QofInstance* instance)
+{
+    auto type = instance->e_type;
+
+    if (g_strcmp0 (type, GNC_ID_PRICEDB) == 0)
+        return;
+
+    if (g_strcmp0 (type, GNC_ID_SPLIT) == 0)
+    {
+        auto trans = xaccSplitGetParent (GNC_SPLIT (instance));
+        if (!trans)
+        {
+            m_delta_complete = false;
+            return;
+        }
+        instance = QOF_INSTANCE (trans);
+        type = GNC_ID_TRANS;
+    }
+
+    if (g_strcmp0 (type, GNC_ID_TRANS) == 0)
+    {
+        for (auto node = xaccTransGetSplitList (GNC_TRANSACTION (instance));
+             node; node = node->next)
+            if (is_template_account (xaccSplitGetAccount (GNC_SPLIT (node->data))))
+                m_delta_complete = false;
+    }
+    else if (g_strcmp0 (type, GNC_ID_ACCOUNT) == 0)
+    {
+        if (is_template_account (GNC_ACCOUNT (instance)))
+            m_delta_complete = false;
+    }
+    else if (g_strcmp0 (type, GNC_ID_PRICE) != 0)
+        m_delta_complete = false;
+
+    if (!m_delta_complete)
+    {
+        m_delta.clear();
+        return;
+    }
+
+    auto guid = qof_instance_get_guid (instance);
+    char guidstr[GUID_ENCODING_LENGTH + 1];
+    guid_to_string_buff (guid, guidstr);
+    auto& entry = m_delta[guidstr];
+    entry.type = type;
+    entry.guid = *guid;
+    entry.destroyed = qof_instance_get_destroying (instance);
+}
+
+/* Append the recorded changes to the delta file.  Returns false when the
+ * whole book should be written instead. */
+bool
+GncXmlBackend::write_delta()
+{
+    GStatBuf statbuf, deltabuf;
+    auto delta_path = m_fullpath + ".delta";
+
+    if (!m_delta_complete || m_delta.empty() ||
+        g_stat (m_fullpath.c_str(), &statbuf) != 0)
+        return false;
+
+    /* Fold the delta back into the data file once it has grown to a
+     * quarter of its size; loading it gets slower from there on. */
+    if (g_stat (delta_path.c_str(), &deltabuf) == 0 &&
+        deltabuf.st_size > statbuf.st_size / 4)
+        return false;
+
+    ENTER (" book=%p file=%s changes=%zu", m_book, delta_path.c_str(),
+           m_delta.size());
+    if (!gnc_book_append_delta_to_xml_file_v2 (m_book, delta_path.c_str(),
+                                               m_delta, statbuf.st_size,
+                                               statbuf.st_mtime))
+    {
+        PWARN ("Unable to append to %s, writing the whole file",
+               delta_path.c_str());
+        LEAVE ("");
+        return false;
+    }
+
+    m_delta.clear();
+    qof_book_mark_session_saved (m_book);
+    LEAVE ("");
+    return true;
+}
+
+void
+GncXmlBackend::replay_delta()
+{
+    GStatBuf statbuf;
+    auto delta_path = m_fullpath + ".delta";
+
+    m_delta.clear();
+    m_delta_complete = false;
+    if (!g_file_test (delta_path.c_str(), G_FILE_TEST_EXISTS))
+    {
+        m_delta_complete = true;
+        return;
+    }
+
+    if (g_stat (m_fullpath.c_str(), &statbuf) == 0 &&
+        gnc_book_replay_xml_delta_v2 (m_book, delta_path.c_str(),
+                                      statbuf.st_size, statbuf.st_mtime))
+    {
+        /* The data file and the delta together hold everything the replay
+         * committed. */
+        m_delta.clear();
+        m_delta_complete = true;
+        qof_book_mark_session_saved (m_book);
+        return;
+    }
+
+    /* Keep the unusable delta for inspection.  Whatever did replay is only in
+     * memory now, so leave the book dirty; the next save writes it in full. */
+    auto stale = delta_path + ".stale";
+    PWARN ("Moving unusable delta file aside to %s", stale.c_str());
+    if (g_rename (delta_path.c_str(), stale.c_str()) != 0)
+        PWARN ("Unable to rename %s: %s", delta_path.c_str(),
+               g_strerror (errno));
+    qof_book_mark_session_dirty (m_book);
+}
+
+/* The data file now holds everything, so start a new delta. */
+void
+GncXmlBackend::clear_delta()
+{
+    auto delta_path = m_fullpath + ".delta";
+
+    m_delta.clear();
+    m_delta_complete = true;
+    if (g_unlink (delta_path.c_str()) != 0 && errno != ENOENT)
+        PWARN ("Unable to remove %s: %s", delta_path.c_str(),
+               g_strerror (errno));
+}
+
 bool
 GncXmlBackend::save_may_clobber_data()
 {
@@ -518,15 +695,97 @@ GncXmlBackend::write_to_file (bool make_backup)
     return TRUE;
 }
 
+/* The ways copy_file can fill a backup, cheapest first.  Each one that
+ * gives up leaves both files rewound and the backup empty, so the next one
+ * can start over; copy_file_range_all fails outright when it can't. */
+
+static bool
+reflink_file (int orig_fd, int bkup_fd)
+{
+#if defined(HAVE_LINUX_FS_H) && defined(FICLONE)
+    /* btrfs, XFS and friends share the extents instead of copying them. */
+    return ioctl (bkup_fd, FICLONE, orig_fd) == 0;
+#else
+    return false;
+#endif
+}
+
+/* The outcome of copy_file_range_all.  It fails when it can't rewind the
+ * files after giving up, as then nothing else can be tried either. */
+enum class RangeCopy { copied, unsupported, failed };
+
+static RangeCopy
+copy_file_range_all (int orig_fd, int bkup_fd)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+    /* Lets the kernel copy without a round trip through user space, or
+     * share extents where the filesystem can. */
+    constexpr size_t chunk = 1 << 30;
+    ssize_t count;
+
+    do
+    {
+        count = copy_file_range (orig_fd, NULL, bkup_fd, NULL, chunk, 0);
+    }
+    while (count > 0 || (count == -1 && errno == EINTR));
+
+    if (count == 0)
+        return RangeCopy::copied;
+
+    /* Not supported here (EXDEV, ENOSYS, EINVAL...): rewind for the next
+     * method. */
+    if (lseek (orig_fd, 0, SEEK_SET) == -1 || lseek (bkup_fd, 0, SEEK_SET) == -1
+        || ftruncate (bkup_fd, 0) == -1)
+    {
+        PERR ("Unable to rewind for a copy: %s", g_strerror (errno));
+        return RangeCopy::failed;
+    }
+#endif
+    return RangeCopy::unsupported;
+}
+
+static bool
+stream_file (int orig_fd, int bkup_fd)
+{
+    constexpr size_t buf_size = 1 << 16;
+    std::vector<char> buf (buf_size);
+    ssize_t count_read;
+
+    do
+    {
+        count_read = read (orig_fd, buf.data(), buf_size);
+        if (count_read == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        for (ssize_t written = 0; written < count_read;)
+        {
+            auto count_write = write (bkup_fd, buf.data() + written,
+                                      count_read - written);
+            if (count_write == -1)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            written += count_write;
+        }
+    }
+    while (count_read != 0);
+
+    return true;
+}
+
 static bool
 copy_file (const std::string& orig, const std::string& bkup)
 {
-    constexpr size_t buf_size = 1024;
-    char buf[buf_size];
     int flags = 0;
-    ssize_t count_write = 0;
-    ssize_t count_read = 0;
+    bool success;
 
+    QOF_STAT_SCOPED_TIMER ("backend.xml.backup.copy");
 
 #ifdef G_OS_WIN32
     flags = O_BINARY;
@@ -545,33 +804,35 @@ copy_file (const std::string& orig, const std::string& bkup)
         return FALSE;
     }
 
-    do
+    if (reflink_file (orig_fd, bkup_fd))
     {
-        count_read = read (orig_fd, buf, buf_size);
-        if (count_read == -1 && errno != EINTR)
-        {
-            close (orig_fd);
-            close (bkup_fd);
-            return FALSE;
-        }
-
-        if (count_read > 0)
+        QOF_STAT_COUNT ("backend.xml.backup.reflink");
+        success = true;
+    }
+    else
+    {
+        switch (copy_file_range_all (orig_fd, bkup_fd))
         {
-            count_write = write (bkup_fd, buf, count_read);
-            if (count_write == -1)
-            {
-                close (orig_fd);
-                close (bkup_fd);
-                return FALSE;
-            }
+        case RangeCopy::copied:
+            QOF_STAT_COUNT ("backend.xml.backup.copy-file-range");
+            success = true;
+            break;
+        case RangeCopy::failed:
+            success = false;
+            break;
+        case RangeCopy::unsupported:
+        default:
+            QOF_STAT_COUNT ("backend.xml.backup.stream");
+            success = stream_file (orig_fd, bkup_fd);
+            break;
         }
     }
-    while (count_read > 0);
 
     close (orig_fd);
-    close (bkup_fd);
+    if (close (bkup_fd) != 0)
+        success = false;
 
-    return TRUE;
+    return success;
 }
 
 bool
@@ -586,6 +847,8 @@ GncXmlBackend::link_or_make_backup (const std::string& orig,
         - 1
 #endif
         ;
+    if (err_ret == 0)
+        QOF_STAT_COUNT ("backend.xml.backup.link");
     if (err_ret != 0)
     {
 #ifdef HAVE_LINK
@@ -743,6 +1006,8 @@ GncXmlBackend::backup_file()
 {
     GStatBuf statbuf;
 
+    QOF_STAT_SCOPED_TIMER ("backend.xml.backup");
+
     auto datafile = m_fullpath.c_str();
 
     auto rc = g_stat (datafile, &statbuf);
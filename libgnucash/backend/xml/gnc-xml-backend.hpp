@@ -25,6 +25,7 @@ extern "C"
 
 #include <string>
 #include <qof-backend.hpp>
+#include "io-gncxml-v2.h"
 
 class GncXmlBackend : public QofBackend
 {
@@ -42,7 +43,7 @@ public:
     /* The XML backend isn't able to do anything with individual instances. */
     void export_coa(QofBook*) override;
     void sync(QofBook* book) override;
-    void safe_sync(QofBook* book) override { sync(book); } // XML sync is inherently safe.
+    void safe_sync(QofBook* book) override;
     void commit(QofInstance* instance) override;
     const char * get_filename() { return m_fullpath.c_str(); }
     QofBook* get_book() { return m_book; }
@@ -56,11 +57,19 @@ private:
     void remove_old_files();
     void write_accounts(QofBook* book);
     bool check_path(const char* fullpath, bool create);
+    void record_change(QofInstance* instance);
+    bool write_delta();
+    void replay_delta();
+    void clear_delta();
 
     std::string m_dirname;
     std::string m_lockfile;
     std::string m_linkfile;
     int m_lockfd;
+    /* Objects committed since the data file was last written in full, and
+     * whether that record is complete enough to save from. */
+    GncXmlDelta m_delta;
+    bool m_delta_complete = false;
 
     QofBook* m_book = nullptr;  /* The primary, main open book */
 };
@@ -36,8 +36,12 @@ extern "C"
 #include "gnc-xml-helper.h"
 #include "sixtp.h"
 
+class SixtpStreamWriter;
+
 xmlNodePtr gnc_account_dom_tree_create (Account* act, gboolean exporting,
                                         gboolean allow_incompat);
+void gnc_account_write_xml (SixtpStreamWriter& writer, Account* act,
+                            gboolean exporting, gboolean allow_incompat);
 sixtp* gnc_account_sixtp_parser_create (void);
 
 xmlNodePtr gnc_book_dom_tree_create (QofBook* book);
@@ -51,8 +55,10 @@ sixtp* gnc_commodity_sixtp_parser_create (void);
 sixtp* gnc_freqSpec_sixtp_parser_create (void);
 
 xmlNodePtr gnc_lot_dom_tree_create (GNCLot*);
+void gnc_lot_write_xml (SixtpStreamWriter& writer, GNCLot* lot);
 sixtp* gnc_lot_sixtp_parser_create (void);
 
+xmlNodePtr gnc_price_dom_tree_create (GNCPrice* price);
 xmlNodePtr gnc_pricedb_dom_tree_create (GNCPriceDB* db);
 sixtp* gnc_pricedb_sixtp_parser_create (void);
 
@@ -63,6 +69,7 @@ xmlNodePtr gnc_budget_dom_tree_create (GncBudget* bgt);
 sixtp* gnc_budget_sixtp_parser_create (void);
 
 xmlNodePtr gnc_transaction_dom_tree_create (Transaction* txn);
+void gnc_transaction_write_xml (SixtpStreamWriter& writer, Transaction* txn);
 sixtp* gnc_transaction_sixtp_parser_create (void);
 
 sixtp* gnc_template_transaction_sixtp_parser_create (void);
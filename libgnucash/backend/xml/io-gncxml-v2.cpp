@@ -66,9 +66,12 @@ extern "C"
 #endif
 }
 
+#include <algorithm>
+
 #include "gnc-xml-backend.hpp"
 #include "sixtp-parsers.h"
 #include "sixtp-utils.h"
+#include "sixtp-stream-writer.hpp"
 #include "gnc-xml.h"
 #include "io-utils.h"
 #include "sixtp-dom-parsers.h"
@@ -107,6 +110,7 @@ struct file_backend
     sixtp*          parser;
     FILE*           out;
     QofBook*        book;
+    SixtpStreamWriter* writer;
 };
 
 static std::vector<GncXmlDataType_t> backend_registry;
@@ -847,6 +851,10 @@ qof_session_load_from_xml_file_v2_full (
     /* Fix split amount/value */
     xaccAccountTreeScrubSplits (root);
 
+    /* sort and balance all accounts at once, so that the commits below
+     * find nothing left to do */
+    gnc_book_finalize_load (book);
+
     /* commit all groups, this completes the BeginEdit started when the
      * account_end_handler finished reading the account.
      */
@@ -1153,14 +1161,11 @@ static int
 xml_add_trn_data (Transaction* t, gpointer data)
 {
     struct file_backend* be_data = static_cast<decltype (be_data)> (data);
-    xmlNodePtr node;
 
-    node = gnc_transaction_dom_tree_create (t);
+    gnc_transaction_write_xml (*be_data->writer, t);
 
-    xmlElemDump (be_data->out, NULL, node);
-    xmlFreeNode (node);
-
-    if (ferror (be_data->out) || fprintf (be_data->out, "\n") < 0)
+    if (!be_data->writer->flush (be_data->out) ||
+        fprintf (be_data->out, "\n") < 0)
         return -1;
 
     be_data->gd->counter.transactions_loaded++;
@@ -1172,9 +1177,11 @@ static gboolean
 write_transactions (FILE* out, QofBook* book, sixtp_gdv2* gd)
 {
     struct file_backend be_data;
+    SixtpStreamWriter writer;
 
     be_data.out = out;
     be_data.gd = gd;
+    be_data.writer = &writer;
     return 0 ==
            xaccAccountTreeForEachTransaction (gnc_book_get_root_account (book),
                                               xml_add_trn_data,
@@ -1186,9 +1193,11 @@ write_template_transaction_data (FILE* out, QofBook* book, sixtp_gdv2* gd)
 {
     Account* ra;
     struct file_backend be_data;
+    SixtpStreamWriter writer;
 
     be_data.out = out;
     be_data.gd = gd;
+    be_data.writer = &writer;
 
     ra = gnc_book_get_template_root (book);
     if (gnc_account_n_descendants (ra) > 0)
@@ -1271,12 +1280,9 @@ write_namespace (const GncXmlDataType_t& data, FILE* out)
 }
 
 static gboolean
-write_v2_header (FILE* out)
+write_namespace_decls (FILE* out)
 {
-    if (fprintf (out, "<?xml version=\"1.0\" encoding=\"utf-8\" ?>\n") < 0
-        || fprintf (out, "<" GNC_V2_STRING) < 0
-
-        || !gnc_xml2_write_namespace_decl (out, "gnc")
+    if (!gnc_xml2_write_namespace_decl (out, "gnc")
         || !gnc_xml2_write_namespace_decl (out, "act")
         || !gnc_xml2_write_namespace_decl (out, "book")
         || !gnc_xml2_write_namespace_decl (out, "cd")
@@ -1298,7 +1304,16 @@ write_v2_header (FILE* out)
     for (auto data : backend_registry)
         write_namespace(data, out);
 
-    if (ferror (out) || fprintf (out, ">\n") < 0)
+    return !ferror (out);
+}
+
+static gboolean
+write_v2_header (FILE* out)
+{
+    if (fprintf (out, "<?xml version=\"1.0\" encoding=\"utf-8\" ?>\n") < 0
+        || fprintf (out, "<" GNC_V2_STRING) < 0
+        || !write_namespace_decls (out)
+        || fprintf (out, ">\n") < 0)
         return FALSE;
 
     return TRUE;
@@ -1616,6 +1631,392 @@ gnc_book_write_to_xml_file_v2 (
     return success;
 }
 
+/* Incremental saves.  A delta file holds a sequence of gzip members, one per
+ * save, each a complete <gnc-delta> document.  Every document records the
+ * size and modification time of the data file it applies to, so that a delta
+ * left behind by a crash after the data file was rewritten is recognized as
+ * stale instead of being replayed onto the wrong base. */
+
+static const char* DELTA_TAG = "gnc-delta";
+static const char* DELTA_REMOVE_TAG = "gnc:remove";
+
+static void
+write_delta_remove (SixtpStreamWriter& writer, const GncXmlDeltaEntry& entry)
+{
+    char guidstr[GUID_ENCODING_LENGTH + 1];
+
+    guid_to_string_buff (&entry.guid, guidstr);
+    writer.start_element (DELTA_REMOVE_TAG);
+    writer.attribute ("type", entry.type);
+    writer.attribute ("id", guidstr);
+    writer.end_element ();
+}
+
+/* The pricedb indexes prices by commodity and time, so a changed price is
+ * removed and added again rather than updated in place. */
+static gboolean
+write_delta_prices (FILE* out, SixtpStreamWriter& writer, QofBook* book,
+                    const std::vector<const GncXmlDeltaEntry*>& entries)
+{
+    std::vector<GNCPrice*> prices;
+    xmlBufferPtr buf;
+
+    for (auto entry : entries)
+    {
+        auto price = gnc_price_lookup (&entry->guid, book);
+        write_delta_remove (writer, *entry);
+        if (price && !entry->destroyed
+            && !qof_instance_get_destroying (QOF_INSTANCE (price)))
+            prices.push_back (price);
+    }
+
+    if (!writer.flush (out))
+        return FALSE;
+    if (prices.empty ())
+        return TRUE;
+
+    if (fprintf (out, "<%s version=\"1\">\n", PRICEDB_TAG) < 0)
+        return FALSE;
+
+    buf = xmlBufferCreate ();
+    for (auto price : prices)
+    {
+        xmlNodePtr node = gnc_price_dom_tree_create (price);
+        if (!node)
+            continue;
+        xmlBufferEmpty (buf);
+        xmlNodeDump (buf, NULL, node, 1, 1);
+        xmlFreeNode (node);
+        if (fprintf (out, "  %s\n", (const char*) xmlBufferContent (buf)) < 0)
+            break;
+    }
+    xmlBufferFree (buf);
+
+    return !ferror (out) && fprintf (out, "</%s>\n", PRICEDB_TAG) >= 0;
+}
+
+static gboolean
+write_delta (FILE* out, QofBook* book, const GncXmlDelta& delta,
+             gint64 base_size, gint64 base_mtime)
+{
+    SixtpStreamWriter writer;
+    std::vector<Account*> accounts;
+    std::vector<const GncXmlDeltaEntry*> prices;
+    std::vector<const GncXmlDeltaEntry*> transactions;
+    std::vector<const GncXmlDeltaEntry*> removed;
+
+    for (const auto& item : delta)
+    {
+        const auto& entry = item.second;
+        if (g_strcmp0 (entry.type, GNC_ID_ACCOUNT) == 0)
+        {
+            auto acc = xaccAccountLookup (&entry.guid, book);
+            if (acc && !entry.destroyed)
+                accounts.push_back (acc);
+            else
+                removed.push_back (&entry);
+        }
+        else if (g_strcmp0 (entry.type, GNC_ID_PRICE) == 0)
+            prices.push_back (&entry);
+        else
+            transactions.push_back (&entry);
+    }
+
+    /* Parents must exist before their children are attached to them. */
+    std::sort (accounts.begin (), accounts.end (),
+               [](Account* a, Account* b)
+               {
+                   return gnc_account_get_current_depth (a) <
+                          gnc_account_get_current_depth (b);
+               });
+
+    if (fprintf (out, "<?xml version=\"1.0\" encoding=\"utf-8\" ?>\n") < 0
+        || fprintf (out, "<%s base-size=\"%" G_GINT64_FORMAT
+                    "\" base-mtime=\"%" G_GINT64_FORMAT "\"",
+                    DELTA_TAG, base_size, base_mtime) < 0
+        || !write_namespace_decls (out)
+        || fprintf (out, ">\n") < 0)
+        return FALSE;
+
+    for (auto acc : accounts)
+        gnc_account_write_xml (writer, acc, TRUE, TRUE);
+
+    if (!write_delta_prices (out, writer, book, prices))
+        return FALSE;
+
+    for (auto entry : transactions)
+    {
+        auto trans = xaccTransLookup (&entry->guid, book);
+        write_delta_remove (writer, *entry);
+        if (trans && !entry->destroyed
+            && !qof_instance_get_destroying (QOF_INSTANCE (trans)))
+            gnc_transaction_write_xml (writer, trans);
+        if (!writer.flush (out))
+            return FALSE;
+    }
+
+    for (auto entry : removed)
+        write_delta_remove (writer, *entry);
+
+    return writer.flush (out) && fprintf (out, "</%s>\n", DELTA_TAG) >= 0;
+}
+
+gboolean
+gnc_book_append_delta_to_xml_file_v2 (QofBook* book, const char* filename,
+                                      const GncXmlDelta& delta,
+                                      gint64 base_size, gint64 base_mtime)
+{
+    FILE* out;
+    gboolean success = TRUE;
+
+    out = try_gz_open (filename, "ab", TRUE, TRUE);
+
+    if (!out || !write_delta (out, book, delta, base_size, base_mtime))
+        success = FALSE;
+
+    if (out && fclose (out))
+        success = FALSE;
+
+    if (out && !wait_for_gzip (out))
+        success = FALSE;
+
+    return success;
+}
+
+static void
+delta_remove_instance (QofBook* book, const char* type, const GncGUID* guid)
+{
+    if (g_strcmp0 (type, GNC_ID_TRANS) == 0)
+    {
+        auto trans = xaccTransLookup (guid, book);
+        if (!trans)
+            return;
+        xaccTransBeginEdit (trans);
+        xaccTransDestroy (trans);
+        xaccTransCommitEdit (trans);
+    }
+    else if (g_strcmp0 (type, GNC_ID_ACCOUNT) == 0)
+    {
+        auto acc = xaccAccountLookup (guid, book);
+        if (!acc)
+            return;
+        xaccAccountBeginEdit (acc);
+        xaccAccountDestroy (acc);
+    }
+    else if (g_strcmp0 (type, GNC_ID_PRICE) == 0)
+    {
+        auto price = gnc_price_lookup (guid, book);
+        if (price)
+            gnc_pricedb_remove_price (gnc_pricedb_get_db (book), price);
+    }
+    else
+        PWARN ("unexpected type %s in delta", type);
+}
+
+static gboolean
+delta_remove_end_handler (gpointer data_for_children,
+                          GSList* data_from_children, GSList* sibling_data,
+                          gpointer parent_data, gpointer global_data,
+                          gpointer* result, const gchar* tag)
+{
+    xmlNodePtr tree = (xmlNodePtr)data_for_children;
+    gxpf_data* gdata = (gxpf_data*)global_data;
+    QofBook* book = static_cast<decltype (book)> (gdata->bookdata);
+    char* type;
+    char* id;
+    GncGUID guid;
+    gboolean ok;
+
+    if (parent_data || !tag)
+        return TRUE;
+
+    g_return_val_if_fail (tree, FALSE);
+
+    type = (char*) xmlGetProp (tree, BAD_CAST "type");
+    id = (char*) xmlGetProp (tree, BAD_CAST "id");
+    ok = type && id && string_to_guid (id, &guid);
+    if (ok)
+        delta_remove_instance (book, type, &guid);
+    else
+        PERR ("invalid <%s> in delta", tag);
+
+    xmlFree (type);
+    xmlFree (id);
+    xmlFreeNode (tree);
+    return ok;
+}
+
+static gboolean
+delta_account_end_handler (gpointer data_for_children,
+                           GSList* data_from_children, GSList* sibling_data,
+                           gpointer parent_data, gpointer global_data,
+                           gpointer* result, const gchar* tag)
+{
+    xmlNodePtr tree = (xmlNodePtr)data_for_children;
+    gxpf_data* gdata = (gxpf_data*)global_data;
+    QofBook* book = static_cast<decltype (book)> (gdata->bookdata);
+    Account* acc;
+
+    if (parent_data || !tag)
+        return TRUE;
+
+    g_return_val_if_fail (tree, FALSE);
+
+    acc = dom_tree_update_account (tree, book);
+    if (acc && !gnc_account_get_parent (acc)
+        && xaccAccountGetType (acc) != ACCT_TYPE_ROOT)
+        gnc_account_append_child (gnc_book_get_root_account (book), acc);
+
+    xmlFreeNode (tree);
+    return acc != NULL;
+}
+
+static gboolean
+delta_callback (const char* tag, gpointer globaldata, gpointer data)
+{
+    sixtp_gdv2* gd = (sixtp_gdv2*)globaldata;
+
+    if (g_strcmp0 (tag, TRANSACTION_TAG) == 0)
+        add_transaction_local (gd, (Transaction*)data);
+    else if (g_strcmp0 (tag, PRICEDB_TAG) != 0)
+        PWARN ("unexpected tag %s in delta", tag);
+    return TRUE;
+}
+
+/* Does @a doc, one <gnc-delta> document, apply to the data file whose
+ * size and modification time are given? */
+static gboolean
+delta_matches_base (const std::string& doc, gint64 base_size,
+                    gint64 base_mtime)
+{
+    auto start = doc.find (std::string ("<") + DELTA_TAG);
+    gint64 size, mtime;
+
+    if (start == std::string::npos)
+        return FALSE;
+
+    auto attrs = doc.substr (start, doc.find ('>', start) - start);
+    auto size_at = attrs.find ("base-size=\"");
+    auto mtime_at = attrs.find ("base-mtime=\"");
+    if (size_at == std::string::npos || mtime_at == std::string::npos)
+        return FALSE;
+
+    size = g_ascii_strtoll (attrs.c_str () + size_at + strlen ("base-size=\""),
+                            NULL, 10);
+    mtime = g_ascii_strtoll (attrs.c_str () + mtime_at + strlen ("base-mtime=\""),
+                             NULL, 10);
+    return size == base_size && mtime == base_mtime;
+}
+
+gboolean
+gnc_book_replay_xml_delta_v2 (QofBook* book, const char* filename,
+                              gint64 base_size, gint64 base_mtime)
+{
+    std::string contents;
+    std::string end_tag = std::string ("</") + DELTA_TAG + ">";
+    char buffer[BUFLEN];
+    size_t bytes, pos = 0;
+    FILE* file;
+    sixtp* top_parser;
+    sixtp* delta_parser;
+    sixtp_gdv2* gd;
+    gboolean success = TRUE;
+
+    file = try_gz_open (filename, "rb", TRUE, FALSE);
+    if (file == NULL)
+    {
+        PWARN ("Unable to open delta file %s", filename);
+        return FALSE;
+    }
+    while ((bytes = fread (buffer, 1, sizeof (buffer), file)) > 0)
+        contents.append (buffer, bytes);
+    fclose (file);
+    /* A delta truncated by a crash fails to decompress at its end; the
+     * complete documents before it are still good. */
+    wait_for_gzip (file);
+
+    top_parser = sixtp_new ();
+    delta_parser = sixtp_new ();
+    if (!sixtp_add_some_sub_parsers (
+            top_parser, TRUE,
+            DELTA_TAG, delta_parser,
+            NULL, NULL)
+        || !sixtp_add_some_sub_parsers (
+            delta_parser, TRUE,
+            DELTA_REMOVE_TAG, sixtp_dom_parser_new (delta_remove_end_handler,
+                                                    NULL, NULL),
+            ACCOUNT_TAG, sixtp_dom_parser_new (delta_account_end_handler,
+                                               NULL, NULL),
+            PRICEDB_TAG, gnc_pricedb_sixtp_parser_create (),
+            TRANSACTION_TAG, gnc_transaction_sixtp_parser_create (),
+            NULL, NULL))
+    {
+        sixtp_destroy (top_parser);
+        return FALSE;
+    }
+
+    gd = gnc_sixtp_gdv2_new (book, FALSE, NULL, NULL);
+    xaccLogDisable ();
+
+    /* As in a full load, keep the accounts open so that each replayed
+     * transaction doesn't sort and rebalance them; that's done once at the
+     * end. The references keep an account removed by the delta, whose
+     * destruction completes with its last commit, around until then. */
+    auto accounts = gnc_account_get_descendants (gnc_book_get_root_account (book));
+    for (auto node = accounts; node; node = node->next)
+    {
+        g_object_ref (node->data);
+        xaccAccountBeginEdit (GNC_ACCOUNT (node->data));
+    }
+
+    while (success)
+    {
+        auto end = contents.find (end_tag, pos);
+        gpointer parse_result = NULL;
+        gxpf_data gpdata;
+
+        if (end == std::string::npos)
+        {
+            if (contents.find_first_not_of (" \t\r\n", pos) != std::string::npos)
+            {
+                PWARN ("Ignoring truncated document at the end of %s", filename);
+                success = FALSE;
+            }
+            break;
+        }
+        end += end_tag.size ();
+
+        auto doc = contents.substr (pos, end - pos);
+        pos = end;
+        if (!delta_matches_base (doc, base_size, base_mtime))
+        {
+            PWARN ("%s doesn't belong to the current data file", filename);
+            success = FALSE;
+            break;
+        }
+
+        gpdata.cb = delta_callback;
+        gpdata.parsedata = gd;
+        gpdata.bookdata = book;
+        if (!sixtp_parse_buffer (top_parser, &doc[0], doc.size (), NULL,
+                                 &gpdata, &parse_result))
+        {
+            PERR ("Failed to replay a document from %s", filename);
+            success = FALSE;
+        }
+    }
+
+    gnc_book_finalize_load (book);
+    for (auto node = accounts; node; node = node->next)
+        xaccAccountCommitEdit (GNC_ACCOUNT (node->data));
+    g_list_free_full (accounts, g_object_unref);
+
+    xaccLogEnable ();
+    sixtp_destroy (top_parser);
+    g_free (gd);
+    return success;
+}
+
 /*
  * Have to pass in the backend as this routine needs the temporary
  * backend for file export, not the real backend which could be
@@ -41,6 +41,8 @@ extern "C"
 }
 #include "gnc-backend-xml.h"
 #include "sixtp.h"
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 class GncXmlBackend;
@@ -93,6 +95,33 @@ gboolean gnc_book_write_to_xml_filehandle_v2 (QofBook* book, FILE* fh);
 gboolean gnc_book_write_to_xml_file_v2 (QofBook* book, const char* filename,
                                         gboolean compress);
 
+/** An object committed since the data file was last written in full.  The
+ * type is GNC_ID_TRANS, GNC_ID_ACCOUNT or GNC_ID_PRICE. */
+struct GncXmlDeltaEntry
+{
+    QofIdTypeConst type;
+    GncGUID guid;
+    bool destroyed;
+};
+
+/** The changed objects, keyed by the string form of their GUID. */
+using GncXmlDelta = std::unordered_map<std::string, GncXmlDeltaEntry>;
+
+/** Append the objects in @a delta to the delta file @a filename, as a
+ * document that applies to a data file of size @a base_size and
+ * modification time @a base_mtime. */
+gboolean gnc_book_append_delta_to_xml_file_v2 (QofBook* book,
+                                               const char* filename,
+                                               const GncXmlDelta& delta,
+                                               gint64 base_size,
+                                               gint64 base_mtime);
+
+/** Replay the delta file @a filename onto a freshly loaded book.  Returns
+ * FALSE if the file belongs to a different data file or couldn't be
+ * applied completely. */
+gboolean gnc_book_replay_xml_delta_v2 (QofBook* book, const char* filename,
+                                       gint64 base_size, gint64 base_mtime);
+
 /** write just the commodities and accounts to a file */
 gboolean gnc_book_write_accounts_to_xml_filehandle_v2 (QofBackend* be,
                                                        QofBook* book, FILE* fh);
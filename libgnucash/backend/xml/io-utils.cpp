@@ -33,20 +33,19 @@ extern "C"
 #include "gnc-xml.h"
 #include "io-utils.h"
 #include "sixtp.h"
+#include "sixtp-stream-writer.hpp"
 
 static gboolean
 write_one_account (FILE* out,
+                   SixtpStreamWriter& writer,
                    Account* account,
                    sixtp_gdv2* gd,
                    gboolean allow_incompat)
 {
-    xmlNodePtr accnode;
-
-    accnode =
-        gnc_account_dom_tree_create (account, gd && gd->exporting, allow_incompat);
-
-    xmlElemDump (out, NULL, accnode);
-    xmlFreeNode (accnode);
+    gnc_account_write_xml (writer, account, gd && gd->exporting,
+                           allow_incompat);
+    if (!writer.flush (out))
+        return FALSE;
 
     g_return_val_if_fail(gd, FALSE);
 
@@ -64,15 +63,16 @@ write_account_tree (FILE* out, Account* root, sixtp_gdv2* gd)
     GList* descendants, *node;
     gboolean allow_incompat = TRUE;
     gboolean success = TRUE;
+    SixtpStreamWriter writer;
 
     if (allow_incompat)
-        if (!write_one_account (out, root, gd, allow_incompat))
+        if (!write_one_account (out, writer, root, gd, allow_incompat))
             return FALSE;
 
     descendants = gnc_account_get_descendants (root);
     for (node = descendants; node; node = g_list_next (node))
     {
-        if (!write_one_account (out, static_cast<Account*> (node->data),
+        if (!write_one_account (out, writer, static_cast<Account*> (node->data),
                                 gd, allow_incompat))
         {
             success = FALSE;
@@ -57,6 +57,7 @@ gboolean dom_tree_to_boolean (xmlNodePtr node, gboolean* b);
 
 /* higher level structures */
 Account* dom_tree_to_account (xmlNodePtr node, QofBook* book);
+Account* dom_tree_update_account (xmlNodePtr node, QofBook* book);
 QofBook* dom_tree_to_book (xmlNodePtr node, QofBook* book);
 GNCLot*  dom_tree_to_lot (xmlNodePtr node, QofBook* book);
 Transaction* dom_tree_to_transaction (xmlNodePtr node, QofBook* book);
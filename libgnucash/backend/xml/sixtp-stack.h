@@ -41,6 +41,10 @@ typedef struct sixtp_stack_frame
     /* Line and column [of the start tag]; set during parsing. */
     int line;
     int col;
+
+    /* Nesting depth of the descendant elements currently being passed to
+       the parser's raw handlers, if it has any. */
+    guint raw_depth;
 } sixtp_stack_frame;
 
 struct _sixtp_parser_context_struct
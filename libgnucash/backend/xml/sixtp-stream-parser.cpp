@@ -0,0 +1,276 @@
+/********************************************************************
+ * sixtp-stream-parser.cpp -- sixtp nodes that parse an object      *
+ *                            without building a DOM tree.          *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+ ********************************************************************/
+extern "C"
+{
+#include <config.h>
+
+#include <glib.h>
+#include <string.h>
+#include "qof.h"
+}
+
+#include <algorithm>
+
+#include "sixtp-stream-parser.hpp"
+
+static QofLogModule log_module = GNC_MOD_IO;
+
+static void
+stream_set_attrs (xmlNodePtr node, const gchar** attrs)
+{
+    if (!attrs)
+        return;
+    for (; *attrs; attrs += 2)
+        xmlSetProp (node, BAD_CAST attrs[0], BAD_CAST attrs[1]);
+}
+
+SixtpTagTable::SixtpTagTable (std::initializer_list<const char*> tags)
+{
+    m_tags.reserve (tags.size ());
+    for (auto tag : tags)
+        m_tags.emplace_back (sixtp_tag_hash (tag), tag);
+    std::sort (m_tags.begin (), m_tags.end ());
+}
+
+guint32
+SixtpTagTable::verified_hash (const char* tag) const
+{
+    auto hash = sixtp_tag_hash (tag);
+    auto range = std::equal_range (m_tags.begin (), m_tags.end (),
+                                   std::make_pair (hash, (const char*)nullptr),
+                                   [](const auto& a, const auto& b)
+                                   { return a.first < b.first; });
+    if (range.first == range.second)
+        return hash;
+    for (auto it = range.first; it != range.second; ++it)
+        if (strcmp (it->second, tag) == 0)
+            return hash;
+    return 0;
+}
+
+SixtpStreamHandler::~SixtpStreamHandler ()
+{
+    if (!m_capture)
+        return;
+    while (m_capture->parent)
+        m_capture = m_capture->parent;
+    xmlFreeNode (m_capture);
+}
+
+bool
+SixtpStreamHandler::end_captured (guint depth, guint32 hash, xmlNodePtr node)
+{
+    PERR ("Unexpected captured element <%s>", (char*)node->name);
+    return false;
+}
+
+bool
+SixtpStreamHandler::raw_start (guint depth, const gchar* tag,
+                               const gchar** attrs)
+{
+    if (m_capture)
+    {
+        m_capture = xmlNewChild (m_capture, NULL, BAD_CAST tag, NULL);
+        stream_set_attrs (m_capture, attrs);
+        return true;
+    }
+
+    auto hash = m_tags.verified_hash (tag);
+    m_path.push_back (hash);
+    m_text.clear ();
+    m_capture_requested = false;
+    auto ok = start_element (depth, hash, tag, attrs);
+    if (m_capture_requested)
+    {
+        m_capture = xmlNewNode (NULL, BAD_CAST tag);
+        stream_set_attrs (m_capture, attrs);
+        m_capture_depth = depth;
+        m_capture_requested = false;
+    }
+    return ok;
+}
+
+bool
+SixtpStreamHandler::raw_end (guint depth, const gchar* tag)
+{
+    bool ok;
+
+    if (m_capture && depth > m_capture_depth)
+    {
+        m_capture = m_capture->parent;
+        return true;
+    }
+
+    auto hash = m_path.empty () ? m_tags.verified_hash (tag) : m_path.back ();
+    if (m_capture)
+    {
+        auto node = m_capture;
+        m_capture = nullptr;
+        ok = end_captured (depth, hash, node);
+        xmlFreeNode (node);
+    }
+    else
+    {
+        ok = end_element (depth, hash, tag, m_text);
+    }
+    m_text.clear ();
+    if (!m_path.empty ())
+        m_path.pop_back ();
+    return ok;
+}
+
+void
+SixtpStreamHandler::raw_characters (const char* text, int length)
+{
+    if (length <= 0)
+        return;
+    if (m_capture)
+        xmlNodeAddContentLen (m_capture, BAD_CAST text, length);
+    else
+        m_text.append (text, length);
+}
+
+/***********************************************************************/
+
+static gboolean
+stream_raw_start_handler (gpointer data_for_children, guint depth,
+                          const gchar* tag, const gchar** attrs)
+{
+    auto handler = static_cast<SixtpStreamHandler*> (data_for_children);
+    g_return_val_if_fail (handler, FALSE);
+    return handler->raw_start (depth, tag, attrs);
+}
+
+static gboolean
+stream_raw_end_handler (gpointer data_for_children, guint depth,
+                        const gchar* tag)
+{
+    auto handler = static_cast<SixtpStreamHandler*> (data_for_children);
+    g_return_val_if_fail (handler, FALSE);
+    return handler->raw_end (depth, tag);
+}
+
+static gboolean
+stream_raw_chars_handler (gpointer data_for_children, const char* text,
+                          int length)
+{
+    auto handler = static_cast<SixtpStreamHandler*> (data_for_children);
+    if (handler)
+        handler->raw_characters (text, length);
+    return TRUE;
+}
+
+static gboolean
+stream_end_handler (gpointer data_for_children,
+                    GSList* data_from_children, GSList* sibling_data,
+                    gpointer parent_data, gpointer global_data,
+                    gpointer* result, const gchar* tag)
+{
+    auto handler = static_cast<SixtpStreamHandler*> (data_for_children);
+
+    /* The end of the document's top frame, see sixtp_stream_parser_new. */
+    if (!tag || !handler)
+        return TRUE;
+
+    auto ok = handler->finish (global_data, result, tag);
+    delete handler;
+    return ok;
+}
+
+static void
+stream_fail_handler (gpointer data_for_children,
+                     GSList* data_from_children, GSList* sibling_data,
+                     gpointer parent_data, gpointer global_data,
+                     gpointer* result, const gchar* tag)
+{
+    delete static_cast<SixtpStreamHandler*> (data_for_children);
+}
+
+sixtp*
+sixtp_stream_parser_new (sixtp_start_handler starter,
+                         sixtp_result_handler cleanup_result,
+                         sixtp_result_handler result_fail)
+{
+    sixtp* top_level;
+
+    g_return_val_if_fail (starter, NULL);
+
+    if (! (top_level =
+               sixtp_set_any (sixtp_new (), FALSE,
+                              SIXTP_START_HANDLER_ID, starter,
+                              SIXTP_END_HANDLER_ID, stream_end_handler,
+                              SIXTP_FAIL_HANDLER_ID, stream_fail_handler,
+                              SIXTP_RAW_START_HANDLER_ID, stream_raw_start_handler,
+                              SIXTP_RAW_END_HANDLER_ID, stream_raw_end_handler,
+                              SIXTP_RAW_CHARACTERS_HANDLER_ID,
+                              stream_raw_chars_handler,
+                              SIXTP_NO_MORE_HANDLERS)))
+    {
+        return NULL;
+    }
+
+    if (cleanup_result)
+        sixtp_set_cleanup_result (top_level, cleanup_result);
+    if (result_fail)
+        sixtp_set_result_fail (top_level, result_fail);
+
+    if (!sixtp_add_sub_parser (top_level, SIXTP_MAGIC_CATCHER, top_level))
+    {
+        sixtp_destroy (top_level);
+        return NULL;
+    }
+
+    return top_level;
+}
+
+/***********************************************************************/
+
+bool
+sixtp_stream_guid_type_ok (const gchar** attrs)
+{
+    if (!attrs || !attrs[0])
+        return false;
+
+    if (strcmp (attrs[0], "type") != 0)
+    {
+        PERR ("Unknown attribute for id tag: %s", attrs[0]);
+        return false;
+    }
+
+    /* handle new and guid the same for the moment */
+    if (g_strcmp0 ("guid", attrs[1]) == 0 || g_strcmp0 ("new", attrs[1]) == 0)
+        return true;
+
+    PERR ("Unknown type %s for attribute type for tag %s",
+          attrs[1] ? attrs[1] : "(null)", attrs[0]);
+    return false;
+}
+
+GncGUID
+sixtp_stream_text_to_guid (const std::string& text)
+{
+    GncGUID guid;
+    if (!string_to_guid (text.c_str (), &guid))
+        guid = guid_new_return ();
+    return guid;
+}
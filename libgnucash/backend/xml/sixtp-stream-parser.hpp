@@ -0,0 +1,143 @@
+/********************************************************************
+ * sixtp-stream-parser.hpp -- sixtp nodes that parse an object      *
+ *                            without building a DOM tree.          *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+ ********************************************************************/
+
+#ifndef SIXTP_STREAM_PARSER_HPP
+#define SIXTP_STREAM_PARSER_HPP
+
+extern "C"
+{
+#include <glib.h>
+}
+
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+#include "sixtp.h"
+
+/* The objects that make up the bulk of a book -- transactions, splits
+   and prices -- are parsed straight from the SAX events instead of
+   going through sixtp_dom_parser_new() and dom_tree_generic_parse():
+   the object's element gets a single stack frame and a
+   SixtpStreamHandler, which is handed each descendant element as it
+   opens and closes.  Handlers dispatch on sixtp_tag_hash() of the tag,
+   checked against the handler's SixtpTagTable, and convert the
+   element's text in place, so neither DOM nodes nor intermediate
+   strings are created.
+
+   Subtrees with a recursive structure, i.e. slots, can still be
+   captured as a DOM fragment and converted with the dom_tree_*
+   functions. */
+
+/** FNV-1a hash of a tag name. It's constexpr so that the tags a handler
+ * knows can be case labels. */
+constexpr guint32
+sixtp_tag_hash (const char* tag)
+{
+    guint32 hash = 2166136261u;
+    for (; *tag; ++tag)
+        hash = (hash ^ static_cast<unsigned char> (*tag)) * 16777619u;
+    return hash;
+}
+
+/** The tags a handler dispatches on. Different tags can have the same
+ * sixtp_tag_hash(), so a tag whose hash is in the table but whose name
+ * isn't mustn't be taken for the one in the table. */
+class SixtpTagTable
+{
+public:
+    SixtpTagTable (std::initializer_list<const char*> tags);
+
+    /** The hash to dispatch @a tag on: sixtp_tag_hash() of it, or 0 if
+     * that's the hash of a different tag in the table. */
+    guint32 verified_hash (const char* tag) const;
+
+private:
+    std::vector<std::pair<guint32, const char*>> m_tags;
+};
+
+class SixtpStreamHandler
+{
+public:
+    /** @a tags must outlive the handler. */
+    explicit SixtpStreamHandler (const SixtpTagTable& tags) : m_tags{tags} {}
+    /** Frees a capture left unfinished by a failed parse. */
+    virtual ~SixtpStreamHandler ();
+
+    /** A descendant element opens; @a depth is 1 for the object's
+     * children. Call capture() to have the element's subtree built into a
+     * DOM tree and passed to end_captured() instead. */
+    virtual bool start_element (guint depth, guint32 hash, const gchar* tag,
+                                const gchar** attrs) = 0;
+    /** A descendant element closes. @a text is the character data seen
+     * since the last element opened, so for leaf elements their content. */
+    virtual bool end_element (guint depth, guint32 hash, const gchar* tag,
+                              const std::string& text) = 0;
+    /** A captured subtree is complete. @a node is freed on return. */
+    virtual bool end_captured (guint depth, guint32 hash, xmlNodePtr node);
+    /** The object's own element closes. Put the object, if any, in
+     * @a result; it's cleaned up by the sixtp's result handlers. */
+    virtual bool finish (gpointer global_data, gpointer* result,
+                         const gchar* tag) = 0;
+
+    bool raw_start (guint depth, const gchar* tag, const gchar** attrs);
+    bool raw_end (guint depth, const gchar* tag);
+    void raw_characters (const char* text, int length);
+
+protected:
+    void capture () { m_capture_requested = true; }
+    /** The hash of the element enclosing the one at @a depth, 0 if that's
+     * the object's own element. */
+    guint32 parent_hash (guint depth) const
+    {
+        return depth >= 2 && depth - 2 < m_path.size () ? m_path[depth - 2] : 0;
+    }
+
+private:
+    const SixtpTagTable& m_tags;
+    std::string m_text;
+    std::vector<guint32> m_path;
+    xmlNodePtr m_capture = nullptr;
+    guint m_capture_depth = 0;
+    bool m_capture_requested = false;
+};
+
+/** Create a sixtp node for an object parsed by a SixtpStreamHandler.
+ * @a starter must put a new handler into *data_for_children unless it's
+ * called for the document's top frame (tag is NULL), in which case it
+ * should do nothing; the node deletes the handler when done. The node is
+ * its own catch-all child parser, so it can also be used as the top
+ * level parser for a document containing a single object. */
+sixtp* sixtp_stream_parser_new (sixtp_start_handler starter,
+                                sixtp_result_handler cleanup_result,
+                                sixtp_result_handler result_fail);
+
+/** The attributes of a GUID element, like dom_tree_to_guid() checks
+ * them: the only accepted type is "guid" (or "new"). */
+bool sixtp_stream_guid_type_ok (const gchar** attrs);
+
+/** Convert the content of a GUID element. Like dom_tree_to_guid() an
+ * unparseable GUID gives a new one. */
+GncGUID sixtp_stream_text_to_guid (const std::string& text);
+
+#endif /* SIXTP_STREAM_PARSER_HPP */
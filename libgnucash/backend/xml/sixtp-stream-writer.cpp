@@ -0,0 +1,491 @@
+/********************************************************************
+ * sixtp-stream-writer.cpp -- write XML without building a DOM tree *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+ ********************************************************************/
+extern "C"
+{
+#include <config.h>
+
+#include <glib.h>
+#include <string.h>
+}
+
+#include "sixtp-stream-writer.hpp"
+#include "sixtp-dom-generators.h"
+
+#include <kvp-frame.hpp>
+#include <gnc-datetime.hpp>
+#include <algorithm>
+
+static QofLogModule log_module = GNC_MOD_IO;
+
+/* libxml2 doesn't indent deeper than MAX_INDENT / 2 levels. */
+static const size_t max_indent_level = 30;
+
+void
+SixtpStreamWriter::close_start_tag ()
+{
+    if (m_stack.empty () || !m_stack.back ().start_open)
+        return;
+    m_stack.back ().start_open = false;
+    m_buf += '>';
+}
+
+void
+SixtpStreamWriter::indent (size_t level)
+{
+    m_buf.append (2 * std::min (level, max_indent_level), ' ');
+}
+
+void
+SixtpStreamWriter::start_element (const char* tag)
+{
+    bool format = true;
+
+    if (!m_stack.empty ())
+    {
+        auto& parent = m_stack.back ();
+        format = parent.format;
+        if (parent.start_open)
+        {
+            close_start_tag ();
+            if (format)
+                m_buf += '\n';
+        }
+        if (format)
+            indent (m_stack.size ());
+    }
+    m_buf += '<';
+    m_buf += tag;
+    m_stack.push_back ({tag, true, format});
+}
+
+void
+SixtpStreamWriter::attribute (const char* name, const char* value)
+{
+    g_return_if_fail (!m_stack.empty () && m_stack.back ().start_open);
+
+    m_buf += ' ';
+    m_buf += name;
+    m_buf += "=\"";
+    /* As xmlBufAttrSerializeTxtContent() escapes it without a document. */
+    for (auto p = value; *p;)
+    {
+        auto c = static_cast<unsigned char> (*p);
+        switch (c)
+        {
+        case '<': m_buf += "&lt;"; break;
+        case '>': m_buf += "&gt;"; break;
+        case '&': m_buf += "&amp;"; break;
+        case '"': m_buf += "&quot;"; break;
+        case '\n': m_buf += "&#10;"; break;
+        case '\r': m_buf += "&#13;"; break;
+        case '\t': m_buf += "&#9;"; break;
+        default:
+            if (c < 0x80)
+            {
+                m_buf += *p;
+                break;
+            }
+            else
+            {
+                char ref[16];
+                auto next = g_utf8_next_char (p);
+                g_snprintf (ref, sizeof (ref), "&#x%X;", g_utf8_get_char (p));
+                m_buf += ref;
+                p = next;
+                continue;
+            }
+        }
+        ++p;
+    }
+    m_buf += '"';
+}
+
+void
+SixtpStreamWriter::end_element ()
+{
+    g_return_if_fail (!m_stack.empty ());
+
+    auto elem = m_stack.back ();
+    m_stack.pop_back ();
+    if (elem.start_open)
+    {
+        m_buf += "/>";
+    }
+    else
+    {
+        if (elem.format)
+            indent (m_stack.size ());
+        m_buf += "</";
+        m_buf += elem.tag;
+        m_buf += '>';
+    }
+    if (!m_stack.empty () && m_stack.back ().format)
+        m_buf += '\n';
+}
+
+/* Text gets what checked_char_cast() does to it followed by what
+ * xmlEscapeContent() does. */
+void
+SixtpStreamWriter::text (const char* text)
+{
+    close_start_tag ();
+    m_stack.back ().format = false;
+
+    auto p = text;
+    while (*p)
+    {
+        const gchar* end;
+        g_utf8_validate (p, -1, &end);
+        for (; p < end; ++p)
+        {
+            auto c = *p;
+            switch (c)
+            {
+            case '<': m_buf += "&lt;"; break;
+            case '>': m_buf += "&gt;"; break;
+            case '&': m_buf += "&amp;"; break;
+            case '\r': m_buf += "&#13;"; break;
+            default:
+                if (c > 0 && c < 0x20 && c != '\t' && c != '\n')
+                    m_buf += '?';
+                else
+                    m_buf += c;
+                break;
+            }
+        }
+        if (!*p)
+            break;
+        /* An invalid UTF-8 byte. */
+        m_buf += '?';
+        ++p;
+    }
+}
+
+void
+SixtpStreamWriter::text_element (const char* tag, const char* text)
+{
+    start_element (tag);
+    if (text)
+        this->text (text);
+    end_element ();
+}
+
+void
+SixtpStreamWriter::content_element (const char* tag, const char* text)
+{
+    g_return_if_fail (tag);
+    g_return_if_fail (text);
+    text_element (tag, *text ? text : NULL);
+}
+
+void
+SixtpStreamWriter::append_int (gint64 val)
+{
+    char buf[24];
+    auto end = buf + sizeof (buf);
+    auto p = end;
+    /* Negate as unsigned so that INT64_MIN works. */
+    guint64 u = val < 0 ? 0 - static_cast<guint64> (val) : val;
+
+    do
+    {
+        *--p = '0' + u % 10;
+        u /= 10;
+    }
+    while (u);
+    if (val < 0)
+        *--p = '-';
+    close_start_tag ();
+    m_stack.back ().format = false;
+    m_buf.append (p, end - p);
+}
+
+void
+SixtpStreamWriter::int_element (const char* tag, gint64 val)
+{
+    start_element (tag);
+    append_int (val);
+    end_element ();
+}
+
+void
+SixtpStreamWriter::guid_element (const char* tag, const GncGUID* guid)
+{
+    char guid_str[GUID_ENCODING_LENGTH + 1];
+
+    if (!guid_to_string_buff (guid, guid_str))
+    {
+        PERR ("guid_to_string_buff failed\n");
+        return;
+    }
+    start_element (tag);
+    attribute ("type", "guid");
+    text (guid_str);
+    end_element ();
+}
+
+void
+SixtpStreamWriter::commodity_ref_element (const char* tag,
+                                          const gnc_commodity* c)
+{
+    g_return_if_fail (c);
+
+    auto name_space = gnc_commodity_get_namespace (c);
+    auto mnemonic = gnc_commodity_get_mnemonic (c);
+    if (!name_space || !mnemonic)
+        return;
+    start_element (tag);
+    text_element ("cmdty:space", name_space);
+    text_element ("cmdty:id", mnemonic);
+    end_element ();
+}
+
+/* What time64_to_dom_tree() makes of @a time, for the years that
+ * boost::gregorian supports; @return the length or 0 outside of them. */
+static size_t
+format_utc_time (time64 time, char* buf)
+{
+    /* See Howard Hinnant's civil_from_days(). */
+    auto days = time / 86400;
+    auto secs = time % 86400;
+    if (secs < 0)
+    {
+        secs += 86400;
+        --days;
+    }
+    auto z = days + 719468;
+    auto era = (z >= 0 ? z : z - 146096) / 146097;
+    auto doe = z - era * 146097;
+    auto yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    auto doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    auto mp = (5 * doy + 2) / 153;
+    auto day = doy - (153 * mp + 2) / 5 + 1;
+    auto month = mp < 10 ? mp + 3 : mp - 9;
+    auto year = yoe + era * 400 + (month <= 2);
+
+    if (year < 1400 || year > 9999)
+        return 0;
+
+    auto put2 = [] (char* p, int64_t v)
+    {
+        p[0] = '0' + v / 10;
+        p[1] = '0' + v % 10;
+    };
+    put2 (buf, year / 100);
+    put2 (buf + 2, year % 100);
+    buf[4] = '-';
+    put2 (buf + 5, month);
+    buf[7] = '-';
+    put2 (buf + 8, day);
+    buf[10] = ' ';
+    put2 (buf + 11, secs / 3600);
+    buf[13] = ':';
+    put2 (buf + 14, secs / 60 % 60);
+    buf[16] = ':';
+    put2 (buf + 17, secs % 60);
+    memcpy (buf + 19, " +0000", 7);
+    return 25;
+}
+
+void
+SixtpStreamWriter::append_time64 (const char* tag, time64 time,
+                                  const char* type)
+{
+    char buf[32];
+
+    g_return_if_fail (time != INT64_MAX);
+    if (!format_utc_time (time, buf))
+    {
+        auto date_str = GncDateTime (time).format_iso8601 ();
+        if (date_str.empty ())
+            return;
+        date_str += " +0000";
+        g_strlcpy (buf, date_str.c_str (), sizeof (buf));
+    }
+    start_element (tag);
+    if (type)
+        attribute ("type", type);
+    text_element ("ts:date", buf);
+    end_element ();
+}
+
+void
+SixtpStreamWriter::time64_element (const char* tag, time64 time)
+{
+    append_time64 (tag, time, NULL);
+}
+
+void
+SixtpStreamWriter::gdate_element (const char* tag, const GDate* date)
+{
+    char date_str[512];
+
+    g_return_if_fail (date);
+    g_date_strftime (date_str, sizeof (date_str), "%Y-%m-%d", date);
+    start_element (tag);
+    text_element ("gdate", date_str);
+    end_element ();
+}
+
+void
+SixtpStreamWriter::numeric_element (const char* tag, gnc_numeric num)
+{
+    start_element (tag);
+    append_int (num.num);
+    m_buf += '/';
+    append_int (num.denom);
+    end_element ();
+}
+
+/* Like add_text_to_node(): a typed value whose content is set with
+ * xmlNodeSetContent(), so an empty one has no text child. */
+void
+SixtpStreamWriter::append_kvp_typed (const char* tag, const char* type,
+                                     const char* content)
+{
+    start_element (tag);
+    attribute ("type", type);
+    if (content && *content)
+        text (content);
+    end_element ();
+}
+
+void
+SixtpStreamWriter::append_kvp_value (const char* tag, const KvpValue* val)
+{
+    switch (val->get_type ())
+    {
+    case KvpValue::Type::STRING:
+        start_element (tag);
+        attribute ("type", "string");
+        if (auto str = val->get<const char*> ())
+            text (str);
+        end_element ();
+        break;
+    case KvpValue::Type::INT64:
+        start_element (tag);
+        attribute ("type", "integer");
+        append_int (val->get<int64_t> ());
+        end_element ();
+        break;
+    case KvpValue::Type::DOUBLE:
+    {
+        auto str = double_to_string (val->get<double> ());
+        append_kvp_typed (tag, "double", str);
+        g_free (str);
+        break;
+    }
+    case KvpValue::Type::NUMERIC:
+    {
+        auto num = val->get<gnc_numeric> ();
+        start_element (tag);
+        attribute ("type", "numeric");
+        append_int (num.num);
+        m_buf += '/';
+        append_int (num.denom);
+        end_element ();
+        break;
+    }
+    case KvpValue::Type::GUID:
+    {
+        gchar guidstr[GUID_ENCODING_LENGTH + 1] = "";
+        guid_to_string_buff (val->get<GncGUID*> (), guidstr);
+        append_kvp_typed (tag, "guid", guidstr);
+        break;
+    }
+    /* Note: The type attribute must remain 'timespec' to maintain
+     * compatibility.
+     */
+    case KvpValue::Type::TIME64:
+        append_time64 (tag, val->get<Time64> ().t, "timespec");
+        break;
+    case KvpValue::Type::GDATE:
+    {
+        char date_str[512];
+        auto d = val->get<GDate> ();
+        g_date_strftime (date_str, sizeof (date_str), "%Y-%m-%d", &d);
+        start_element (tag);
+        attribute ("type", "gdate");
+        text_element ("gdate", date_str);
+        end_element ();
+        break;
+    }
+    case KvpValue::Type::GLIST:
+        start_element (tag);
+        attribute ("type", "list");
+        for (auto cursor = val->get<GList*> (); cursor; cursor = cursor->next)
+            append_kvp_value ("slot:value",
+                              static_cast<KvpValue*> (cursor->data));
+        end_element ();
+        break;
+    case KvpValue::Type::FRAME:
+    {
+        start_element (tag);
+        attribute ("type", "frame");
+        if (auto frame = val->get<KvpFrame*> ())
+            frame->for_each_slot_temp ([this] (const char* key, KvpValue* v)
+            {
+                append_kvp_slot (key, v);
+            });
+        end_element ();
+        break;
+    }
+    default:
+        start_element (tag);
+        end_element ();
+        break;
+    }
+}
+
+void
+SixtpStreamWriter::append_kvp_slot (const char* key, const KvpValue* val)
+{
+    start_element ("slot");
+    text_element ("slot:key", key);
+    append_kvp_value ("slot:value", val);
+    end_element ();
+}
+
+void
+SixtpStreamWriter::slots_element (const char* tag, const QofInstance* inst)
+{
+    KvpFrame* frame = qof_instance_get_slots (inst);
+    if (!frame || frame->empty ())
+        return;
+
+    start_element (tag);
+    frame->for_each_slot_temp ([this] (const char* key, KvpValue* v)
+    {
+        append_kvp_slot (key, v);
+    });
+    end_element ();
+}
+
+bool
+SixtpStreamWriter::flush (FILE* out)
+{
+    g_return_val_if_fail (m_stack.empty (), false);
+
+    auto ok = fwrite (m_buf.data (), 1, m_buf.size (), out) == m_buf.size ();
+    m_buf.clear ();
+    return ok && !ferror (out);
+}
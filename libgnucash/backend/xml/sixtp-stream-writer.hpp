@@ -0,0 +1,104 @@
+/********************************************************************
+ * sixtp-stream-writer.hpp -- write XML without building a DOM tree *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+ ********************************************************************/
+
+#ifndef SIXTP_STREAM_WRITER_HPP
+#define SIXTP_STREAM_WRITER_HPP
+
+extern "C"
+{
+#include <glib.h>
+#include <stdio.h>
+
+#include "gnc-commodity.h"
+#include "qof.h"
+}
+
+#include <string>
+#include <vector>
+
+/* The writing counterpart of sixtp-stream-parser.hpp: the objects that
+   make up the bulk of a book are appended to a text buffer as they're
+   visited instead of being built into a DOM tree with the
+   sixtp-dom-generators functions and serialized with xmlElemDump().
+
+   The output is byte for byte what xmlElemDump() makes of the tree that
+   the corresponding *_dom_tree_create function builds: elements with
+   element children are indented two spaces per level, text is cleaned
+   up like checked_char_cast() does and escaped the way libxml2 escapes
+   it, and the text of leaf elements is never reformatted. Keep the two
+   in step; test-xml-transaction and test-xml-account compare them. */
+
+class SixtpStreamWriter
+{
+public:
+    SixtpStreamWriter () = default;
+
+    /** Open an element. Attributes can be added until anything else is
+     * written. @a tag must remain valid until the element is closed. */
+    void start_element (const char* tag);
+    void attribute (const char* name, const char* value);
+    void end_element ();
+
+    /** Like xmlNewTextChild(): an element containing @a text. An empty
+     * string gives <tag></tag>, NULL gives <tag/>. */
+    void text_element (const char* tag, const char* text);
+    /** Like text_to_dom_tree(): an empty string gives <tag/>. */
+    void content_element (const char* tag, const char* text);
+
+    /* The equivalents of the sixtp-dom-generators functions. */
+    void int_element (const char* tag, gint64 val);
+    void guid_element (const char* tag, const GncGUID* guid);
+    void commodity_ref_element (const char* tag, const gnc_commodity* c);
+    void time64_element (const char* tag, time64 time);
+    void gdate_element (const char* tag, const GDate* date);
+    void numeric_element (const char* tag, gnc_numeric num);
+    void slots_element (const char* tag, const QofInstance* inst);
+
+    /** Write out the buffered text, which must consist of complete
+     * elements, and clear the buffer. @return false on a write error. */
+    bool flush (FILE* out);
+    const std::string& str () const noexcept { return m_buf; }
+    void clear () noexcept { m_buf.clear (); }
+
+private:
+    struct Element
+    {
+        const char* tag;
+        bool start_open;        // The '>' of the start tag isn't written yet.
+        bool format;            // No text in this element, so indent.
+    };
+
+    void close_start_tag ();
+    void indent (size_t level);
+    void text (const char* text);
+    void append_int (gint64 val);
+    void append_time64 (const char* tag, time64 time, const char* type);
+    void append_kvp_value (const char* tag, const KvpValue* val);
+    void append_kvp_slot (const char* key, const KvpValue* val);
+    void append_kvp_typed (const char* tag, const char* type,
+                           const char* content);
+
+    std::string m_buf;
+    std::vector<Element> m_stack;
+};
+
+#endif /* SIXTP_STREAM_WRITER_HPP */
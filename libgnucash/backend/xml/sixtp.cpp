@@ -144,6 +144,24 @@ sixtp_set_chars_fail (sixtp* parser, sixtp_result_handler handler)
     parser->chars_fail_handler = handler;
 }
 
+void
+sixtp_set_raw_start (sixtp* parser, sixtp_raw_start_handler handler)
+{
+    parser->raw_start_handler = handler;
+}
+
+void
+sixtp_set_raw_end (sixtp* parser, sixtp_raw_end_handler handler)
+{
+    parser->raw_end_handler = handler;
+}
+
+void
+sixtp_set_raw_chars (sixtp* parser, sixtp_raw_characters_handler handler)
+{
+    parser->raw_characters_handler = handler;
+}
+
 sixtp*
 sixtp_new (void)
 {
@@ -229,6 +247,19 @@ sixtp_set_any (sixtp* tochange, int cleanup, ...)
             sixtp_set_chars_fail (tochange, va_arg (ap, sixtp_result_handler));
             break;
 
+        case SIXTP_RAW_START_HANDLER_ID:
+            sixtp_set_raw_start (tochange, va_arg (ap, sixtp_raw_start_handler));
+            break;
+
+        case SIXTP_RAW_END_HANDLER_ID:
+            sixtp_set_raw_end (tochange, va_arg (ap, sixtp_raw_end_handler));
+            break;
+
+        case SIXTP_RAW_CHARACTERS_HANDLER_ID:
+            sixtp_set_raw_chars (tochange,
+                                 va_arg (ap, sixtp_raw_characters_handler));
+            break;
+
         default:
             va_end (ap);
             g_critical ("Bogus sixtp type %d", type);
@@ -399,6 +430,17 @@ sixtp_sax_start_handler (void* user_data,
     current_frame = (sixtp_stack_frame*) pdata->stack->data;
     current_parser = current_frame->parser;
 
+    if (current_parser->raw_start_handler && current_frame->tag)
+    {
+        current_frame->raw_depth++;
+        pdata->parsing_ok &=
+            current_parser->raw_start_handler (current_frame->data_for_children,
+                                               current_frame->raw_depth,
+                                               (gchar*) name,
+                                               (const gchar**) attrs);
+        return;
+    }
+
     /* Use an extended lookup so we can get *our* copy of the key.
        Since we've strduped it, we know its lifetime... */
     lookup_success =
@@ -477,6 +519,14 @@ sixtp_sax_characters_handler (void* user_data, const xmlChar* text, int len)
     sixtp_stack_frame* frame;
 
     frame = (sixtp_stack_frame*) pdata->stack->data;
+    if (frame->parser->raw_characters_handler && frame->tag)
+    {
+        pdata->parsing_ok &=
+            frame->parser->raw_characters_handler (frame->data_for_children,
+                                                   (gchar*) text, len);
+        return;
+    }
+
     if (frame->parser->characters_handler)
     {
         gpointer result = NULL;
@@ -515,6 +565,20 @@ sixtp_sax_end_handler (void* user_data, const xmlChar* name)
     gchar* end_tag = NULL;
 
     current_frame = (sixtp_stack_frame*) pdata->stack->data;
+
+    if (current_frame->raw_depth > 0)
+    {
+        /* libxml2 has already checked that the tags balance. */
+        if (current_frame->parser->raw_end_handler)
+            pdata->parsing_ok &=
+                current_frame->parser->raw_end_handler (
+                    current_frame->data_for_children,
+                    current_frame->raw_depth,
+                    (gchar*) name);
+        current_frame->raw_depth--;
+        return;
+    }
+
     parent_frame = (sixtp_stack_frame*) pdata->stack->next->data;
 
     /* time to make sure we got the right closing tag.  Is this really
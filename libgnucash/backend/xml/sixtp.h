@@ -126,6 +126,25 @@ typedef void (*sixtp_fail_handler) (gpointer data_for_children,
 typedef void (*sixtp_push_handler) (xmlParserCtxtPtr xml_context,
                                     gpointer user_data);
 
+/* Raw handlers let a node take over all of its descendant elements
+   itself: once set, the descendants get neither stack frames nor child
+   parsers, their start, end and character events are passed straight
+   to these handlers along with the node's data_for_children.  depth is 1
+   for the node's direct children.  They're not used for the document's
+   top frame, which has no element of its own. */
+typedef gboolean (*sixtp_raw_start_handler) (gpointer data_for_children,
+                                             guint depth,
+                                             const gchar* tag,
+                                             const gchar** attrs);
+
+typedef gboolean (*sixtp_raw_end_handler) (gpointer data_for_children,
+                                           guint depth,
+                                           const gchar* tag);
+
+typedef gboolean (*sixtp_raw_characters_handler) (gpointer data_for_children,
+                                                  const char* text,
+                                                  int length);
+
 typedef struct sixtp
 {
     /* If you change this, don't forget to modify all the copy/etc. functions */
@@ -148,6 +167,10 @@ typedef struct sixtp
     /* called to cleanup character results when cleaning up this node's
        children. */
 
+    sixtp_raw_start_handler raw_start_handler;
+    sixtp_raw_end_handler raw_end_handler;
+    sixtp_raw_characters_handler raw_characters_handler;
+
     GHashTable* child_parsers;
 } sixtp;
 
@@ -169,6 +192,10 @@ typedef enum
     SIXTP_RESULT_FAIL_ID,
 
     SIXTP_CHARS_FAIL_ID,
+
+    SIXTP_RAW_START_HANDLER_ID,
+    SIXTP_RAW_END_HANDLER_ID,
+    SIXTP_RAW_CHARACTERS_HANDLER_ID,
 } sixtp_handler_type;
 
 /* completely invalid tag for xml */
@@ -242,6 +269,9 @@ void sixtp_set_cleanup_chars (sixtp* parser, sixtp_result_handler handler);
 void sixtp_set_fail (sixtp* parser, sixtp_fail_handler handler);
 void sixtp_set_result_fail (sixtp* parser, sixtp_result_handler handler);
 void sixtp_set_chars_fail (sixtp* parser, sixtp_result_handler handler);
+void sixtp_set_raw_start (sixtp* parser, sixtp_raw_start_handler handler);
+void sixtp_set_raw_end (sixtp* parser, sixtp_raw_end_handler handler);
+void sixtp_set_raw_chars (sixtp* parser, sixtp_raw_characters_handler handler);
 
 sixtp* sixtp_set_any (sixtp* tochange, gboolean cleanup, ...);
 sixtp* sixtp_add_some_sub_parsers (sixtp* tochange, gboolean cleanup, ...);
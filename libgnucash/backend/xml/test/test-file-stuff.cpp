@@ -105,6 +105,123 @@ write_dom_node_to_file (xmlNodePtr node, int fd)
     fclose (out);
 }
 
+static gboolean
+blank_text_node (xmlNodePtr node)
+{
+    if (node->type != XML_TEXT_NODE)
+        return FALSE;
+    for (auto p = node->content; p && *p; ++p)
+        if (!g_ascii_isspace (*p))
+            return FALSE;
+    return TRUE;
+}
+
+/* The next child from node on that isn't the whitespace between
+ * elements. */
+static xmlNodePtr
+skip_blanks (xmlNodePtr node)
+{
+    while (node && blank_text_node (node))
+        node = node->next;
+    return node;
+}
+
+static gboolean
+has_element_children (xmlNodePtr node)
+{
+    for (auto child = node->children; child; child = child->next)
+        if (child->type == XML_ELEMENT_NODE)
+            return TRUE;
+    return FALSE;
+}
+
+static gboolean
+strings_equal (const char* what, xmlNodePtr node, xmlChar* a, xmlChar* b)
+{
+    auto ret = g_strcmp0 ((const char*)a, (const char*)b) == 0;
+    if (!ret)
+        printf ("%s of %s differs: \"%s\" vs \"%s\"\n", what,
+                (const char*)node->name, (const char*)a, (const char*)b);
+    xmlFree (a);
+    xmlFree (b);
+    return ret;
+}
+
+static gboolean
+dom_nodes_equal (xmlNodePtr a, xmlNodePtr b)
+{
+    if (a->type != b->type)
+    {
+        printf ("%s and %s are different kinds of node\n",
+                (const char*)a->name, (const char*)b->name);
+        return FALSE;
+    }
+    if (a->type != XML_ELEMENT_NODE)
+        return strings_equal ("Content", a, xmlNodeGetContent (a),
+                              xmlNodeGetContent (b));
+    if (g_strcmp0 ((const char*)a->name, (const char*)b->name))
+    {
+        printf ("Element %s vs %s\n", (const char*)a->name,
+                (const char*)b->name);
+        return FALSE;
+    }
+
+    auto attr_a = a->properties, attr_b = b->properties;
+    for (; attr_a && attr_b; attr_a = attr_a->next, attr_b = attr_b->next)
+        if (!strings_equal ("Attribute name", a,
+                            xmlStrdup (attr_a->name), xmlStrdup (attr_b->name)) ||
+            !strings_equal ("Attribute value", a,
+                            xmlNodeListGetString (a->doc, attr_a->children, 1),
+                            xmlNodeListGetString (b->doc, attr_b->children, 1)))
+            return FALSE;
+    if (attr_a || attr_b)
+    {
+        printf ("%s has different attributes\n", (const char*)a->name);
+        return FALSE;
+    }
+
+    /* Text, with its entities and character references resolved. */
+    if (!has_element_children (a) && !has_element_children (b))
+        return strings_equal ("Text", a, xmlNodeGetContent (a),
+                              xmlNodeGetContent (b));
+
+    auto child_a = skip_blanks (a->children), child_b = skip_blanks (b->children);
+    for (; child_a && child_b;
+         child_a = skip_blanks (child_a->next), child_b = skip_blanks (child_b->next))
+        if (!dom_nodes_equal (child_a, child_b))
+            return FALSE;
+    if (child_a || child_b)
+    {
+        printf ("%s has different children\n", (const char*)a->name);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+gboolean
+dom_tree_equals_xml (xmlNodePtr node, const char* str)
+{
+    /* The streamed fragment uses the namespace prefixes without declaring
+     * them, as the DOM tree does, so its elements get the same names. */
+    auto doc = xmlReadMemory (str, strlen (str), NULL, "UTF-8",
+                              XML_PARSE_NOERROR | XML_PARSE_NOWARNING |
+                              XML_PARSE_NONET);
+    auto root = doc ? xmlDocGetRootElement (doc) : nullptr;
+    auto ret = root && dom_nodes_equal (node, root);
+
+    if (!ret)
+    {
+        xmlBufferPtr buf = xmlBufferCreate ();
+        xmlNodeDump (buf, NULL, node, 0, 1);
+        printf ("DOM tree:\n%s\nStreamed:\n%s\n",
+                (const char*) xmlBufferContent (buf), str);
+        xmlBufferFree (buf);
+    }
+    if (doc)
+        xmlFreeDoc (doc);
+    return ret;
+}
+
 gboolean
 print_dom_tree (gpointer data_for_children, GSList* data_from_children,
                 GSList* sibling_data, gpointer parent_data,
@@ -41,6 +41,10 @@ typedef struct KvpFrameImpl KvpFrame;
 #endif
 
 void write_dom_node_to_file (xmlNodePtr node, int fd);
+/* Whether @a str, parsed, is the same tree as @a node: the same
+ * elements, attributes, text and comments, whatever the escaping and
+ * the whitespace between elements. */
+gboolean dom_tree_equals_xml (xmlNodePtr node, const char* str);
 
 int files_compare (const gchar* f1, const gchar* f2);
 
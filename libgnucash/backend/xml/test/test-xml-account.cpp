@@ -43,6 +43,7 @@ extern "C"
 #include "../gnc-xml.h"
 #include "../sixtp-parsers.h"
 #include "../sixtp-dom-parsers.h"
+#include "../sixtp-stream-writer.hpp"
 #include "test-file-stuff.h"
 #include <test-stuff.h>
 
@@ -270,6 +271,13 @@ test_account (int i, Account* test_act)
         success ("account_xml");
     }
 
+    {
+        SixtpStreamWriter writer;
+        gnc_account_write_xml (writer, test_act, FALSE, TRUE);
+        do_test (dom_tree_equals_xml (test_node, writer.str ().c_str ()),
+                 "streamed account differs from its DOM tree");
+    }
+
     filename1 = g_strdup_printf ("test_file_XXXXXX");
 
     fd = g_mkstemp (filename1);
@@ -346,6 +354,21 @@ test_generation ()
         delete_random_account (act);
     }
 
+    {
+        /* Markup characters, which have to be escaped, and text that
+         * isn't ASCII, which the DOM dump writes as character references
+         * but the streamed output leaves as UTF-8. */
+        Account* act = get_random_account (sixbook);
+
+        xaccAccountSetName (act, "Caf\xc3\xa9 <R&D> \"Fonds\" 'd\xe2\x80\x99\xc3\xa9t\xc3\xa9'");
+        xaccAccountSetCode (act, "A&B;<1>]]>");
+        xaccAccountSetDescription (act, "\xe2\x82\xac" "100 > \xc2\xa3" "80 \xe6\xbc\xa2\xe5\xad\x97 &amp;");
+
+        test_account (-2, act);
+
+        delete_random_account (act);
+    }
+
     /*     { */
     /*         Account *act1; */
     /*         Account *act2; */
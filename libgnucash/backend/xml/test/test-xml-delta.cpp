@@ -0,0 +1,341 @@
+/********************************************************************
+ * test-xml-delta.cpp: Test incremental saves of XML data files.    *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+\********************************************************************/
+extern "C"
+{
+#include <config.h>
+#include <string.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <utime.h>
+
+#include <cashobjects.h>
+#include <TransLog.h>
+#include <gnc-engine.h>
+#include <gnc-prefs.h>
+#include <Account.h>
+#include <Transaction.h>
+#include <gnc-pricedb.h>
+}
+
+#include <test-stuff.h>
+
+#define GNC_LIB_NAME "gncmod-backend-xml"
+#define GNC_LIB_REL_PATH "xml"
+
+static Account*
+make_account (QofBook* book, const char* name)
+{
+    auto table = gnc_commodity_table_get_table (book);
+    auto acc = xaccMallocAccount (book);
+
+    xaccAccountBeginEdit (acc);
+    xaccAccountSetName (acc, name);
+    xaccAccountSetType (acc, ACCT_TYPE_BANK);
+    xaccAccountSetCommodity (acc, gnc_commodity_table_lookup (
+                                 table, GNC_COMMODITY_NS_CURRENCY, "USD"));
+    gnc_account_append_child (gnc_book_get_root_account (book), acc);
+    xaccAccountCommitEdit (acc);
+    return acc;
+}
+
+static void
+set_account_name (Account* acc, const char* name)
+{
+    xaccAccountBeginEdit (acc);
+    xaccAccountSetName (acc, name);
+    xaccAccountCommitEdit (acc);
+}
+
+static Transaction*
+make_transaction (QofBook* book, Account* from, Account* to, gint64 amount)
+{
+    auto trans = xaccMallocTransaction (book);
+    auto value = gnc_numeric_create (amount, 100);
+
+    xaccTransBeginEdit (trans);
+    xaccTransSetCurrency (trans, xaccAccountGetCommodity (from));
+    xaccTransSetDatePostedSecsNormalized (trans, gnc_time (NULL));
+    xaccTransSetDescription (trans, "delta test");
+    for (auto acc : { from, to })
+    {
+        auto split = xaccMallocSplit (book);
+        xaccSplitSetParent (split, trans);
+        xaccSplitSetAccount (split, acc);
+        xaccSplitSetValue (split, value);
+        xaccSplitSetAmount (split, value);
+        value = gnc_numeric_neg (value);
+    }
+    xaccTransCommitEdit (trans);
+    return trans;
+}
+
+static GNCPrice*
+make_price (QofBook* book, time64 time, gint64 value)
+{
+    auto table = gnc_commodity_table_get_table (book);
+    auto price = gnc_price_create (book);
+
+    gnc_price_begin_edit (price);
+    gnc_price_set_commodity (price, gnc_commodity_table_lookup (
+                                 table, GNC_COMMODITY_NS_CURRENCY, "EUR"));
+    gnc_price_set_currency (price, gnc_commodity_table_lookup (
+                                table, GNC_COMMODITY_NS_CURRENCY, "USD"));
+    gnc_price_set_time64 (price, time);
+    gnc_price_set_source (price, PRICE_SOURCE_USER_PRICE);
+    gnc_price_set_value (price, gnc_numeric_create (value, 100));
+    gnc_price_commit_edit (price);
+    gnc_pricedb_add_price (gnc_pricedb_get_db (book), price);
+    gnc_price_unref (price);
+    return price;
+}
+
+static gchar*
+file_contents (const char* filename)
+{
+    gchar* contents = NULL;
+    g_file_get_contents (filename, &contents, NULL, NULL);
+    return contents;
+}
+
+static void
+test_delta_round_trip (const char* filename)
+{
+    auto delta = g_strconcat (filename, ".delta", (gchar*)NULL);
+    GncGUID acc_guid, kept_guid, gone_guid, new_price_guid, old_price_guid;
+    auto now = gnc_time (NULL);
+
+    gnc_prefs_set_file_save_delta (FALSE);
+    auto session = qof_session_new (nullptr);
+    qof_session_begin (session, filename, SESSION_NEW_OVERWRITE);
+    auto book = qof_session_get_book (session);
+    auto checking = make_account (book, "Checking");
+    auto savings = make_account (book, "Savings");
+    auto gone = make_transaction (book, checking, savings, 1000);
+    auto old_price = make_price (book, now - 7 * 86400, 110);
+    qof_session_save (session, NULL);
+    do_test (qof_session_get_error (session) == ERR_BACKEND_NO_ERR,
+             "full save");
+    auto saved = file_contents (filename);
+
+    /* Rename an account, add a transaction and delete one, and replace
+     * a price. */
+    gnc_prefs_set_file_save_delta (TRUE);
+    set_account_name (checking, "Current");
+    auto kept = make_transaction (book, checking, savings, 250);
+    acc_guid = *xaccAccountGetGUID (checking);
+    kept_guid = *xaccTransGetGUID (kept);
+    gone_guid = *xaccTransGetGUID (gone);
+    xaccTransBeginEdit (gone);
+    xaccTransDestroy (gone);
+    xaccTransCommitEdit (gone);
+    old_price_guid = *gnc_price_get_guid (old_price);
+    new_price_guid = *gnc_price_get_guid (make_price (book, now, 120));
+    gnc_pricedb_remove_price (gnc_pricedb_get_db (book), old_price);
+    qof_session_save (session, NULL);
+    do_test (qof_session_get_error (session) == ERR_BACKEND_NO_ERR,
+             "delta save");
+    do_test (g_file_test (delta, G_FILE_TEST_EXISTS), "delta file written");
+    auto unchanged = file_contents (filename);
+    do_test (saved && unchanged && strcmp (saved, unchanged) == 0,
+             "data file left alone by a delta save");
+    g_free (saved);
+    g_free (unchanged);
+    qof_session_end (session);
+    qof_session_destroy (session);
+
+    session = qof_session_new (nullptr);
+    qof_session_begin (session, filename, SESSION_NORMAL_OPEN);
+    qof_session_load (session, NULL);
+    book = qof_session_get_book (session);
+    do_test (qof_session_get_error (session) == ERR_BACKEND_NO_ERR,
+             "load with delta");
+    checking = xaccAccountLookup (&acc_guid, book);
+    do_test (checking && g_strcmp0 (xaccAccountGetName (checking), "Current") == 0,
+             "account change replayed");
+    kept = xaccTransLookup (&kept_guid, book);
+    do_test (kept && xaccTransCountSplits (kept) == 2,
+             "new transaction replayed");
+    do_test (xaccTransLookup (&gone_guid, book) == NULL,
+             "deleted transaction replayed");
+    do_test (checking && gnc_numeric_equal (xaccAccountGetBalance (checking),
+                                            gnc_numeric_create (250, 100)),
+             "balance after replay");
+    auto new_price = gnc_price_lookup (&new_price_guid, book);
+    do_test (new_price && gnc_numeric_equal (gnc_price_get_value (new_price),
+                                             gnc_numeric_create (120, 100)),
+             "new price replayed");
+    do_test (gnc_price_lookup (&old_price_guid, book) == NULL,
+             "removed price replayed");
+    do_test (gnc_pricedb_get_num_prices (gnc_pricedb_get_db (book)) == 1,
+             "price count after replay");
+
+    do_test (!qof_book_session_not_saved (book), "book clean after replay");
+
+    /* A full save folds the delta into the data file. */
+    gnc_prefs_set_file_save_delta (FALSE);
+    set_account_name (checking, "Checking");
+    qof_session_save (session, NULL);
+    do_test (!g_file_test (delta, G_FILE_TEST_EXISTS),
+             "delta removed by a full save");
+    qof_session_end (session);
+    qof_session_destroy (session);
+
+    g_free (delta);
+}
+
+static gint64
+file_size (const char* filename)
+{
+    GStatBuf statbuf;
+    return g_stat (filename, &statbuf) == 0 ? statbuf.st_size : -1;
+}
+
+/* Open @a filename, replaying its delta, and check the name of the account
+ * @a guid and whether the delta was moved aside as unusable. */
+static void
+check_stale_load (const char* filename, const GncGUID* guid,
+                  const char* name, const char* what)
+{
+    auto delta = g_strconcat (filename, ".delta", (gchar*)NULL);
+    auto stale = g_strconcat (delta, ".stale", (gchar*)NULL);
+    auto session = qof_session_new (nullptr);
+
+    qof_session_begin (session, filename, SESSION_NORMAL_OPEN);
+    qof_session_load (session, NULL);
+    auto book = qof_session_get_book (session);
+    auto acc = xaccAccountLookup (guid, book);
+    do_test_args (acc && g_strcmp0 (xaccAccountGetName (acc), name) == 0,
+                  "account after an unusable delta", __FILE__, __LINE__,
+                  "%s: expected %s", what, name);
+    do_test_args (g_file_test (stale, G_FILE_TEST_EXISTS)
+                  && !g_file_test (delta, G_FILE_TEST_EXISTS),
+                  "unusable delta moved aside", __FILE__, __LINE__, "%s", what);
+    do_test_args (qof_book_session_not_saved (book),
+                  "book dirty after an unusable delta", __FILE__, __LINE__,
+                  "%s", what);
+    qof_session_end (session);
+    qof_session_destroy (session);
+
+    g_unlink (stale);
+    g_free (stale);
+    g_free (delta);
+}
+
+static void
+test_delta_stale (const char* filename)
+{
+    auto delta = g_strconcat (filename, ".delta", (gchar*)NULL);
+    GncGUID acc_guid;
+
+    gnc_prefs_set_file_save_delta (FALSE);
+    auto session = qof_session_new (nullptr);
+    qof_session_begin (session, filename, SESSION_NEW_OVERWRITE);
+    auto book = qof_session_get_book (session);
+    auto checking = make_account (book, "Checking");
+    auto savings = make_account (book, "Savings");
+    acc_guid = *xaccAccountGetGUID (checking);
+    /* Enough data that a delta save isn't turned into a full one. */
+    for (auto i = 0; i < 20; ++i)
+        make_transaction (book, checking, savings, 100 + i);
+    qof_session_save (session, NULL);
+
+    /* Two delta saves, then cut the second document short as a crash
+     * while appending would. */
+    gnc_prefs_set_file_save_delta (TRUE);
+    set_account_name (checking, "First");
+    qof_session_save (session, NULL);
+    auto first_size = file_size (delta);
+    set_account_name (checking, "Second");
+    qof_session_save (session, NULL);
+    auto second_size = file_size (delta);
+    qof_session_end (session);
+    qof_session_destroy (session);
+
+    gchar* contents = NULL;
+    do_test (first_size > 0 && second_size > first_size
+             && g_file_get_contents (delta, &contents, NULL, NULL)
+             && g_file_set_contents (delta, contents,
+                                     first_size + (second_size - first_size) / 2,
+                                     NULL),
+             "truncate the delta");
+    g_free (contents);
+    check_stale_load (filename, &acc_guid, "First", "truncated delta");
+
+    /* A delta written against another version of the data file. */
+    session = qof_session_new (nullptr);
+    qof_session_begin (session, filename, SESSION_NORMAL_OPEN);
+    qof_session_load (session, NULL);
+    book = qof_session_get_book (session);
+    set_account_name (xaccAccountLookup (&acc_guid, book), "Third");
+    qof_session_save (session, NULL);
+    do_test (g_file_test (delta, G_FILE_TEST_EXISTS), "second delta written");
+    qof_session_end (session);
+    qof_session_destroy (session);
+
+    GStatBuf statbuf;
+    struct utimbuf times;
+    g_stat (filename, &statbuf);
+    times.actime = statbuf.st_atime;
+    times.modtime = statbuf.st_mtime - 60;
+    do_test (g_utime (filename, &times) == 0, "change the data file's time");
+    check_stale_load (filename, &acc_guid, "Checking", "delta of another base");
+
+    gnc_prefs_set_file_save_delta (FALSE);
+    g_free (delta);
+}
+
+int
+main (int argc, char** argv)
+{
+    g_setenv ("GNC_UNINSTALLED", "1", TRUE);
+    auto dir = g_dir_make_tmp ("test-xml-delta-XXXXXX", NULL);
+    auto filename = g_build_filename (dir, "delta.gnucash", (gchar*)NULL);
+
+    qof_init ();
+    cashobjects_register ();
+    do_test (qof_load_backend_library (GNC_LIB_REL_PATH, GNC_LIB_NAME),
+             " loading gnc-backend-xml GModule failed");
+    xaccLogDisable ();
+
+    test_delta_round_trip (filename);
+    g_free (filename);
+    filename = g_build_filename (dir, "stale.gnucash", (gchar*)NULL);
+    test_delta_stale (filename);
+
+    /* The full saves leave backups behind as well. */
+    auto tmpdir = g_dir_open (dir, 0, NULL);
+    const gchar* entry;
+    while (tmpdir && (entry = g_dir_read_name (tmpdir)) != NULL)
+    {
+        auto path = g_build_filename (dir, entry, (gchar*)NULL);
+        g_unlink (path);
+        g_free (path);
+    }
+    if (tmpdir)
+        g_dir_close (tmpdir);
+    g_free (filename);
+    g_rmdir (dir);
+    g_free (dir);
+
+    print_test_results ();
+    qof_close ();
+    exit (get_rv ());
+}
@@ -50,6 +50,8 @@ extern "C"
 #include "../gnc-xml.h"
 #include "../sixtp-parsers.h"
 #include "../sixtp-dom-parsers.h"
+#include "../sixtp-stream-parser.hpp"
+#include "../sixtp-stream-writer.hpp"
 #include "../io-gncxml-gen.h"
 #include "test-file-stuff.h"
 #include <test-stuff.h>
@@ -441,6 +443,14 @@ test_transaction (void)
             success_args ("transaction_xml", __FILE__, __LINE__, "%d", i);
         }
 
+        {
+            SixtpStreamWriter writer;
+            gnc_transaction_write_xml (writer, ran_trn);
+            do_test_args (dom_tree_equals_xml (test_node, writer.str ().c_str ()),
+                          "gnc_transaction_write_xml", __FILE__, __LINE__,
+                          "streamed transaction %d differs from its DOM tree", i);
+        }
+
         filename1 = g_strdup_printf ("test_file_XXXXXX");
 
         fd = g_mkstemp (filename1);
@@ -503,6 +513,22 @@ test_transaction (void)
     }
 }
 
+static void
+test_stream_tag_collision (void)
+{
+    /* "trn:jjcohfh" has the same FNV-1a hash as "trn:num". */
+    SixtpTagTable tags {"trn:id", "trn:num", "trn:description"};
+
+    do_test (sixtp_tag_hash ("trn:jjcohfh") == sixtp_tag_hash ("trn:num"),
+             "colliding tags have the same hash");
+    do_test (tags.verified_hash ("trn:num") == sixtp_tag_hash ("trn:num"),
+             "a known tag dispatches on its hash");
+    do_test (tags.verified_hash ("trn:jjcohfh") == 0,
+             "a colliding tag isn't taken for the known one");
+    do_test (tags.verified_hash ("trn:notes") == sixtp_tag_hash ("trn:notes"),
+             "an unknown tag keeps its hash");
+}
+
 static gboolean
 test_real_transaction (const char* tag, gpointer global_data, gpointer data)
 {
@@ -535,6 +561,7 @@ main (int argc, char** argv)
     }
     else
     {
+        test_stream_tag_collision ();
         test_transaction ();
     }
 
@@ -32,6 +32,8 @@ static gchar *namespace_regexp    = NULL;
 static gboolean is_debugging      = FALSE;
 static gboolean extras_enabled    = FALSE;
 static gboolean use_compression   = TRUE; // This is also the default in the prefs backend
+static gboolean use_delta_save    = FALSE; // This is also the default in the prefs backend
+static gboolean use_write_behind  = FALSE; // This is also the default in the prefs backend
 static gint file_retention_policy = 1;    // 1 = "days", the default in the prefs backend
 static gint file_retention_days   = 30;   // This is also the default in the prefs backend
 
@@ -95,6 +97,30 @@ gnc_prefs_set_file_save_compressed(gboolean compressed)
     use_compression = compressed;
 }
 
+gboolean
+gnc_prefs_get_file_save_delta(void)
+{
+    return use_delta_save;
+}
+
+void
+gnc_prefs_set_file_save_delta(gboolean delta)
+{
+    use_delta_save = delta;
+}
+
+gboolean
+gnc_prefs_get_sql_write_behind(void)
+{
+    return use_write_behind;
+}
+
+void
+gnc_prefs_set_sql_write_behind(gboolean write_behind)
+{
+    use_write_behind = write_behind;
+}
+
 gint
 gnc_prefs_get_file_retention_policy(void)
 {
@@ -109,6 +109,12 @@ void gnc_prefs_set_extra(gboolean enabled);
 gboolean gnc_prefs_get_file_save_compressed(void);
 void gnc_prefs_set_file_save_compressed(gboolean compressed);
 
+gboolean gnc_prefs_get_file_save_delta(void);
+void gnc_prefs_set_file_save_delta(gboolean delta);
+
+gboolean gnc_prefs_get_sql_write_behind(void);
+void gnc_prefs_set_sql_write_behind(gboolean write_behind);
+
 gint gnc_prefs_get_file_retention_policy(void);
 void gnc_prefs_set_file_retention_policy(gint policy);
 
@@ -46,9 +46,15 @@ extern "C" {
 #include "qofinstance-p.h"
 #include "gnc-features.h"
 #include "guid.hpp"
+#include "qof-backend.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 static QofLogModule log_module = GNC_MOD_ACCOUNT;
 
@@ -344,6 +350,7 @@ gnc_account_init(Account* acc)
 
     priv->splits = NULL;
     priv->sort_dirty = FALSE;
+    priv->split_balances = NULL;
 }
 
 static void
@@ -355,6 +362,7 @@ gnc_account_dispose (GObject *acctp)
 static void
 gnc_account_finalize(GObject* acctp)
 {
+    gnc_account_drop_split_balances (GNC_ACCOUNT (acctp));
     G_OBJECT_CLASS(gnc_account_parent_class)->finalize(acctp);
 }
 
@@ -1209,6 +1217,69 @@ gnc_book_set_root_account (QofBook *book, Account *root)
     gnc_coll_set_root_account (col, root);
 }
 
+void
+gnc_book_begin_bulk_load (QofBook *book)
+{
+    g_return_if_fail (QOF_IS_BOOK (book));
+
+    if (!qof_book_in_bulk_load (book))
+        qof_event_suspend ();
+    qof_book_begin_bulk_load (book);
+}
+
+static void
+bulk_load_finish_account (QofInstance *inst, gpointer data)
+{
+    auto acc = GNC_ACCOUNT (inst);
+    auto priv = GET_PRIVATE (acc);
+    auto changed = static_cast<GList**>(data);
+
+    if (!priv->sort_dirty && !priv->balance_dirty)
+        return;
+
+    if (priv->sort_dirty && qof_instance_get_editlevel (acc) == 0)
+    {
+        /* Splits were inserted without looking for duplicates; after
+         * sorting any would be adjacent. */
+        priv->splits = g_list_sort (priv->splits, (GCompareFunc)xaccSplitOrder);
+        for (auto node = priv->splits; node && node->next;)
+        {
+            if (node->next->data == node->data)
+            {
+                PERR ("Split %p was inserted into account %s twice",
+                      node->data, priv->accountName);
+                priv->splits = g_list_delete_link (priv->splits, node->next);
+            }
+            else
+                node = node->next;
+        }
+        priv->sort_dirty = FALSE;
+        priv->balance_dirty = TRUE;
+    }
+    xaccAccountRecomputeBalance (acc);
+    *changed = g_list_prepend (*changed, acc);
+}
+
+void
+gnc_book_end_bulk_load (QofBook *book)
+{
+    GList *changed = NULL;
+
+    g_return_if_fail (QOF_IS_BOOK (book));
+
+    if (!qof_book_in_bulk_load (book) || !qof_book_end_bulk_load (book))
+        return;
+
+    ENTER ("book=%p", book);
+    qof_collection_foreach (qof_book_get_collection (book, GNC_ID_ACCOUNT),
+                            bulk_load_finish_account, &changed);
+    qof_event_resume ();
+    for (auto node = changed; node; node = node->next)
+        qof_event_gen (QOF_INSTANCE (node->data), QOF_EVENT_MODIFY, NULL);
+    LEAVE ("%u accounts changed", g_list_length (changed));
+    g_list_free (changed);
+}
+
 /********************************************************************\
 \********************************************************************/
 
@@ -1914,6 +1985,16 @@ gnc_account_insert_split (Account *acc, Split *s)
     g_return_val_if_fail(GNC_IS_SPLIT(s), FALSE);
 
     priv = GET_PRIVATE(acc);
+    /* A bulk load sorts the splits and weeds out duplicates at its end,
+     * see gnc_book_end_bulk_load(). */
+    if (qof_book_in_bulk_load (qof_instance_get_book (acc)))
+    {
+        priv->splits = g_list_prepend(priv->splits, s);
+        priv->sort_dirty = TRUE;
+        priv->balance_dirty = TRUE;
+        return TRUE;
+    }
+
     node = g_list_find(priv->splits, s);
     if (node)
         return FALSE;
@@ -2242,24 +2323,20 @@ xaccAccountMoveAllSplits (Account *accfrom, Account *accto)
  * Return: void                                                     *
 \********************************************************************/
 
-void
-xaccAccountRecomputeBalance (Account * acc)
+/* Sums the amounts of the splits onto the starting balances, leaving the
+ * totals in sums and, if split_balances isn't NULL, appending each split's
+ * running balances to it. It touches only the account and its own splits,
+ * so gnc_book_finalize_load() may run it on several accounts at once. */
+static void
+account_sum_splits (AccountPrivate *priv, SplitBalances *sums,
+                    GArray *split_balances)
 {
-    AccountPrivate *priv;
     gnc_numeric  balance;
     gnc_numeric  noclosing_balance;
     gnc_numeric  cleared_balance;
     gnc_numeric  reconciled_balance;
     GList *lp;
 
-    if (NULL == acc) return;
-
-    priv = GET_PRIVATE(acc);
-    if (qof_instance_get_editlevel(acc) > 0) return;
-    if (!priv->balance_dirty || priv->defer_bal_computation) return;
-    if (qof_instance_get_destroying(acc)) return;
-    if (qof_book_shutting_down(qof_instance_get_book(acc))) return;
-
     balance            = priv->starting_balance;
     noclosing_balance  = priv->starting_noclosing_balance;
     cleared_balance    = priv->starting_cleared_balance;
@@ -2289,20 +2366,250 @@ xaccAccountRecomputeBalance (Account * acc)
         if (!(xaccTransGetIsClosingTxn (split->parent)))
             noclosing_balance = gnc_numeric_add_fixed(noclosing_balance, amt);
 
-        split->balance = balance;
-        split->noclosing_balance = noclosing_balance;
-        split->cleared_balance = cleared_balance;
-        split->reconciled_balance = reconciled_balance;
+        if (split_balances)
+        {
+            SplitBalances entry {split, balance, noclosing_balance,
+                                 cleared_balance, reconciled_balance};
+            split->balance_index = split_balances->len;
+            g_array_append_val (split_balances, entry);
+        }
+    }
+
+    sums->split = nullptr;
+    sums->balance = balance;
+    sums->noclosing_balance = noclosing_balance;
+    sums->cleared_balance = cleared_balance;
+    sums->reconciled_balance = reconciled_balance;
+}
 
+/* The accounts whose running balances are built, oldest first, and the
+ * number of entries they hold between them. When that passes
+ * split_balances_limit the oldest are dropped; 0 means no limit. Guarded
+ * by split_balances_mutex because gnc_book_finalize_load() recomputes
+ * several accounts at once. */
+static std::mutex split_balances_mutex;
+static std::vector<AccountPrivate*> split_balances_built;
+static guint split_balances_count = 0;
+static guint split_balances_limit = 0;
+
+static void
+account_drop_split_balances_locked (AccountPrivate *priv)
+{
+    auto it = std::find (split_balances_built.begin (),
+                         split_balances_built.end (), priv);
+    if (it != split_balances_built.end ())
+        split_balances_built.erase (it);
+    split_balances_count -= priv->split_balances->len;
+    g_array_free (priv->split_balances, TRUE);
+    priv->split_balances = nullptr;
+}
+
+static void
+account_drop_split_balances (AccountPrivate *priv)
+{
+    if (!priv->split_balances)
+        return;
+    std::lock_guard<std::mutex> lock (split_balances_mutex);
+    account_drop_split_balances_locked (priv);
+}
+
+/* Drops the oldest running balances, other than keep's, until the
+ * limit is met. */
+static void
+split_balances_trim_locked (AccountPrivate *keep)
+{
+    auto it = split_balances_built.begin ();
+    while (split_balances_limit &&
+           split_balances_count > split_balances_limit &&
+           it != split_balances_built.end ())
+    {
+        auto priv = *it;
+        if (priv == keep)
+        {
+            ++it;
+            continue;
+        }
+        QOF_STAT_COUNT ("engine.account.drop-split-balances");
+        it = split_balances_built.erase (it);
+        split_balances_count -= priv->split_balances->len;
+        g_array_free (priv->split_balances, TRUE);
+        priv->split_balances = nullptr;
     }
+}
+
+/* Recomputes the balances without any of the checks of
+ * xaccAccountRecomputeBalance. The running balances of the splits are
+ * dropped rather than updated; they are rebuilt when next asked for. */
+static void
+account_recompute_balance (AccountPrivate *priv)
+{
+    SplitBalances sums;
+
+    QOF_STAT_SCOPED_TIMER ("engine.account.recompute-balance");
+    account_sum_splits (priv, &sums, nullptr);
+    account_drop_split_balances (priv);
 
-    priv->balance = balance;
-    priv->noclosing_balance = noclosing_balance;
-    priv->cleared_balance = cleared_balance;
-    priv->reconciled_balance = reconciled_balance;
+    priv->balance = sums.balance;
+    priv->noclosing_balance = sums.noclosing_balance;
+    priv->cleared_balance = sums.cleared_balance;
+    priv->reconciled_balance = sums.reconciled_balance;
     priv->balance_dirty = FALSE;
 }
 
+void
+xaccAccountRecomputeBalance (Account * acc)
+{
+    AccountPrivate *priv;
+
+    if (NULL == acc) return;
+
+    priv = GET_PRIVATE(acc);
+    if (qof_instance_get_editlevel(acc) > 0) return;
+    if (!priv->balance_dirty || priv->defer_bal_computation) return;
+    if (qof_instance_get_destroying(acc)) return;
+    if (qof_book_shutting_down(qof_instance_get_book(acc))) return;
+    if (qof_book_in_bulk_load(qof_instance_get_book(acc))) return;
+
+    account_recompute_balance (priv);
+}
+
+const SplitBalances *
+gnc_account_get_split_balances (Account *acc, const Split *split)
+{
+    AccountPrivate *priv;
+    SplitBalances sums;
+
+    g_return_val_if_fail (GNC_IS_ACCOUNT (acc), nullptr);
+    g_return_val_if_fail (split, nullptr);
+
+    /* While the account can't be recomputed, e.g. because it's being
+     * edited, the running balances built before the change are returned,
+     * as they were when they lived in the splits. */
+    priv = GET_PRIVATE (acc);
+    xaccAccountRecomputeBalance (acc);
+    if (!priv->split_balances)
+    {
+        QOF_STAT_SCOPED_TIMER ("engine.account.build-split-balances");
+        priv->split_balances =
+            g_array_sized_new (FALSE, FALSE, sizeof (SplitBalances),
+                               g_list_length (priv->splits));
+        account_sum_splits (priv, &sums, priv->split_balances);
+
+        std::lock_guard<std::mutex> lock (split_balances_mutex);
+        split_balances_built.push_back (priv);
+        split_balances_count += priv->split_balances->len;
+        split_balances_trim_locked (priv);
+    }
+
+    if (split->balance_index < priv->split_balances->len)
+    {
+        auto entry = &g_array_index (priv->split_balances, SplitBalances,
+                                     split->balance_index);
+        if (entry->split == split)
+            return entry;
+    }
+    return nullptr;
+}
+
+void
+gnc_account_drop_split_balances (Account *acc)
+{
+    g_return_if_fail (GNC_IS_ACCOUNT (acc));
+    account_drop_split_balances (GET_PRIVATE (acc));
+}
+
+void
+gnc_account_drop_all_split_balances (void)
+{
+    std::lock_guard<std::mutex> lock (split_balances_mutex);
+    while (!split_balances_built.empty ())
+        account_drop_split_balances_locked (split_balances_built.back ());
+}
+
+void
+gnc_account_set_split_balances_limit (guint max_splits)
+{
+    std::lock_guard<std::mutex> lock (split_balances_mutex);
+    split_balances_limit = max_splits;
+    split_balances_trim_locked (nullptr);
+}
+
+static void
+finalize_load_warm_trans (QofInstance *inst, gpointer data)
+{
+    xaccTransGetIsClosingTxn (GNC_TRANSACTION (inst));
+}
+
+static void
+finalize_load_collect_account (QofInstance *inst, gpointer data)
+{
+    auto priv = GET_PRIVATE (inst);
+    auto accounts = static_cast<std::vector<AccountPrivate*>*>(data);
+
+    if (priv->sort_dirty ||
+        (priv->balance_dirty && !priv->defer_bal_computation))
+        accounts->push_back (priv);
+}
+
+static void
+finalize_load_account (AccountPrivate *priv)
+{
+    if (priv->sort_dirty)
+    {
+        priv->splits = g_list_sort (priv->splits, (GCompareFunc)xaccSplitOrder);
+        priv->sort_dirty = FALSE;
+        priv->balance_dirty = TRUE;
+    }
+    if (!priv->defer_bal_computation)
+        account_recompute_balance (priv);
+}
+
+void
+gnc_book_finalize_load (QofBook *book)
+{
+    std::vector<AccountPrivate*> accounts;
+
+    g_return_if_fail (QOF_IS_BOOK (book));
+
+    ENTER ("book=%p", book);
+    QOF_STAT_SCOPED_TIMER ("engine.book.finalize-load");
+    qof_collection_foreach (qof_book_get_collection (book, GNC_ID_ACCOUNT),
+                            finalize_load_collect_account, &accounts);
+
+    /* xaccSplitOrder and the balance computation read values that are
+     * cached on first use; fill the caches before the threads share
+     * them. */
+    qof_book_use_split_action_for_num_field (book);
+    qof_collection_foreach (qof_book_get_collection (book, GNC_ID_TRANS),
+                            finalize_load_warm_trans, NULL);
+
+    auto num_threads = std::min<size_t> (std::thread::hardware_concurrency (),
+                                         accounts.size ());
+    /* The log macros share a buffer for the function name, so don't
+     * spread out the work while info messages are on. */
+    if (num_threads < 2 || qof_log_check (log_module, QOF_LOG_INFO))
+    {
+        for (auto priv : accounts)
+            finalize_load_account (priv);
+        LEAVE ("%zu accounts", accounts.size ());
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&accounts, &next]()
+    {
+        for (auto i = next++; i < accounts.size (); i = next++)
+            finalize_load_account (accounts[i]);
+    };
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < num_threads; ++i)
+        threads.emplace_back (worker);
+    worker ();
+    for (auto& thread : threads)
+        thread.join ();
+    LEAVE ("%zu accounts, %zu threads", accounts.size (), num_threads);
+}
+
 /********************************************************************\
 \********************************************************************/
 
@@ -3487,6 +3794,15 @@ GetBalanceAsOfDate (Account *acc, time64 date, gboolean ignclosing)
 
     g_return_val_if_fail(GNC_IS_ACCOUNT(acc), gnc_numeric_zero());
 
+    /* Splits that are still in the data store can only be summed there. The
+     * backend can't tell closing transactions apart, so for the no-closing
+     * balance the engine uses what it has. */
+    auto be = qof_book_get_backend (gnc_account_get_book (acc));
+    gnc_numeric total;
+    if (!ignclosing && be && !be->transactions_loaded () &&
+        be->sum_split_amounts (QOF_INSTANCE (acc), INT64_MIN, date, total))
+        return total;
+
     xaccAccountSortSplits (acc, TRUE); /* just in case, normally a noop */
     xaccAccountRecomputeBalance (acc); /* just in case, normally a noop */
 
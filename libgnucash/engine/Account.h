@@ -244,6 +244,25 @@ void gnc_set_account_separator (const gchar *separator);
 Account *gnc_book_get_root_account(QofBook *book);
 void gnc_book_set_root_account(QofBook *book, Account *root);
 
+/** Start adding many transactions to @a book, e.g. in an importer.
+ *  Until the matching gnc_book_end_bulk_load():
+ *
+ *  - splits are added to their accounts unsorted and balances are not
+ *    recomputed, so account balances and split lists are stale;
+ *  - no events are generated;
+ *  - committed objects are not passed to the backend.
+ *
+ *  Bulk loads nest; only the outermost one has any effect.
+ */
+void gnc_book_begin_bulk_load (QofBook *book);
+
+/** End a bulk load. When the outermost one ends the deferred objects are
+ *  committed to the backend in one batch, each changed account's splits
+ *  are sorted and its balances recomputed once, and a single
+ *  QOF_EVENT_MODIFY is generated for each changed account in place of the
+ *  suppressed per-object events. */
+void gnc_book_end_bulk_load (QofBook *book);
+
 /** @deprecated */
 #define xaccAccountGetGUID(X)     qof_entity_get_guid(QOF_INSTANCE(X))
 #define xaccAccountReturnGUID(X) (X ? *(qof_entity_get_guid(QOF_INSTANCE(X))) : *(guid_null()))
@@ -428,6 +447,31 @@ gboolean gnc_account_get_defer_bal_computation (Account *acc);
  */
 void xaccAccountRecomputeBalance (Account *);
 
+/** The running balances returned by xaccSplitGetBalance() and its
+ *  siblings are built for a whole account the first time one is asked
+ *  for. Limit the number of splits whose running balances are kept
+ *  across all accounts; when building an account's balances passes the
+ *  limit, those of the accounts built longest ago are freed. They are
+ *  rebuilt if asked for again.
+ *
+ *  @param max_splits The number of splits, or 0 for no limit, which is
+ *  the default.
+ */
+void gnc_account_set_split_balances_limit (guint max_splits);
+
+/** Free the running balances of every account, e.g. when the system is
+ *  short of memory. They are rebuilt when next asked for.
+ */
+void gnc_account_drop_all_split_balances (void);
+
+/** Sort the splits and recompute the balances of every account in @a book
+ *  that needs it, including accounts open for editing, spreading the
+ *  accounts over one thread per processor. Backends call this when they
+ *  have finished loading a book and before they commit the accounts. Nothing
+ *  else may use the book until it returns.
+ */
+void gnc_book_finalize_load (QofBook *book);
+
 /** The xaccAccountSortSplits() routine will resort the account's
  *  splits if the sort is dirty. If 'force' is true, the account
  *  is sorted even if the editlevel is not zero.
@@ -55,6 +55,17 @@ extern "C" {
  * No one outside of the engine should ever include this file.
 */
 
+/* The running balances of one split: the sums of the amounts of all the
+ * splits in the account up to and including it, in split order. */
+typedef struct
+{
+    const Split *split;
+    gnc_numeric balance;
+    gnc_numeric noclosing_balance;
+    gnc_numeric cleared_balance;
+    gnc_numeric reconciled_balance;
+} SplitBalances;
+
 /** \struct Account */
 typedef struct AccountPrivate
 {
@@ -119,6 +130,12 @@ typedef struct AccountPrivate
     GList *splits;              /* list of split pointers */
     gboolean sort_dirty;        /* sort order of splits is bad */
 
+    /* The SplitBalances of the splits, in the order of the splits list.
+     * Built when a split's running balance is first asked for and dropped
+     * whenever the balances are recomputed, so that accounts which nobody
+     * looks at split by split don't carry them. */
+    GArray *split_balances;
+
     LotList   *lots;		/* list of lot pointers */
     GNCPolicy *policy;		/* Cached pointer to policy method */
 
@@ -142,6 +159,18 @@ void xaccAccountSetGUID (Account *account, const GncGUID *guid);
 /* Register Accounts with the engine */
 gboolean xaccAccountRegister (void);
 
+/* The running balances of @a split, building them for the whole account
+ * if needed. NULL if the split isn't in the account. The result is valid
+ * until the account's splits change or, when a limit is set with
+ * gnc_account_set_split_balances_limit(), until another account's
+ * running balances are built. */
+const SplitBalances *gnc_account_get_split_balances (Account *acc,
+                                                     const Split *split);
+
+/* Free the running balances of @a acc's splits until they are next asked
+ * for. */
+void gnc_account_drop_split_balances (Account *acc);
+
 /* Structure for accessing static functions for testing */
 typedef struct
 {
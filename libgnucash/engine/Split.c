@@ -117,11 +117,6 @@ gnc_split_init(Split* split)
 
     split->date_reconciled  = 0;
 
-    split->balance             = gnc_numeric_zero();
-    split->cleared_balance     = gnc_numeric_zero();
-    split->reconciled_balance  = gnc_numeric_zero();
-    split->noclosing_balance   = gnc_numeric_zero();
-
     split->gains = GAINS_STATUS_UNKNOWN;
     split->gains_split = NULL;
 }
@@ -511,11 +506,6 @@ xaccSplitReinit(Split * split)
 
     split->date_reconciled  = 0;
 
-    split->balance             = gnc_numeric_zero();
-    split->cleared_balance     = gnc_numeric_zero();
-    split->reconciled_balance  = gnc_numeric_zero();
-    split->noclosing_balance   = gnc_numeric_zero();
-
     qof_instance_set_idata(split, 0);
 
     split->gains = GAINS_STATUS_UNKNOWN;
@@ -575,11 +565,7 @@ xaccDupeSplit (const Split *s)
     split->value = s->value;
     split->amount = s->amount;
 
-    /* no need to futz with the balances;  these get wiped each time ...
-     * split->balance             = s->balance;
-     * split->cleared_balance     = s->cleared_balance;
-     * split->reconciled_balance  = s->reconciled_balance;
-     */
+    /* no need to futz with the balances; the account keeps them. */
 
     return split;
 }
@@ -596,10 +582,6 @@ xaccSplitCloneNoKvp (const Split *s)
     split->date_reconciled     = s->date_reconciled;
     split->value               = s->value;
     split->amount              = s->amount;
-    split->balance             = s->balance;
-    split->cleared_balance     = s->cleared_balance;
-    split->reconciled_balance  = s->reconciled_balance;
-    split->noclosing_balance   = s->noclosing_balance;
 
     split->gains = GAINS_STATUS_UNKNOWN;
     split->gains_split = NULL;
@@ -678,11 +660,14 @@ xaccSplitDump (const Split *split, const char *tag)
 
     printf("    Value:    %s\n", gnc_numeric_to_string(split->value));
     printf("    Amount:   %s\n", gnc_numeric_to_string(split->amount));
-    printf("    Balance:  %s\n", gnc_numeric_to_string(split->balance));
-    printf("    CBalance: %s\n", gnc_numeric_to_string(split->cleared_balance));
+    printf("    Balance:  %s\n",
+           gnc_numeric_to_string(xaccSplitGetBalance(split)));
+    printf("    CBalance: %s\n",
+           gnc_numeric_to_string(xaccSplitGetClearedBalance(split)));
     printf("    RBalance: %s\n",
-           gnc_numeric_to_string(split->reconciled_balance));
-    printf("    NoClose:  %s\n", gnc_numeric_to_string(split->noclosing_balance));
+           gnc_numeric_to_string(xaccSplitGetReconciledBalance(split)));
+    printf("    NoClose:  %s\n",
+           gnc_numeric_to_string(xaccSplitGetNoclosingBalance(split)));
     printf("    idata:    %x\n", qof_instance_get_idata(split));
 }
 #endif
@@ -864,16 +849,19 @@ xaccSplitEqual(const Split *sa, const Split *sb,
 
     if (check_balances)
     {
-        if (!xaccSplitEqualCheckBal ("", sa->balance, sb->balance))
+        if (!xaccSplitEqualCheckBal ("", xaccSplitGetBalance (sa),
+                                     xaccSplitGetBalance (sb)))
             return FALSE;
-        if (!xaccSplitEqualCheckBal ("cleared ", sa->cleared_balance,
-                                     sb->cleared_balance))
+        if (!xaccSplitEqualCheckBal ("cleared ", xaccSplitGetClearedBalance (sa),
+                                     xaccSplitGetClearedBalance (sb)))
             return FALSE;
-        if (!xaccSplitEqualCheckBal ("reconciled ", sa->reconciled_balance,
-                                     sb->reconciled_balance))
+        if (!xaccSplitEqualCheckBal ("reconciled ",
+                                     xaccSplitGetReconciledBalance (sa),
+                                     xaccSplitGetReconciledBalance (sb)))
             return FALSE;
-        if (!xaccSplitEqualCheckBal ("noclosing ", sa->noclosing_balance,
-                                     sb->noclosing_balance))
+        if (!xaccSplitEqualCheckBal ("noclosing ",
+                                     xaccSplitGetNoclosingBalance (sa),
+                                     xaccSplitGetNoclosingBalance (sb)))
             return FALSE;
     }
 
@@ -1273,28 +1261,38 @@ xaccSplitSetValue (Split *s, gnc_numeric amt)
 /********************************************************************\
 \********************************************************************/
 
+static const SplitBalances *
+split_get_balances (const Split *s)
+{
+    return (s && s->acc) ? gnc_account_get_split_balances (s->acc, s) : NULL;
+}
+
 gnc_numeric
 xaccSplitGetBalance (const Split *s)
 {
-    return s ? s->balance : gnc_numeric_zero();
+    const SplitBalances *b = split_get_balances (s);
+    return b ? b->balance : gnc_numeric_zero();
 }
 
 gnc_numeric
 xaccSplitGetNoclosingBalance (const Split *s)
 {
-    return s ? s->noclosing_balance : gnc_numeric_zero();
+    const SplitBalances *b = split_get_balances (s);
+    return b ? b->noclosing_balance : gnc_numeric_zero();
 }
 
 gnc_numeric
 xaccSplitGetClearedBalance (const Split *s)
 {
-    return s ? s->cleared_balance : gnc_numeric_zero();
+    const SplitBalances *b = split_get_balances (s);
+    return b ? b->cleared_balance : gnc_numeric_zero();
 }
 
 gnc_numeric
 xaccSplitGetReconciledBalance (const Split *s)
 {
-    return s ? s->reconciled_balance : gnc_numeric_zero();
+    const SplitBalances *b = split_get_balances (s);
+    return b ? b->reconciled_balance : gnc_numeric_zero();
 }
 
 void
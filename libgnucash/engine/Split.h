@@ -293,6 +293,11 @@ gnc_numeric xaccSplitGetBaseValue (const Split *split,
  * share prices.
  *
  * Returns the running balance up to & including the indicated split.
+ *
+ * The running balances are computed for all of the split's account the
+ * first time one of them is asked for, and kept until the account's splits
+ * change or they are freed to save memory; see
+ * gnc_account_set_split_balances_limit().
  */
 gnc_numeric xaccSplitGetBalance (const Split *split);
 
@@ -103,6 +103,11 @@ struct split_s
      */
     unsigned char  gains;
 
+    /* The split's position in its account's running balances, see
+     * gnc_account_get_split_balances(). Only meaningful while they are
+     * built; it fills what would otherwise be padding. */
+    guint32 balance_index;
+
     /* 'gains_split' is a convenience pointer used to track down the
      * other end of a cap-gains transaction pair.  NULL if this split
      * doesn't involve cap gains.
@@ -115,17 +120,8 @@ struct split_s
     gnc_numeric  value;
     gnc_numeric  amount;
 
-    /* -------------------------------------------------------------- */
-    /* Below follow some 'temporary' fields */
-
-    /* The various "balances" are the sum of all of the values of
-     * all the splits in the account, up to and including this split.
-     * These balances apply to a sorting order by date posted
-     * (not by date entered). */
-    gnc_numeric  balance;
-    gnc_numeric  noclosing_balance;
-    gnc_numeric  cleared_balance;
-    gnc_numeric  reconciled_balance;
+    /* The running balances are kept by the account, which computes them
+     * only when they are asked for; see xaccSplitGetBalance(). */
 };
 
 struct _SplitClass
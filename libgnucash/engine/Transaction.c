@@ -1642,6 +1642,8 @@ static void trans_cleanup_commit(Transaction *trans)
 void
 xaccTransCommitEdit (Transaction *trans)
 {
+    gint64 stat_start;
+
     if (!trans) return;
     ENTER ("(trans=%p)", trans);
 
@@ -1650,6 +1652,7 @@ xaccTransCommitEdit (Transaction *trans)
         LEAVE("editlevel non-zero");
         return;
     }
+    stat_start = QOF_STAT_TIMER_START ();
 
     /* We increment this for the duration of the call
      * so other functions don't result in a recursive
@@ -1700,6 +1703,7 @@ xaccTransCommitEdit (Transaction *trans)
                           trans_on_error,
                           (void (*) (QofInstance *)) trans_cleanup_commit,
                           (void (*) (QofInstance *)) do_destroy);
+    QOF_STAT_TIMER_STOP ("engine.trans.commit", stat_start);
     LEAVE ("(trans=%p)", trans);
 }
 
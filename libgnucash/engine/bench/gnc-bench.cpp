@@ -0,0 +1,593 @@
+/********************************************************************
+ * gnc-bench.cpp: Benchmarks of the engine's core paths on a large, *
+ *                reproducible synthetic book.                      *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+\********************************************************************/
+
+/* Usage: gnc-bench [--seed=N] [--accounts=N] [--splits=N] [--prices=N]
+ *                  [--lookups=N] [--only=NAME,...] [--output=FILE]
+ *                  [--tmpdir=DIR]
+ *
+ * The book is generated from the seed alone, so two runs with the same
+ * parameters time exactly the same work. The results are written as a
+ * JSON object:
+ *
+ * { "benchmark": "gnc-bench", "version": "...",
+ *   "parameters": { "seed": 1, "accounts": 10000, ... },
+ *   "results": [ { "name": "recompute-balances", "seconds": 1.25,
+ *                  "operations": 10000 },
+ *                { "name": "sqlite-save", "skipped": "reason" }, ... ] }
+ *
+ * test-engine-stuff's random objects aren't used: they draw on rand()
+ * and carry deeply nested random KVP, which would dominate every timing.
+ */
+
+extern "C"
+{
+#include <config.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <stdio.h>
+
+#include "qof.h"
+#include "Account.h"
+#include "Query.h"
+#include "Scrub.h"
+#include "Transaction.h"
+#include "gnc-commodity.h"
+#include "gnc-engine.h"
+#include "gnc-pricedb.h"
+}
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+static QofLogModule log_module = "gnc.bench";
+
+/* 2000-01-01 00:00:00 UTC */
+static const time64 bench_epoch = 946684800;
+static const time64 bench_day = 86400;
+static const int bench_n_securities = 200;
+static const int bench_n_payees = 2000;
+
+static gint64 opt_seed = 1;
+static gint opt_accounts = 10000;
+static gint opt_splits = 5000000;
+static gint opt_prices = 1000000;
+static gint opt_lookups = 100000;
+static gchar* opt_only = nullptr;
+static gchar* opt_output = nullptr;
+static gchar* opt_tmpdir = nullptr;
+
+static GOptionEntry bench_options[] =
+{
+    { "seed", 0, 0, G_OPTION_ARG_INT64, &opt_seed, "Seed of the generated book", "N" },
+    { "accounts", 0, 0, G_OPTION_ARG_INT, &opt_accounts, "Number of accounts", "N" },
+    { "splits", 0, 0, G_OPTION_ARG_INT, &opt_splits, "Number of splits", "N" },
+    { "prices", 0, 0, G_OPTION_ARG_INT, &opt_prices, "Number of prices", "N" },
+    { "lookups", 0, 0, G_OPTION_ARG_INT, &opt_lookups,
+      "Number of lookups in the lookup benchmarks", "N" },
+    { "only", 0, 0, G_OPTION_ARG_STRING, &opt_only,
+      "Run only these comma separated benchmarks", "NAMES" },
+    { "output", 'o', 0, G_OPTION_ARG_FILENAME, &opt_output,
+      "Write the JSON results here instead of to stdout", "FILE" },
+    { "tmpdir", 0, 0, G_OPTION_ARG_FILENAME, &opt_tmpdir,
+      "Directory for the files saved by the backend benchmarks", "DIR" },
+    { nullptr }
+};
+
+struct BenchResult
+{
+    std::string name;
+    double seconds;
+    guint64 operations;
+    std::string skipped;
+};
+
+struct BenchBook
+{
+    QofBook* book = nullptr;
+    Account* root = nullptr;
+    gnc_commodity* currency = nullptr;
+    std::vector<gnc_commodity*> securities;
+    std::vector<Account*> accounts;
+    std::vector<Account*> leaves;
+    std::vector<std::string> payees;
+    time64 last_date = bench_epoch;
+};
+
+class Bench
+{
+public:
+    Bench () : m_rng (opt_seed) {}
+    int run ();
+
+private:
+    bool selected (const char* name) const;
+    void time (const char* name, const std::function<guint64 ()>& func);
+    void skip (const char* name, const std::string& why);
+    guint64 uniform (guint64 n) { return m_rng () % n; }
+
+    void generate_commodities ();
+    void generate_accounts ();
+    void generate_transactions ();
+    void generate_prices ();
+    void generate_import_map ();
+    GList* payee_tokens (const std::string& payee);
+
+    void bench_session (const char* name, const char* scheme);
+    void write_json (FILE* out) const;
+
+    std::mt19937_64 m_rng;
+    BenchBook m_data;
+    /* Owns m_data.book. */
+    QofSession* m_session = nullptr;
+    std::vector<BenchResult> m_results;
+};
+
+bool
+Bench::selected (const char* name) const
+{
+    if (!opt_only)
+        return true;
+    auto names = g_strsplit (opt_only, ",", -1);
+    auto found = g_strv_contains (names, name);
+    g_strfreev (names);
+    return found;
+}
+
+void
+Bench::time (const char* name, const std::function<guint64 ()>& func)
+{
+    g_printerr ("%s...", name);
+    auto start = std::chrono::steady_clock::now ();
+    auto ops = func ();
+    std::chrono::duration<double> secs = std::chrono::steady_clock::now () - start;
+    g_printerr (" %.3fs\n", secs.count ());
+    m_results.push_back ({name, secs.count (), ops, ""});
+}
+
+void
+Bench::skip (const char* name, const std::string& why)
+{
+    g_printerr ("%s skipped: %s\n", name, why.c_str ());
+    m_results.push_back ({name, 0.0, 0, why});
+}
+
+void
+Bench::generate_commodities ()
+{
+    auto table = gnc_commodity_table_get_table (m_data.book);
+
+    m_data.currency = gnc_commodity_table_lookup (table, GNC_COMMODITY_NS_CURRENCY,
+                                                  "USD");
+    for (int i = 0; i < bench_n_securities; ++i)
+    {
+        auto mnemonic = g_strdup_printf ("SEC%03d", i);
+        auto com = gnc_commodity_new (m_data.book, mnemonic, "BENCH", mnemonic,
+                                      nullptr, 10000);
+        m_data.securities.push_back (gnc_commodity_table_insert (table, com));
+        g_free (mnemonic);
+    }
+}
+
+/* A tree ten wide under the five top level types, the way real books
+ * group their accounts. Every tenth asset account holds a security. */
+void
+Bench::generate_accounts ()
+{
+    static const GNCAccountType top_types[] =
+    {
+        ACCT_TYPE_ASSET, ACCT_TYPE_LIABILITY, ACCT_TYPE_INCOME,
+        ACCT_TYPE_EXPENSE, ACCT_TYPE_EQUITY
+    };
+    std::vector<std::pair<Account*, GNCAccountType>> parents;
+    auto n_accounts = static_cast<size_t> (opt_accounts);
+
+    m_data.root = gnc_book_get_root_account (m_data.book);
+    for (auto type : top_types)
+    {
+        auto acc = xaccMallocAccount (m_data.book);
+        xaccAccountBeginEdit (acc);
+        xaccAccountSetType (acc, type);
+        xaccAccountSetName (acc, xaccAccountTypeEnumAsString (type));
+        xaccAccountSetCommodity (acc, m_data.currency);
+        gnc_account_append_child (m_data.root, acc);
+        m_data.accounts.push_back (acc);
+        parents.emplace_back (acc, type);
+    }
+
+    for (size_t next = 0; m_data.accounts.size () < n_accounts; ++next)
+    {
+        auto parent = parents[next].first;
+        auto type = parents[next].second;
+        for (int i = 0; i < 10 && m_data.accounts.size () < n_accounts; ++i)
+        {
+            auto acc = xaccMallocAccount (m_data.book);
+            auto name = g_strdup_printf ("%s %zu", xaccAccountGetName (parent),
+                                         m_data.accounts.size ());
+            xaccAccountBeginEdit (acc);
+            xaccAccountSetName (acc, name);
+            g_free (name);
+            gnc_account_append_child (parent, acc);
+            m_data.accounts.push_back (acc);
+            if (type == ACCT_TYPE_ASSET && m_data.accounts.size () % 10 == 0)
+            {
+                /* Securities only at the leaves. */
+                xaccAccountSetType (acc, ACCT_TYPE_STOCK);
+                xaccAccountSetCommodity (acc, m_data.securities[uniform (bench_n_securities)]);
+                continue;
+            }
+            xaccAccountSetType (acc, type == ACCT_TYPE_ASSET ? ACCT_TYPE_BANK : type);
+            xaccAccountSetCommodity (acc, m_data.currency);
+            parents.emplace_back (acc, type);
+        }
+    }
+
+    for (auto acc : m_data.accounts)
+        if (!gnc_account_n_children (acc))
+            m_data.leaves.push_back (acc);
+}
+
+/* Two split transactions between random leaves, a few a day. Accounts
+ * stay open for editing so that their balances are computed once, at the
+ * end, as when loading a book. */
+void
+Bench::generate_transactions ()
+{
+    auto n_trans = opt_splits / 2;
+    auto days = std::max<gint64> (1, opt_prices / bench_n_securities);
+
+    for (int i = 0; i < bench_n_payees; ++i)
+    {
+        auto words = g_strdup_printf ("Payee %d Store %d Invoice", i, i % 97);
+        m_data.payees.push_back (words);
+        g_free (words);
+    }
+
+    for (int i = 0; i < n_trans; ++i)
+    {
+        auto trans = xaccMallocTransaction (m_data.book);
+        auto date = bench_epoch + (static_cast<gint64> (i) * days / n_trans) * bench_day;
+        auto from = m_data.leaves[uniform (m_data.leaves.size ())];
+        auto to = m_data.leaves[uniform (m_data.leaves.size ())];
+        auto value = gnc_numeric_create (1 + uniform (1000000), 100);
+
+        xaccTransBeginEdit (trans);
+        xaccTransSetCurrency (trans, m_data.currency);
+        xaccTransSetDatePostedSecsNormalized (trans, date);
+        xaccTransSetDateEnteredSecs (trans, date);
+        xaccTransSetDescription (trans, m_data.payees[uniform (bench_n_payees)].c_str ());
+
+        for (auto acc : { from, to })
+        {
+            auto split = xaccMallocSplit (m_data.book);
+            xaccSplitSetParent (split, trans);
+            xaccSplitSetAccount (split, acc);
+            if (gnc_commodity_equal (xaccAccountGetCommodity (acc), m_data.currency))
+                xaccSplitSetAmount (split, value);
+            else
+                xaccSplitSetAmount (split, gnc_numeric_create (1 + uniform (1000), 1));
+            xaccSplitSetValue (split, value);
+            value = gnc_numeric_neg (value);
+        }
+        xaccTransCommitEdit (trans);
+        m_data.last_date = date;
+    }
+
+    for (auto acc : m_data.accounts)
+        xaccAccountCommitEdit (acc);
+}
+
+void
+Bench::generate_prices ()
+{
+    auto pdb = gnc_pricedb_get_db (m_data.book);
+    auto per_security = opt_prices / bench_n_securities;
+
+    gnc_pricedb_set_bulk_update (pdb, TRUE);
+    for (int s = 0; s < bench_n_securities; ++s)
+    {
+        gint64 price_val = 1000 + uniform (100000);
+        for (int d = 0; d < per_security; ++d)
+        {
+            auto price = gnc_price_create (m_data.book);
+            price_val = std::max<gint64> (1, price_val + static_cast<gint64> (uniform (201)) - 100);
+            gnc_price_begin_edit (price);
+            gnc_price_set_commodity (price, m_data.securities[s]);
+            gnc_price_set_currency (price, m_data.currency);
+            gnc_price_set_time64 (price, bench_epoch + d * bench_day);
+            gnc_price_set_source (price, PRICE_SOURCE_FQ);
+            gnc_price_set_typestr (price, PRICE_TYPE_LAST);
+            gnc_price_set_value (price, gnc_numeric_create (price_val, 100));
+            gnc_price_commit_edit (price);
+            gnc_pricedb_add_price (pdb, price);
+            gnc_price_unref (price);
+        }
+    }
+    gnc_pricedb_set_bulk_update (pdb, FALSE);
+}
+
+GList*
+Bench::payee_tokens (const std::string& payee)
+{
+    GList* tokens = nullptr;
+    auto words = g_strsplit (payee.c_str (), " ", -1);
+    for (auto word = words; *word; ++word)
+        tokens = g_list_prepend (tokens, g_strdup (*word));
+    g_strfreev (words);
+    return tokens;
+}
+
+void
+Bench::generate_import_map ()
+{
+    auto source = m_data.leaves.front ();
+    auto imap = gnc_account_imap_create_imap (source);
+
+    xaccAccountBeginEdit (source);
+    for (int i = 0; i < bench_n_payees; ++i)
+    {
+        auto tokens = payee_tokens (m_data.payees[i]);
+        gnc_account_imap_add_account_bayes (imap, tokens,
+                                            m_data.leaves[uniform (m_data.leaves.size ())]);
+        g_list_free_full (tokens, g_free);
+    }
+    xaccAccountCommitEdit (source);
+    g_free (imap);
+}
+
+void
+Bench::bench_session (const char* name, const char* scheme)
+{
+    auto save_name = std::string (name) + "-save";
+    auto load_name = std::string (name) + "-load";
+    if (!selected (save_name.c_str ()) && !selected (load_name.c_str ()))
+        return;
+
+    auto path = g_build_filename (opt_tmpdir ? opt_tmpdir : g_get_tmp_dir (),
+                                  "gnc-bench.gnucash", nullptr);
+    auto uri = g_strdup_printf ("%s://%s", scheme, path);
+    g_unlink (path);
+
+    qof_session_begin (m_session, uri, SESSION_NEW_OVERWRITE);
+    auto err = qof_session_get_error (m_session);
+    if (err != ERR_BACKEND_NO_ERR)
+    {
+        auto why = std::string ("can't open ") + uri + ": error " + std::to_string (err);
+        skip (save_name.c_str (), why);
+        skip (load_name.c_str (), why);
+        qof_session_end (m_session);
+        g_free (uri);
+        g_free (path);
+        return;
+    }
+
+    time (save_name.c_str (), [&] ()
+    {
+        qof_session_save (m_session, nullptr);
+        return static_cast<guint64> (opt_splits);
+    });
+    qof_session_end (m_session);
+
+    time (load_name.c_str (), [&] ()
+    {
+        auto book = qof_book_new ();
+        auto load = qof_session_new (book);
+        qof_session_begin (load, uri, SESSION_READ_ONLY);
+        qof_session_load (load, nullptr);
+        if (qof_session_get_error (load) != ERR_BACKEND_NO_ERR)
+            PWARN ("Loading %s failed", uri);
+        qof_session_end (load);
+        qof_session_destroy (load);
+        return static_cast<guint64> (opt_splits);
+    });
+
+    g_unlink (path);
+    g_free (uri);
+    g_free (path);
+}
+
+int
+Bench::run ()
+{
+    m_data.book = qof_book_new ();
+
+    time ("generate-book", [this] ()
+    {
+        generate_commodities ();
+        generate_accounts ();
+        generate_transactions ();
+        generate_prices ();
+        generate_import_map ();
+        return static_cast<guint64> (opt_splits);
+    });
+
+    if (selected ("recompute-balances"))
+        time ("recompute-balances", [this] ()
+        {
+            for (auto acc : m_data.accounts)
+                xaccAccountRecomputeBalance (acc);
+            return static_cast<guint64> (m_data.accounts.size ());
+        });
+
+    if (selected ("balance-as-of-date"))
+        time ("balance-as-of-date", [this] ()
+        {
+            auto span = (m_data.last_date - bench_epoch) / bench_day + 1;
+            for (int i = 0; i < opt_lookups; ++i)
+            {
+                auto acc = m_data.leaves[uniform (m_data.leaves.size ())];
+                xaccAccountGetBalanceAsOfDate (acc, bench_epoch + uniform (span) * bench_day);
+            }
+            return static_cast<guint64> (opt_lookups);
+        });
+
+    if (selected ("pricedb-lookup"))
+        time ("pricedb-lookup", [this] ()
+        {
+            auto pdb = gnc_pricedb_get_db (m_data.book);
+            auto span = opt_prices / bench_n_securities + 1;
+            for (int i = 0; i < opt_lookups; ++i)
+            {
+                auto com = m_data.securities[uniform (bench_n_securities)];
+                auto price = gnc_pricedb_lookup_nearest_in_time64 (
+                    pdb, com, m_data.currency, bench_epoch + uniform (span) * bench_day);
+                gnc_price_unref (price);
+            }
+            return static_cast<guint64> (opt_lookups);
+        });
+
+    if (selected ("query"))
+        time ("query", [this] ()
+        {
+            guint64 found = 0;
+            auto span = m_data.last_date - bench_epoch;
+            for (int i = 0; i < 10; ++i)
+            {
+                auto start = bench_epoch + span / 10 * i;
+                auto q = qof_query_create_for (GNC_ID_SPLIT);
+                qof_query_set_book (q, m_data.book);
+                xaccQueryAddDateMatchTT (q, TRUE, start, TRUE,
+                                         start + 30 * bench_day, QOF_QUERY_AND);
+                found += g_list_length (qof_query_run (q));
+                qof_query_destroy (q);
+            }
+            return found;
+        });
+
+    if (selected ("bayes-match"))
+        time ("bayes-match", [this] ()
+        {
+            auto imap = gnc_account_imap_create_imap (m_data.leaves.front ());
+            for (int i = 0; i < opt_lookups / 100; ++i)
+            {
+                auto tokens = payee_tokens (m_data.payees[uniform (bench_n_payees)]);
+                gnc_account_imap_find_account_bayes (imap, tokens);
+                g_list_free_full (tokens, g_free);
+            }
+            g_free (imap);
+            return static_cast<guint64> (opt_lookups / 100);
+        });
+
+    if (selected ("scrub"))
+        time ("scrub", [this] ()
+        {
+            xaccAccountTreeScrubOrphans (m_data.root, nullptr);
+            xaccAccountTreeScrubImbalance (m_data.root, nullptr);
+            return static_cast<guint64> (opt_splits);
+        });
+
+    m_session = qof_session_new (m_data.book);
+    bench_session ("xml", "xml");
+    bench_session ("sqlite", "sqlite3");
+    qof_session_destroy (m_session);
+
+    auto out = opt_output ? g_fopen (opt_output, "w") : stdout;
+    if (!out)
+    {
+        g_printerr ("Can't write %s\n", opt_output);
+        return 1;
+    }
+    write_json (out);
+    if (out != stdout)
+        fclose (out);
+    return 0;
+}
+
+static void
+json_string (FILE* out, const std::string& str)
+{
+    fputc ('"', out);
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\')
+            fprintf (out, "\\%c", c);
+        else if (static_cast<unsigned char> (c) < 0x20)
+            fprintf (out, "\\u%04x", c);
+        else
+            fputc (c, out);
+    }
+    fputc ('"', out);
+}
+
+void
+Bench::write_json (FILE* out) const
+{
+    fprintf (out, "{\n  \"benchmark\": \"gnc-bench\",\n  \"version\": ");
+    json_string (out, PROJECT_VERSION);
+    fprintf (out, ",\n  \"parameters\": {\"seed\": %" G_GINT64_FORMAT
+             ", \"accounts\": %d, \"splits\": %d, \"prices\": %d"
+             ", \"lookups\": %d},\n  \"results\": [",
+             opt_seed, opt_accounts, opt_splits, opt_prices, opt_lookups);
+    for (size_t i = 0; i < m_results.size (); ++i)
+    {
+        auto& res = m_results[i];
+        fprintf (out, "%s\n    {\"name\": ", i ? "," : "");
+        json_string (out, res.name);
+        if (res.skipped.empty ())
+            fprintf (out, ", \"seconds\": %.6f, \"operations\": %" G_GUINT64_FORMAT "}",
+                     res.seconds, res.operations);
+        else
+        {
+            fprintf (out, ", \"skipped\": ");
+            json_string (out, res.skipped);
+            fputc ('}', out);
+        }
+    }
+    fprintf (out, "\n  ]\n}\n");
+}
+
+int
+main (int argc, char** argv)
+{
+    GError* error = nullptr;
+    auto context = g_option_context_new ("- benchmark the GnuCash engine");
+
+    g_option_context_add_main_entries (context, bench_options, nullptr);
+    if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+        g_printerr ("%s\n", error->message);
+        g_error_free (error);
+        return 1;
+    }
+    g_option_context_free (context);
+    if (opt_accounts < 10 || opt_splits < 2 || opt_prices < bench_n_securities)
+    {
+        g_printerr ("Need at least 10 accounts, 2 splits and %d prices.\n",
+                    bench_n_securities);
+        return 1;
+    }
+
+    qof_log_init ();
+    qof_log_set_default (QOF_LOG_WARNING);
+    gnc_engine_init (0, nullptr);
+
+    Bench bench;
+    auto ret = bench.run ();
+
+    gnc_engine_shutdown ();
+    return ret;
+}
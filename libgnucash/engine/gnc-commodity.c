@@ -87,6 +87,10 @@ typedef struct gnc_commodityPrivate
 
     /* the default display_symbol, set in iso-4217-currencies at start-up */
     const char * default_symbol;
+
+    /* the namespace whose lookup indexes hold this commodity, NULL if it
+     * isn't in a commodity table */
+    gnc_commodity_namespace * indexed_in;
 } gnc_commodityPrivate;
 
 #define GET_PRIVATE(o) \
@@ -108,6 +112,12 @@ struct gnc_commodity_namespace_s
     gboolean     iso4217;
     GHashTable * cm_table;
     GList      * cm_list;
+
+    /* Secondary lookup indexes. Each maps a key to the GList of the
+     * namespace's commodities with that key, in insertion order. */
+    GHashTable * printname_index;
+    GHashTable * cusip_index;
+    GHashTable * quote_source_index; /* by quote source internal name */
 };
 
 struct _GncCommodityNamespaceClass
@@ -649,6 +659,86 @@ reset_unique_name(gnc_commodityPrivate *priv)
                                         priv->mnemonic ? priv->mnemonic : "");
 }
 
+static GHashTable *
+index_new (void)
+{
+    return g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+}
+
+static void
+index_free_list (gpointer key, gpointer value, gpointer data)
+{
+    g_list_free (value);
+}
+
+static void
+index_destroy (GHashTable *index)
+{
+    g_hash_table_foreach (index, index_free_list, NULL);
+    g_hash_table_destroy (index);
+}
+
+static void
+index_add (GHashTable *index, const char *key, gnc_commodity *cm)
+{
+    GList *list;
+
+    if (!key || !*key) return;
+    list = g_hash_table_lookup (index, key);
+    /* Appending to a non-empty list leaves its head, and so the index
+     * entry, unchanged. */
+    if (list)
+        g_list_append (list, cm);
+    else
+        g_hash_table_insert (index, g_strdup (key), g_list_append (NULL, cm));
+}
+
+static void
+index_remove (GHashTable *index, const char *key, gnc_commodity *cm)
+{
+    GList *list, *rest;
+
+    if (!key || !*key) return;
+    list = g_hash_table_lookup (index, key);
+    rest = g_list_remove (list, cm);
+    if (rest == list) return;
+    if (rest)
+        g_hash_table_insert (index, g_strdup (key), rest);
+    else
+        g_hash_table_remove (index, key);
+}
+
+/* Add a commodity to, or remove it from, the lookup indexes of the
+ * namespace that holds it. Setters that change a key call
+ * commodity_unindex before the change and commodity_index after it. */
+static void
+commodity_index (gnc_commodity *cm)
+{
+    gnc_commodityPrivate* priv = GET_PRIVATE(cm);
+    gnc_commodity_namespace *ns = priv->indexed_in;
+
+    if (!ns) return;
+    index_add (ns->printname_index, priv->printname, cm);
+    index_add (ns->cusip_index, priv->cusip, cm);
+    if (priv->quote_source)
+        index_add (ns->quote_source_index, priv->quote_source->internal_name,
+                   cm);
+}
+
+static void
+commodity_unindex (gnc_commodity *cm)
+{
+    gnc_commodityPrivate* priv = GET_PRIVATE(cm);
+    gnc_commodity_namespace *ns = priv->indexed_in;
+
+    if (!ns) return;
+    index_remove (ns->printname_index, priv->printname, cm);
+    index_remove (ns->cusip_index, priv->cusip, cm);
+    if (priv->quote_source)
+        index_remove (ns->quote_source_index,
+                      priv->quote_source->internal_name, cm);
+}
+
 /* GObject Initialization */
 G_DEFINE_TYPE_WITH_PRIVATE(gnc_commodity, gnc_commodity, QOF_TYPE_INSTANCE);
 
@@ -931,6 +1021,9 @@ commodity_free(gnc_commodity * cm)
     table = gnc_commodity_table_get_table(book);
     gnc_commodity_table_remove(table, cm);
     priv = GET_PRIVATE(cm);
+    /* In case the table couldn't find it under its current mnemonic. */
+    commodity_unindex(cm);
+    priv->indexed_in = NULL;
 
     qof_event_gen (&cm->inst, QOF_EVENT_DESTROY, NULL);
 
@@ -1238,12 +1331,14 @@ gnc_commodity_set_mnemonic(gnc_commodity * cm, const char * mnemonic)
     if (priv->mnemonic == mnemonic) return;
 
     gnc_commodity_begin_edit(cm);
+    commodity_unindex(cm);
     CACHE_REMOVE (priv->mnemonic);
     priv->mnemonic = CACHE_INSERT(mnemonic);
 
     mark_commodity_dirty (cm);
     reset_printname(priv);
     reset_unique_name(priv);
+    commodity_index(cm);
     gnc_commodity_commit_edit(cm);
 }
 
@@ -1268,12 +1363,14 @@ gnc_commodity_set_namespace(gnc_commodity * cm, const char * name_space)
         return;
 
     gnc_commodity_begin_edit(cm);
+    commodity_unindex(cm);
     priv->name_space = nsp;
     if (nsp->iso4217)
         priv->quote_source = gnc_quote_source_lookup_by_internal("currency");
     mark_commodity_dirty(cm);
     reset_printname(priv);
     reset_unique_name(priv);
+    commodity_index(cm);
     gnc_commodity_commit_edit(cm);
 }
 
@@ -1290,12 +1387,14 @@ gnc_commodity_set_fullname(gnc_commodity * cm, const char * fullname)
     priv = GET_PRIVATE(cm);
     if (priv->fullname == fullname) return;
 
+    commodity_unindex(cm);
     CACHE_REMOVE (priv->fullname);
     priv->fullname = CACHE_INSERT (fullname);
 
     gnc_commodity_begin_edit(cm);
     mark_commodity_dirty(cm);
     reset_printname(priv);
+    commodity_index(cm);
     gnc_commodity_commit_edit(cm);
 }
 
@@ -1315,8 +1414,10 @@ gnc_commodity_set_cusip(gnc_commodity * cm,
     if (priv->cusip == cusip) return;
 
     gnc_commodity_begin_edit(cm);
+    commodity_unindex(cm);
     CACHE_REMOVE (priv->cusip);
     priv->cusip = CACHE_INSERT (cusip);
+    commodity_index(cm);
     mark_commodity_dirty(cm);
     gnc_commodity_commit_edit(cm);
 }
@@ -1429,7 +1530,9 @@ gnc_commodity_set_quote_source(gnc_commodity *cm, gnc_quote_source *src)
 
     if (!cm) return;
     gnc_commodity_begin_edit(cm);
+    commodity_unindex(cm);
     GET_PRIVATE(cm)->quote_source = src;
+    commodity_index(cm);
     mark_commodity_dirty(cm);
     gnc_commodity_commit_edit(cm);
     LEAVE(" ");
@@ -1862,26 +1965,33 @@ gnc_commodity *
 gnc_commodity_table_lookup_unique(const gnc_commodity_table *table,
                                   const char * unique_name)
 {
-    char *name_space;
-    char *mnemonic;
+    char buf[64];
+    char *long_name_space = NULL;
+    const char *name_space = buf;
+    const char *mnemonic;
     gnc_commodity *commodity;
+    size_t len;
 
     if (!table || !unique_name) return NULL;
 
-    name_space = g_strdup (unique_name);
-    mnemonic = strstr (name_space, "::");
+    mnemonic = strstr (unique_name, "::");
     if (!mnemonic)
-    {
-        g_free (name_space);
         return NULL;
-    }
 
-    *mnemonic = '\0';
+    /* Namespaces are short, so the copy needs the heap only rarely. */
+    len = mnemonic - unique_name;
+    if (len < sizeof (buf))
+    {
+        memcpy (buf, unique_name, len);
+        buf[len] = '\0';
+    }
+    else
+        name_space = long_name_space = g_strndup (unique_name, len);
     mnemonic += 2;
 
     commodity = gnc_commodity_table_lookup (table, name_space, mnemonic);
 
-    g_free (name_space);
+    g_free (long_name_space);
 
     return commodity;
 }
@@ -1891,32 +2001,91 @@ gnc_commodity_table_lookup_unique(const gnc_commodity_table *table,
  * locate a commodity by namespace and printable name
  ********************************************************************/
 
+static gboolean
+namespace_is_noncurrency (const gnc_commodity_namespace *ns)
+{
+    return g_strcmp0 (ns->name, GNC_COMMODITY_NS_CURRENCY) != 0 &&
+           g_strcmp0 (ns->name, GNC_COMMODITY_NS_TEMPLATE) != 0;
+}
+
 gnc_commodity *
 gnc_commodity_table_find_full(const gnc_commodity_table * table,
                               const char * name_space,
                               const char * fullname)
 {
-    gnc_commodity * retval = NULL;
-    GList         * all;
-    GList         * iterator;
+    gnc_commodity_namespace * ns;
+    GList                   * node;
+    GList                   * found = NULL;
 
-    if (!fullname || (fullname[0] == '\0'))
+    if (!table || !fullname || (fullname[0] == '\0'))
         return NULL;
 
-    all = gnc_commodity_table_get_commodities(table, name_space);
-
-    for (iterator = all; iterator; iterator = iterator->next)
+    if (g_strcmp0(name_space, GNC_COMMODITY_NS_NONCURRENCY) == 0)
     {
-        if (!strcmp(fullname,
-                    gnc_commodity_get_printname(iterator->data)))
+        for (node = table->ns_list; node && !found; node = node->next)
         {
-            retval = iterator->data;
-            break;
+            ns = node->data;
+            if (namespace_is_noncurrency (ns))
+                found = g_hash_table_lookup (ns->printname_index, fullname);
         }
     }
+    else
+    {
+        ns = gnc_commodity_table_find_namespace(table, name_space);
+        if (ns)
+            found = g_hash_table_lookup (ns->printname_index, fullname);
+    }
+
+    return found ? found->data : NULL;
+}
+
+/********************************************************************
+ * gnc_commodity_table_find_by_cusip
+ * locate a commodity by CUSIP, ISIN or other identifying code
+ ********************************************************************/
+
+gnc_commodity *
+gnc_commodity_table_find_by_cusip(const gnc_commodity_table * table,
+                                  const char * cusip)
+{
+    GList * node;
+    GList * found;
+
+    if (!table || !cusip || (cusip[0] == '\0'))
+        return NULL;
+
+    for (node = table->ns_list; node; node = node->next)
+    {
+        gnc_commodity_namespace *ns = node->data;
+        found = g_hash_table_lookup (ns->cusip_index, cusip);
+        if (found)
+            return found->data;
+    }
+    return NULL;
+}
 
-    g_list_free (all);
+/********************************************************************
+ * gnc_commodity_table_find_by_quote_source
+ * list the commodities that use a quote source
+ ********************************************************************/
 
+CommodityList *
+gnc_commodity_table_find_by_quote_source(const gnc_commodity_table * table,
+                                         const gnc_quote_source * source)
+{
+    GList * node;
+    GList * retval = NULL;
+
+    if (!table || !source)
+        return NULL;
+
+    for (node = table->ns_list; node; node = node->next)
+    {
+        gnc_commodity_namespace *ns = node->data;
+        GList *found = g_hash_table_lookup (ns->quote_source_index,
+                                            source->internal_name);
+        retval = g_list_concat (retval, g_list_copy (found));
+    }
     return retval;
 }
 
@@ -1996,6 +2165,8 @@ gnc_commodity_table_insert(gnc_commodity_table * table,
                         CACHE_INSERT(priv->mnemonic),
                         (gpointer)comm);
     nsp->cm_list = g_list_append(nsp->cm_list, comm);
+    priv->indexed_in = nsp;
+    commodity_index(comm);
 
     qof_event_gen (&comm->inst, QOF_EVENT_ADD, NULL);
     LEAVE ("(table=%p, comm=%p)", table, comm);
@@ -2031,6 +2202,8 @@ gnc_commodity_table_remove(gnc_commodity_table * table,
 
     nsp->cm_list = g_list_remove(nsp->cm_list, comm);
     g_hash_table_remove (nsp->cm_table, priv->mnemonic);
+    commodity_unindex(comm);
+    priv->indexed_in = NULL;
     /* XXX minor mem leak, should remove the key as well */
 }
 
@@ -2190,30 +2363,19 @@ gnc_commodity_table_get_commodities(const gnc_commodity_table * table,
  * list commodities in a given namespace that get price quotes
  ********************************************************************/
 
+/* Called for each of a namespace's quote sources with the list of the
+ * commodities that use it. */
 static void
-get_quotables_helper1(gpointer key, gpointer value, gpointer data)
+get_quotables_helper(gpointer key, gpointer value, gpointer data)
 {
-    gnc_commodity *comm = value;
-    gnc_commodityPrivate* priv = GET_PRIVATE(comm);
+    GList * node = value;
     GList ** l = data;
 
-    if (!priv->quote_flag ||
-            !priv->quote_source || !priv->quote_source->supported)
+    if (!GET_PRIVATE(node->data)->quote_source->supported)
         return;
-    *l = g_list_prepend(*l, value);
-}
-
-static gboolean
-get_quotables_helper2 (gnc_commodity *comm, gpointer data)
-{
-    GList ** l = data;
-    gnc_commodityPrivate* priv = GET_PRIVATE(comm);
-
-    if (!priv->quote_flag ||
-            !priv->quote_source || !priv->quote_source->supported)
-        return TRUE;
-    *l = g_list_prepend(*l, comm);
-    return TRUE;
+    for (; node; node = node->next)
+        if (GET_PRIVATE(node->data)->quote_flag)
+            *l = g_list_prepend(*l, node->data);
 }
 
 CommodityList *
@@ -2248,7 +2410,8 @@ gnc_commodity_table_get_quotable_commodities(const gnc_commodity_table * table)
                 ns = gnc_commodity_table_find_namespace(table, name_space);
                 if (ns)
                 {
-                    g_hash_table_foreach(ns->cm_table, &get_quotables_helper1, (gpointer) &l);
+                    g_hash_table_foreach(ns->quote_source_index,
+                                         &get_quotables_helper, (gpointer) &l);
                 }
             }
         }
@@ -2257,8 +2420,12 @@ gnc_commodity_table_get_quotable_commodities(const gnc_commodity_table * table)
     }
     else
     {
-        gnc_commodity_table_foreach_commodity(table, get_quotables_helper2,
-                                              (gpointer) &l);
+        for (tmp = table->ns_list; tmp; tmp = tmp->next)
+        {
+            ns = tmp->data;
+            g_hash_table_foreach(ns->quote_source_index,
+                                 &get_quotables_helper, (gpointer) &l);
+        }
     }
     LEAVE("list head %p", l);
     return l;
@@ -2302,6 +2469,9 @@ gnc_commodity_table_add_namespace(gnc_commodity_table * table,
     {
         ns = g_object_new(GNC_TYPE_COMMODITY_NAMESPACE, NULL);
         ns->cm_table = g_hash_table_new(g_str_hash, g_str_equal);
+        ns->printname_index = index_new();
+        ns->cusip_index = index_new();
+        ns->quote_source_index = index_new();
         ns->name = CACHE_INSERT((gpointer)name_space);
         ns->iso4217 = gnc_commodity_namespace_is_iso(name_space);
         qof_instance_init_data (&ns->inst, GNC_ID_COMMODITY_NAMESPACE, book);
@@ -2347,6 +2517,8 @@ static int
 ns_helper(gpointer key, gpointer value, gpointer user_data)
 {
     gnc_commodity * c = value;
+    /* The namespace's indexes go with it. */
+    GET_PRIVATE(c)->indexed_in = NULL;
     gnc_commodity_destroy(c);
     CACHE_REMOVE(key);  /* key is commodity mnemonic */
     return TRUE;
@@ -2373,6 +2545,9 @@ gnc_commodity_table_delete_namespace(gnc_commodity_table * table,
 
     g_hash_table_foreach_remove(ns->cm_table, ns_helper, NULL);
     g_hash_table_destroy(ns->cm_table);
+    index_destroy(ns->printname_index);
+    index_destroy(ns->cusip_index);
+    index_destroy(ns->quote_source_index);
     CACHE_REMOVE(ns->name);
 
     qof_event_gen (&ns->inst, QOF_EVENT_DESTROY, NULL);
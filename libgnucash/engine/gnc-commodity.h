@@ -746,9 +746,32 @@ gnc_commodity * gnc_commodity_table_lookup(const gnc_commodity_table * table,
 gnc_commodity *
 gnc_commodity_table_lookup_unique(const gnc_commodity_table *table,
                                   const char * unique_name);
+/** Find a commodity by its print name, see gnc_commodity_get_printname().
+ *
+ *  @param t A pointer to the commodity table
+ *
+ *  @param commodity_namespace The namespace to search, or
+ *  GNC_COMMODITY_NS_NONCURRENCY for all but currencies and templates.
+ *
+ *  @param fullname The print name.
+ *
+ *  @return The commodity, or NULL if there is none. */
 gnc_commodity * gnc_commodity_table_find_full(const gnc_commodity_table * t,
         const char * commodity_namespace,
         const char * fullname);
+/** Find a commodity in any namespace by its CUSIP, ISIN or other
+ *  identifying code, see gnc_commodity_get_cusip().
+ *
+ *  @return The first commodity added with that code, or NULL if there
+ *  is none. */
+gnc_commodity * gnc_commodity_table_find_by_cusip(
+    const gnc_commodity_table * table, const char * cusip);
+/** Return a list of the commodities, in all namespaces, that use a quote
+ *  source.
+ *
+ *  @note It is the callers responsibility to free the list. */
+CommodityList * gnc_commodity_table_find_by_quote_source(
+    const gnc_commodity_table * table, const gnc_quote_source * source);
 
 /*@ dependent @*/
 gnc_commodity * gnc_commodity_find_commodity_by_guid(const GncGUID *guid,
@@ -822,6 +822,290 @@ gnc_price_list_equal(PriceList *prices1, PriceList *prices2)
     return TRUE;
 }
 
+/* ==================================================================== */
+/* Price list index
+
+   Each price list in the hashes is indexed by day, so that finding the
+   prices of a day, and the place of a new price, is a binary search
+   rather than a walk down the list. A PriceIndex holds, in ascending
+   order of day, the link of the newest price of each day in its list;
+   the day's other prices follow that link.
+ */
+
+typedef struct
+{
+    time64 day;
+    GList *link;
+} PriceDay;
+
+typedef struct
+{
+    const gnc_commodity *commodity;
+    const gnc_commodity *currency;
+    GArray *days;
+} PriceIndex;
+
+static guint
+price_index_hash (gconstpointer key)
+{
+    const PriceIndex *index = key;
+    return g_direct_hash (index->commodity) ^
+        (g_direct_hash (index->currency) * 31);
+}
+
+static gboolean
+price_index_equal (gconstpointer a, gconstpointer b)
+{
+    const PriceIndex *index_a = a;
+    const PriceIndex *index_b = b;
+    return index_a->commodity == index_b->commodity &&
+        index_a->currency == index_b->currency;
+}
+
+static void
+price_index_free (gpointer data)
+{
+    PriceIndex *index = data;
+    g_array_free (index->days, TRUE);
+    g_free (index);
+}
+
+static PriceIndex *
+price_index_lookup (GNCPriceDB *db, const gnc_commodity *commodity,
+                    const gnc_commodity *currency, gboolean create)
+{
+    PriceIndex key, *index;
+
+    key.commodity = commodity;
+    key.currency = currency;
+    index = g_hash_table_lookup (db->price_index, &key);
+    if (!index && create)
+    {
+        index = g_new0 (PriceIndex, 1);
+        index->commodity = commodity;
+        index->currency = currency;
+        index->days = g_array_new (FALSE, FALSE, sizeof (PriceDay));
+        g_hash_table_add (db->price_index, index);
+    }
+    return index;
+}
+
+static inline time64
+price_day (const GNCPrice *p)
+{
+    return time64CanonicalDayTime (p->tmspec);
+}
+
+/* The position of day in the index, or where it would be inserted. */
+static guint
+price_index_find (const PriceIndex *index, time64 day, gboolean *found)
+{
+    guint lo = 0, hi = index->days->len;
+
+    while (lo < hi)
+    {
+        guint mid = lo + (hi - lo) / 2;
+        if (g_array_index (index->days, PriceDay, mid).day < day)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    *found = (lo < index->days->len &&
+              g_array_index (index->days, PriceDay, lo).day == day);
+    return lo;
+}
+
+static gboolean
+price_is_duplicate (const GNCPrice *a, const GNCPrice *b)
+{
+    /* If the date, currency, commodity and price match, it's a duplicate */
+    return gnc_numeric_equal (a->value, b->value) &&
+        a->commodity == b->commodity && a->currency == b->currency &&
+        price_day (a) == price_day (b);
+}
+
+static GList *
+price_list_insert_between (PriceList **prices, GList *prev, GList *next,
+                           GNCPrice *p)
+{
+    GList *link = g_list_alloc ();
+
+    link->data = p;
+    link->prev = prev;
+    link->next = next;
+    if (prev)
+        prev->next = link;
+    else
+        *prices = link;
+    if (next)
+        next->prev = link;
+    return link;
+}
+
+/* Insert p into prices, the list indexed by index, as
+ * gnc_price_list_insert would. */
+static void
+price_index_insert (PriceIndex *index, PriceList **prices, GNCPrice *p,
+                    gboolean check_dupl)
+{
+    time64 day = price_day (p);
+    GList *prev = NULL, *next = NULL, *link;
+    gboolean found;
+    guint pos = price_index_find (index, day, &found);
+
+    gnc_price_ref (p);
+
+    if (found)
+    {
+        PriceDay *entry = &g_array_index (index->days, PriceDay, pos);
+
+        if (check_dupl)
+            for (link = entry->link;
+                 link && price_day (link->data) == day; link = link->next)
+                if (price_is_duplicate (link->data, p))
+                    return;
+
+        prev = entry->link->prev;
+        for (next = entry->link;
+             next && price_day (next->data) == day &&
+                 compare_prices_by_date (p, next->data) > 0;
+             next = next->next)
+            prev = next;
+
+        link = price_list_insert_between (prices, prev, next, p);
+        if (next == entry->link)
+            entry->link = link;
+        return;
+    }
+
+    if (pos > 0)
+    {
+        /* Before the newest price of the previous day. */
+        next = g_array_index (index->days, PriceDay, pos - 1).link;
+        prev = next->prev;
+    }
+    else if (index->days->len > 0)
+    {
+        /* After the oldest price of the first day, which ends the list. */
+        for (prev = g_array_index (index->days, PriceDay, 0).link;
+             prev->next; prev = prev->next)
+            ;
+    }
+
+    link = price_list_insert_between (prices, prev, next, p);
+    {
+        PriceDay entry = { day, link };
+        g_array_insert_val (index->days, pos, entry);
+    }
+}
+
+/* Remove p from prices, the list indexed by index, as
+ * gnc_price_list_remove would. Returns FALSE if p wasn't there. */
+static gboolean
+price_index_remove (PriceIndex *index, PriceList **prices, GNCPrice *p)
+{
+    time64 day = price_day (p);
+    PriceDay *entry;
+    GList *link;
+    gboolean found;
+    guint pos = price_index_find (index, day, &found);
+
+    if (!found)
+        return FALSE;
+
+    entry = &g_array_index (index->days, PriceDay, pos);
+    for (link = entry->link; link && price_day (link->data) == day;
+         link = link->next)
+        if (link->data == p)
+            break;
+    if (!link || link->data != p)
+        return FALSE;
+
+    if (link == entry->link)
+    {
+        if (link->next && price_day (link->next->data) == day)
+            entry->link = link->next;
+        else
+            g_array_remove_index (index->days, pos);
+    }
+
+    *prices = g_list_delete_link (*prices, link);
+    gnc_price_unref (p);
+    return TRUE;
+}
+
+/* Rebuild the index of prices after links were taken out of the list. */
+static void
+price_index_rebuild (PriceIndex *index, PriceList *prices)
+{
+    GList *node;
+    guint i, n;
+
+    g_array_set_size (index->days, 0);
+    for (node = prices; node; node = node->next)
+    {
+        PriceDay entry = { price_day (node->data), node };
+        if (node->prev && price_day (node->prev->data) == entry.day)
+            continue;
+        g_array_append_val (index->days, entry);
+    }
+
+    /* The list is newest first and the index oldest first. */
+    n = index->days->len;
+    for (i = 0; i < n / 2; i++)
+    {
+        PriceDay tmp = g_array_index (index->days, PriceDay, i);
+        g_array_index (index->days, PriceDay, i) =
+            g_array_index (index->days, PriceDay, n - 1 - i);
+        g_array_index (index->days, PriceDay, n - 1 - i) = tmp;
+    }
+}
+
+static gboolean
+price_nearer (const GNCPrice *a, const GNCPrice *b, time64 t)
+{
+    time64 diff_a = llabs (a->tmspec - t);
+    time64 diff_b = llabs (b->tmspec - t);
+
+    /* On a tie prefer the price that existed at t. */
+    return diff_a < diff_b ||
+        (diff_a == diff_b && a->tmspec <= t && b->tmspec > t);
+}
+
+/* The price of the pair, in either direction, which is on the same day
+ * as t and nearest to it, as lookup_nearest_in_time would find. It isn't
+ * refed. */
+static GNCPrice *
+price_index_lookup_day (GNCPriceDB *db, const gnc_commodity *commodity,
+                        const gnc_commodity *currency, time64 t)
+{
+    const gnc_commodity *pairs[2][2] = {{commodity, currency},
+                                        {currency, commodity}};
+    time64 day = time64CanonicalDayTime (t);
+    GNCPrice *result = NULL;
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        PriceIndex *index = price_index_lookup (db, pairs[i][0], pairs[i][1],
+                                                FALSE);
+        GList *link;
+        gboolean found;
+        guint pos;
+
+        if (!index)
+            continue;
+        pos = price_index_find (index, day, &found);
+        if (!found)
+            continue;
+        for (link = g_array_index (index->days, PriceDay, pos).link;
+             link && price_day (link->data) == day; link = link->next)
+            if (!result || price_nearer (link->data, result, t))
+                result = link->data;
+    }
+    return result;
+}
+
 /* ==================================================================== */
 /* GNCPriceDB functions
 
@@ -882,6 +1166,9 @@ gnc_pricedb_create(QofBook * book)
 
     result->commodity_hash = g_hash_table_new(NULL, NULL);
     g_return_val_if_fail (result->commodity_hash, NULL);
+    result->price_index = g_hash_table_new_full (price_index_hash,
+                                                 price_index_equal,
+                                                 price_index_free, NULL);
     return result;
 }
 
@@ -929,6 +1216,8 @@ gnc_pricedb_destroy(GNCPriceDB *db)
     }
     g_hash_table_destroy (db->commodity_hash);
     db->commodity_hash = NULL;
+    g_hash_table_destroy (db->price_index);
+    db->price_index = NULL;
     /* qof_instance_release (&db->inst); */
     g_object_unref(db);
 }
@@ -1111,9 +1400,9 @@ add_price(GNCPriceDB *db, GNCPrice *p)
  * add this one. If this price is of equal or better precedence than the old
  * one, copy this one over the old one.
  */
-    old_price = gnc_pricedb_lookup_day_t64 (db, p->commodity, p->currency,
-                                        p->tmspec);
-    if (!db->bulk_update && old_price != NULL)
+    old_price = db->bulk_update ? NULL :
+        price_index_lookup_day (db, p->commodity, p->currency, p->tmspec);
+    if (old_price != NULL)
     {
         if (p->source > old_price->source)
         {
@@ -1132,11 +1421,8 @@ add_price(GNCPriceDB *db, GNCPrice *p)
     }
 
     price_list = g_hash_table_lookup(currency_hash, currency);
-    if (!gnc_price_list_insert(&price_list, p, !db->bulk_update))
-    {
-        LEAVE ("gnc_price_list_insert failed");
-        return FALSE;
-    }
+    price_index_insert (price_index_lookup (db, commodity, currency, TRUE),
+                        &price_list, p, !db->bulk_update);
 
     if (!price_list)
     {
@@ -1188,6 +1474,57 @@ gnc_pricedb_add_price(GNCPriceDB *db, GNCPrice *p)
     return TRUE;
 }
 
+static gint
+compare_prices_by_pair_day (gconstpointer a, gconstpointer b)
+{
+    const GNCPrice *price_a = a;
+    const GNCPrice *price_b = b;
+    guintptr key_a, key_b;
+
+    key_a = (guintptr)price_a->commodity;
+    key_b = (guintptr)price_b->commodity;
+    if (key_a != key_b)
+        return key_a < key_b ? -1 : 1;
+    key_a = (guintptr)price_a->currency;
+    key_b = (guintptr)price_b->currency;
+    if (key_a != key_b)
+        return key_a < key_b ? -1 : 1;
+    return time64_cmp (price_day (price_a), price_day (price_b));
+}
+
+guint
+gnc_pricedb_add_prices_bulk (GNCPriceDB *db, PriceList *prices)
+{
+    GList *sorted, *node;
+    guint added = 0;
+    gint64 stat_start;
+
+    if (!db || !prices) return 0;
+
+    ENTER ("db=%p, %u prices", db, g_list_length (prices));
+    stat_start = QOF_STAT_TIMER_START ();
+
+    /* Adding each pair's prices oldest first puts every new day at the
+     * end of its index. The sort is stable, so prices of the same day are
+     * still added in the order given. */
+    sorted = g_list_sort (g_list_copy (prices), compare_prices_by_pair_day);
+    for (node = sorted; node; node = node->next)
+        if (add_price (db, node->data))
+            ++added;
+    g_list_free (sorted);
+
+    if (added)
+    {
+        gnc_pricedb_begin_edit(db);
+        qof_instance_set_dirty(&db->inst);
+        gnc_pricedb_commit_edit(db);
+    }
+
+    QOF_STAT_TIMER_STOP ("engine.pricedb.add-bulk", stat_start);
+    LEAVE ("db=%p, added %u", db, added);
+    return added;
+}
+
 /* remove_price() is a utility; its only function is to remove the price
  * from the double-hash tables.
  */
@@ -1195,6 +1532,7 @@ gnc_pricedb_add_price(GNCPriceDB *db, GNCPrice *p)
 static gboolean
 remove_price(GNCPriceDB *db, GNCPrice *p, gboolean cleanup)
 {
+    PriceIndex *index;
     GList *price_list;
     gnc_commodity *commodity;
     gnc_commodity *currency;
@@ -1230,15 +1568,16 @@ remove_price(GNCPriceDB *db, GNCPrice *p, gboolean cleanup)
         return FALSE;
     }
 
-    qof_event_gen (&p->inst, QOF_EVENT_REMOVE, NULL);
     price_list = g_hash_table_lookup(currency_hash, currency);
     gnc_price_ref(p);
-    if (!gnc_price_list_remove(&price_list, p))
+    index = price_index_lookup (db, commodity, currency, FALSE);
+    if (!index || !price_index_remove (index, &price_list, p))
     {
         gnc_price_unref(p);
-        LEAVE (" cannot remove price list");
+        LEAVE (" price not in db");
         return FALSE;
     }
+    qof_event_gen (&p->inst, QOF_EVENT_REMOVE, NULL);
 
     /* if the price list is empty, then remove this currency from the
        commodity hash */
@@ -1249,6 +1588,7 @@ remove_price(GNCPriceDB *db, GNCPrice *p, gboolean cleanup)
     else
     {
         g_hash_table_remove(currency_hash, currency);
+        g_hash_table_remove (db->price_index, index);
 
         if (cleanup)
         {
@@ -1308,19 +1648,22 @@ typedef struct
     gboolean delete_fq;
     gboolean delete_user;
     gboolean delete_app;
-    GSList *list;
+    PriceRemoveKeepOptions keep;
+    GDate *fiscal_end_date;
+    GDateMonth fiscal_month_start;
+    guint candidates;
+    GList *removed;
 } remove_info;
 
 static gboolean
-check_one_price_date (GNCPrice *price, gpointer user_data)
+check_one_price_date (GNCPrice *price, const remove_info *data)
 {
-    remove_info *data = user_data;
     PriceSource source;
     time64 time;
 
     ENTER("price %p (%s), data %p", price,
           gnc_commodity_get_mnemonic(gnc_price_get_commodity(price)),
-          user_data);
+          data);
 
     source = gnc_price_get_source (price);
 
@@ -1333,7 +1676,7 @@ check_one_price_date (GNCPrice *price, gpointer user_data)
     else
     {
         LEAVE("Not a matching source");
-        return TRUE;
+        return FALSE;
     }
 
     time = gnc_price_get_time64 (price);
@@ -1344,82 +1687,12 @@ check_one_price_date (GNCPrice *price, gpointer user_data)
     }
     if (time < data->cutoff)
     {
-        data->list = g_slist_prepend(data->list, price);
         DEBUG("will delete");
+        LEAVE(" ");
+        return TRUE;
     }
     LEAVE(" ");
-    return TRUE;
-}
-
-static void
-pricedb_remove_foreach_pricelist (gpointer key,
-                                  gpointer val,
-                                  gpointer user_data)
-{
-    GList *price_list = (GList *) val;
-    GList *node = price_list;
-    remove_info *data = (remove_info *) user_data;
-
-    ENTER("key %p, value %p, data %p", key, val, user_data);
-
-    /* now check each item in the list */
-    g_list_foreach(node, (GFunc)check_one_price_date, data);
-
-    LEAVE(" ");
-}
-
-static gint
-compare_prices_by_commodity_date (gconstpointer a, gconstpointer b)
-{
-    time64 time_a, time_b;
-    gnc_commodity *comma;
-    gnc_commodity *commb;
-    gnc_commodity *curra;
-    gnc_commodity *currb;
-    gint result;
-
-    if (!a && !b) return 0;
-    /* nothing is always less than something */
-    if (!a) return -1;
-    if (!b) return 1;
-
-    comma = gnc_price_get_commodity ((GNCPrice *) a);
-    commb = gnc_price_get_commodity ((GNCPrice *) b);
-
-    if (!gnc_commodity_equal(comma, commb))
-        return gnc_commodity_compare(comma, commb);
-
-    curra = gnc_price_get_currency ((GNCPrice *) a);
-    currb = gnc_price_get_currency ((GNCPrice *) b);
-
-    if (!gnc_commodity_equal(curra, currb))
-        return gnc_commodity_compare(curra, currb);
-
-    time_a = gnc_price_get_time64((GNCPrice *) a);
-    time_b = gnc_price_get_time64((GNCPrice *) b);
-
-    /* Note we return -1 if time_b is before time_a. */
-    result = time64_cmp(time_b, time_a);
-    if (result) return result;
-
-    /* For a stable sort */
-    return guid_compare (gnc_price_get_guid((GNCPrice *) a),
-                         gnc_price_get_guid((GNCPrice *) b));
-}
-
-static gboolean
-price_commodity_and_currency_equal (GNCPrice *a, GNCPrice *b)
-{
-    gboolean ret_comm = FALSE;
-    gboolean ret_curr = FALSE;
-
-    if (gnc_commodity_equal (gnc_price_get_commodity(a), gnc_price_get_commodity (b)))
-        ret_comm = TRUE;
-
-    if (gnc_commodity_equal (gnc_price_get_currency(a), gnc_price_get_currency (b)))
-        ret_curr = TRUE;
-
-    return (ret_comm && ret_curr);
+    return FALSE;
 }
 
 static void
@@ -1445,24 +1718,6 @@ gnc_pricedb_remove_old_prices_pinfo (GNCPrice *price, gboolean keep_message)
         PINFO("Keep price date is invalid");
 }
 
-static void
-clone_price (GNCPrice **price, GNCPrice *source_price)
-{
-    QofBook *book;
-
-    if (!source_price) return;
-    if (price == NULL) return;
-
-    book = qof_instance_get_book (QOF_INSTANCE(source_price));
-
-    if (*price)
-        gnc_price_unref (*price);
-
-    *price = gnc_price_clone (source_price, book);
-
-    gnc_pricedb_remove_old_prices_pinfo (source_price, TRUE);
-}
-
 static gint
 roundUp (gint numToRound, gint multiple)
 {
@@ -1489,113 +1744,148 @@ get_fiscal_quarter (GDate *date, GDateMonth fiscal_start)
     return q;
 }
 
-static void
-gnc_pricedb_process_removal_list (GNCPriceDB *db, GDate *fiscal_end_date,
-                                  remove_info data, PriceRemoveKeepOptions keep)
+/* The value which a price must not share with the last price kept before
+ * it for it to be kept too. */
+static gint
+price_keep_period (GNCPrice *price, const remove_info *data)
 {
-    GSList *item;
-    gboolean save_first_price = FALSE;
-    gint saved_test_value = 0, next_test_value = 0;
-    GNCPrice *cloned_price = NULL;
-    GDateMonth fiscal_month_start;
-    GDate *tmp_date = g_date_new_dmy (g_date_get_day (fiscal_end_date),
-                                      g_date_get_month (fiscal_end_date),
-                                      g_date_get_year (fiscal_end_date));
+    GDate date = time64_to_gdate (gnc_price_get_time64 (price));
 
-    // get the fiscal start month
-    g_date_subtract_months (tmp_date, 12);
-    fiscal_month_start = g_date_get_month (tmp_date) + 1;
-    g_date_free (tmp_date);
+    switch (data->keep)
+    {
+    case PRICE_REMOVE_KEEP_LAST_PERIOD:
+        // Keep last price in fiscal year
+        gnc_gdate_set_fiscal_year_end (&date, data->fiscal_end_date);
+        return g_date_get_year (&date);
 
-    // sort the list by commodity / currency / date
-    data.list = g_slist_sort (data.list, compare_prices_by_commodity_date);
+    case PRICE_REMOVE_KEEP_LAST_QUARTERLY:
+        // Keep last price in fiscal quarter
+        return get_fiscal_quarter (&date, data->fiscal_month_start);
+
+    case PRICE_REMOVE_KEEP_LAST_MONTHLY:
+        // Keep last price of every month
+        return g_date_get_month (&date);
+
+    case PRICE_REMOVE_KEEP_LAST_WEEKLY:
+        // Keep last price of every week
+        return g_date_get_iso8601_week_of_year (&date);
+
+    default:
+        return 0;
+    }
+}
 
-    /* Now run this external list deleting prices */
-    for (item = data.list; item; item = g_slist_next(item))
+/* Take the prices to be removed out of the price list of one pair in a
+ * single pass. The list is newest first, so the first candidate is the
+ * last price of its period and is kept, as is each older candidate in a
+ * different period from the last one kept. The removed links, still
+ * holding the list's reference, are added to data->removed. Returns the
+ * new head of the list. */
+static PriceList *
+pricedb_prune_price_list (PriceList *prices, remove_info *data)
+{
+    GList *node, *next;
+    gboolean have_kept = FALSE;
+    gint kept_period = 0;
+
+    for (node = prices; node; node = next)
     {
-        GDate saved_price_date;
-        GDate next_price_date;
+        GNCPrice *price = node->data;
 
-        // Keep None
-        if (keep == PRICE_REMOVE_KEEP_NONE)
-        {
-            gnc_pricedb_remove_old_prices_pinfo (item->data, FALSE);
-            gnc_pricedb_remove_price (db, item->data);
+        next = node->next;
+        if (!check_one_price_date (price, data))
             continue;
-        }
+        data->candidates++;
 
-        save_first_price = !price_commodity_and_currency_equal (item->data, cloned_price); // Not Equal
-        if (save_first_price == TRUE)
+        if (data->keep != PRICE_REMOVE_KEEP_NONE)
         {
-            clone_price (&cloned_price, item->data);
-            continue;
+            gint period = price_keep_period (price, data);
+            if (!have_kept || period != kept_period)
+            {
+                gnc_pricedb_remove_old_prices_pinfo (price, TRUE);
+                have_kept = TRUE;
+                kept_period = period;
+                continue;
+            }
         }
 
-        // get the price dates
-        saved_price_date = time64_to_gdate (gnc_price_get_time64 (cloned_price));
-        next_price_date = time64_to_gdate (gnc_price_get_time64 (item->data));
-
-        // Keep last price in fiscal year
-        if (keep == PRICE_REMOVE_KEEP_LAST_PERIOD && save_first_price == FALSE)
-        {
-            GDate *saved_fiscal_end = g_date_new_dmy (g_date_get_day (&saved_price_date),
-                                                      g_date_get_month (&saved_price_date),
-                                                      g_date_get_year (&saved_price_date));
-
-            GDate *next_fiscal_end = g_date_new_dmy (g_date_get_day (&next_price_date),
-                                                     g_date_get_month (&next_price_date),
-                                                     g_date_get_year (&next_price_date));
+        gnc_pricedb_remove_old_prices_pinfo (price, FALSE);
+        prices = g_list_remove_link (prices, node);
+        data->removed = g_list_concat (node, data->removed);
+    }
+    return prices;
+}
 
-            gnc_gdate_set_fiscal_year_end (saved_fiscal_end, fiscal_end_date);
-            gnc_gdate_set_fiscal_year_end (next_fiscal_end, fiscal_end_date);
+static void
+pricedb_prune_commodity (GNCPriceDB *db, gnc_commodity *commodity,
+                         remove_info *data)
+{
+    GHashTable *currency_hash;
+    GHashTableIter iter;
+    gpointer key, value;
 
-            saved_test_value = g_date_get_year (saved_fiscal_end);
-            next_test_value = g_date_get_year (next_fiscal_end);
+    currency_hash = g_hash_table_lookup (db->commodity_hash, commodity);
+    if (!currency_hash)
+        return;
 
-            PINFO("Keep last price in fiscal year");
+    g_hash_table_iter_init (&iter, currency_hash);
+    while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+        GList *removed = data->removed;
+        PriceList *prices = pricedb_prune_price_list (value, data);
+        PriceIndex *index;
 
-            g_date_free (saved_fiscal_end);
-            g_date_free (next_fiscal_end);
-        }
+        if (data->removed == removed)
+            continue;
 
-        // Keep last price in fiscal quarter
-        if (keep == PRICE_REMOVE_KEEP_LAST_QUARTERLY && save_first_price == FALSE)
+        index = price_index_lookup (db, commodity, key, FALSE);
+        if (prices)
         {
-            saved_test_value = get_fiscal_quarter (&saved_price_date, fiscal_month_start);
-            next_test_value = get_fiscal_quarter (&next_price_date, fiscal_month_start);
-
-            PINFO("Keep last price in fiscal quarter");
+            g_hash_table_iter_replace (&iter, prices);
+            if (index)
+                price_index_rebuild (index, prices);
         }
-
-        // Keep last price of every month
-        if (keep == PRICE_REMOVE_KEEP_LAST_MONTHLY && save_first_price == FALSE)
+        else
         {
-            saved_test_value = g_date_get_month (&saved_price_date);
-            next_test_value = g_date_get_month (&next_price_date);
-
-            PINFO("Keep last price of every month");
+            g_hash_table_iter_remove (&iter);
+            if (index)
+                g_hash_table_remove (db->price_index, index);
         }
+    }
 
-        // Keep last price of every week
-        if (keep == PRICE_REMOVE_KEEP_LAST_WEEKLY && save_first_price == FALSE)
-        {
-            saved_test_value = g_date_get_iso8601_week_of_year (&saved_price_date);
-            next_test_value = g_date_get_iso8601_week_of_year (&next_price_date);
+    if (g_hash_table_size (currency_hash) == 0)
+    {
+        g_hash_table_remove (db->commodity_hash, commodity);
+        g_hash_table_destroy (currency_hash);
+    }
+}
 
-            PINFO("Keep last price of every week");
-        }
+/* Have the backend delete the pruned prices and tell the rest of the
+ * program about them with one event on the db rather than one per price,
+ * so code showing prices has to refresh after pruning them. */
+static void
+pricedb_destroy_removed_prices (GNCPriceDB *db, GList *removed)
+{
+    GList *node;
 
-        // Now compare the values
-        if (saved_test_value == next_test_value)
-        {
-            gnc_pricedb_remove_old_prices_pinfo (item->data, FALSE);
-            gnc_pricedb_remove_price (db, item->data);
-        }
-        else
-            clone_price (&cloned_price, item->data);
+    qof_event_suspend ();
+    for (node = removed; node; node = node->next)
+    {
+        GNCPrice *p = node->data;
+
+        gnc_price_begin_edit (p);
+        qof_instance_set_destroying (p, TRUE);
+        gnc_price_commit_edit (p);
+        p->db = NULL;
+        gnc_price_unref (p);
     }
-    if (cloned_price)
-        gnc_price_unref (cloned_price);
+    qof_event_resume ();
+
+    db->reset_nth_price_cache = TRUE;
+    gnc_pricedb_begin_edit (db);
+    qof_instance_set_dirty (&db->inst);
+    gnc_pricedb_commit_edit (db);
+    qof_event_gen (&db->inst, QOF_EVENT_MODIFY, NULL);
 }
 
 gboolean
@@ -1605,16 +1895,20 @@ gnc_pricedb_remove_old_prices (GNCPriceDB *db, GList *comm_list,
                               PriceRemoveKeepOptions keep)
 {
     remove_info data;
+    GDate default_fiscal_end, fiscal_start;
     GList *node;
     char datebuff[MAX_DATE_LENGTH + 1];
+    gint64 stat_start = QOF_STAT_TIMER_START ();
     memset (datebuff, 0, sizeof(datebuff));
 
     data.db = db;
     data.cutoff = cutoff;
-    data.list = NULL;
     data.delete_fq = FALSE;
     data.delete_user = FALSE;
     data.delete_app = FALSE;
+    data.keep = keep;
+    data.candidates = 0;
+    data.removed = NULL;
 
     ENTER("Remove Prices for Source %d, keeping %d", source, keep);
 
@@ -1628,39 +1922,48 @@ gnc_pricedb_remove_old_prices (GNCPriceDB *db, GList *comm_list,
     if (source & PRICE_REMOVE_SOURCE_USER)
         data.delete_user = TRUE;
 
-    // Walk the list of commodities
-    for (node = g_list_first (comm_list); node; node = g_list_next (node))
-    {
-        GHashTable *currencies_hash = g_hash_table_lookup (db->commodity_hash, node->data);
-        g_hash_table_foreach (currencies_hash, pricedb_remove_foreach_pricelist, &data);
-    }
-
-    if (data.list == NULL)
-    {
-        LEAVE("Empty price list");
-        return FALSE;
-    }
-    qof_print_date_buff (datebuff, sizeof(datebuff), cutoff);
-    DEBUG("Number of Prices in list is %d, Cutoff date is %s",
-          g_slist_length (data.list), datebuff);
-
     // Check for a valid fiscal end of year date
     if (fiscal_end_date == NULL)
     {
-        GDateYear year_now = g_date_get_year (gnc_g_date_new_today ());
-        fiscal_end_date = g_date_new ();
-        g_date_set_dmy (fiscal_end_date, 31, 12, year_now);
+        GDate today;
+        gnc_gdate_set_today (&today);
+        g_date_clear (&default_fiscal_end, 1);
+        g_date_set_dmy (&default_fiscal_end, 31, 12, g_date_get_year (&today));
+        fiscal_end_date = &default_fiscal_end;
     }
     else if (g_date_valid (fiscal_end_date) == FALSE)
     {
-        GDateYear year_now = g_date_get_year (gnc_g_date_new_today ());
+        GDate today;
+        gnc_gdate_set_today (&today);
         g_date_clear (fiscal_end_date, 1);
-        g_date_set_dmy (fiscal_end_date, 31, 12, year_now);
+        g_date_set_dmy (fiscal_end_date, 31, 12, g_date_get_year (&today));
     }
-    gnc_pricedb_process_removal_list (db, fiscal_end_date, data, keep);
+    data.fiscal_end_date = fiscal_end_date;
 
-    g_slist_free (data.list);
-    LEAVE(" ");
+    // get the fiscal start month
+    fiscal_start = *fiscal_end_date;
+    g_date_subtract_months (&fiscal_start, 12);
+    data.fiscal_month_start = g_date_get_month (&fiscal_start) + 1;
+
+    qof_print_date_buff (datebuff, sizeof(datebuff), cutoff);
+    DEBUG("Cutoff date is %s", datebuff);
+
+    // Walk the list of commodities
+    for (node = g_list_first (comm_list); node; node = g_list_next (node))
+        pricedb_prune_commodity (db, node->data, &data);
+
+    if (data.removed)
+        pricedb_destroy_removed_prices (db, data.removed);
+    QOF_STAT_TIMER_STOP ("engine.pricedb.remove-old", stat_start);
+
+    if (data.candidates == 0)
+    {
+        LEAVE("Empty price list");
+        return FALSE;
+    }
+    LEAVE("%u prices checked, %u removed", data.candidates,
+          g_list_length (data.removed));
+    g_list_free (data.removed);
     return TRUE;
 }
 
@@ -1745,6 +2048,7 @@ pricedb_get_prices_internal(GNCPriceDB *db, const gnc_commodity *commodity,
 {
     GHashTable *forward_hash = NULL, *reverse_hash = NULL;
     PriceList *forward_list = NULL, *reverse_list = NULL;
+    gint64 stat_start = QOF_STAT_TIMER_START ();
     g_return_val_if_fail (db != NULL, NULL);
     g_return_val_if_fail (commodity != NULL, NULL);
     forward_hash = g_hash_table_lookup(db->commodity_hash, commodity);
@@ -1752,6 +2056,7 @@ pricedb_get_prices_internal(GNCPriceDB *db, const gnc_commodity *commodity,
         reverse_hash = g_hash_table_lookup(db->commodity_hash, currency);
     if (!forward_hash && !reverse_hash)
     {
+        QOF_STAT_TIMER_STOP ("engine.pricedb.lookup", stat_start);
         LEAVE (" no currency hash");
         return NULL;
     }
@@ -1782,6 +2087,7 @@ pricedb_get_prices_internal(GNCPriceDB *db, const gnc_commodity *commodity,
         }
     }
 
+    QOF_STAT_TIMER_STOP ("engine.pricedb.lookup", stat_start);
     return forward_list;
 }
 
@@ -2034,6 +2340,7 @@ gnc_pricedb_lookup_nearest_in_time_any_currency_t64(GNCPriceDB *db,
 {
     GList *prices = NULL, *result;
     UsesCommodity helper = {&prices, commodity, t};
+    gint64 stat_start = QOF_STAT_TIMER_START ();
     result = NULL;
 
     if (!db || !commodity) return NULL;
@@ -2043,6 +2350,7 @@ gnc_pricedb_lookup_nearest_in_time_any_currency_t64(GNCPriceDB *db,
     prices = g_list_sort(prices, compare_prices_by_date);
     result = nearest_to(prices, commodity, t);
     gnc_price_list_destroy(prices);
+    QOF_STAT_TIMER_STOP ("engine.pricedb.lookup-any-currency", stat_start);
     LEAVE(" ");
     return result;
 }
@@ -2054,6 +2362,7 @@ gnc_pricedb_lookup_latest_before_any_currency_t64(GNCPriceDB *db,
 {
     GList *prices = NULL, *result;
     UsesCommodity helper = {&prices, commodity, t};
+    gint64 stat_start = QOF_STAT_TIMER_START ();
     result = NULL;
 
     if (!db || !commodity) return NULL;
@@ -2064,6 +2373,7 @@ gnc_pricedb_lookup_latest_before_any_currency_t64(GNCPriceDB *db,
     prices = g_list_sort(prices, compare_prices_by_date);
     result = latest_before(prices, commodity, t);
     gnc_price_list_destroy(prices);
+    QOF_STAT_TIMER_STOP ("engine.pricedb.lookup-any-currency", stat_start);
     LEAVE(" ");
     return result;
 }
@@ -2246,7 +2556,14 @@ gnc_pricedb_lookup_day_t64(GNCPriceDB *db,
                            const gnc_commodity *currency,
                            time64 t)
 {
-    return lookup_nearest_in_time(db, c, currency, t, TRUE);
+    GNCPrice *result;
+
+    if (!db || !c || !currency) return NULL;
+    if (t == INT64_MAX) return NULL;
+
+    result = price_index_lookup_day (db, c, currency, t);
+    gnc_price_ref (result);
+    return result;
 }
 
 GNCPrice *
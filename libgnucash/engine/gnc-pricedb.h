@@ -370,6 +370,17 @@ void gnc_pricedb_set_bulk_update(GNCPriceDB *db, gboolean bulk_update);
  */
 gboolean     gnc_pricedb_add_price(GNCPriceDB *db, GNCPrice *p);
 
+/** @brief Add many prices to the pricedb at once.
+ *
+ * Each price is added as by gnc_pricedb_add_price(), prices of the same
+ * commodity, currency and day in the order given, but the prices are
+ * sorted first and the pricedb is marked changed only once.
+ * @param db The pricedb
+ * @param prices A list of the GNCPrices to add.
+ * @return The number of prices added.
+ */
+guint        gnc_pricedb_add_prices_bulk(GNCPriceDB *db, PriceList *prices);
+
 /** @brief Remove a price from the pricedb and unref the price.
  * @param db The Pricedb
  * @param p The price to remove.
@@ -402,6 +413,10 @@ typedef enum
  * @param source Whether Finance::Quote, user or all prices should be deleted.
  * @param keep Whether scaled, monthly, weekly or no prices should be left.
  * @return True if there were prices to process, False if not.
+ *
+ * Unlike gnc_pricedb_remove_price no event is sent for each price removed,
+ * only a single QOF_EVENT_MODIFY for the db, so views of the prices must
+ * be refreshed afterwards.
  */
 gboolean     gnc_pricedb_remove_old_prices(GNCPriceDB *db, GList *comm_list,
                                            GDate *fiscal_end_date, time64 cutoff,
@@ -34,6 +34,7 @@ extern "C"
 
 #include "kvp-value.hpp"
 #include "kvp-frame.hpp"
+#include "qof-slab.hpp"
 #include <typeinfo>
 #include <sstream>
 #include <algorithm>
@@ -68,6 +69,36 @@ KvpFrameImpl::~KvpFrameImpl() noexcept
     m_valuemap.clear();
 }
 
+/* Setting GNC_NO_SLAB in the environment allocates frames one by one, so
+ * that memory checkers can follow them. */
+static QofSlab*
+frame_slab ()
+{
+    /* Never destroyed, as frames may outlive static destruction. */
+    static auto slab = g_getenv ("GNC_NO_SLAB") ? nullptr :
+        new QofSlab {sizeof (KvpFrameImpl), 4096};
+    return slab;
+}
+
+void*
+KvpFrameImpl::operator new(std::size_t size)
+{
+    auto slab = frame_slab();
+    if (!slab || size != sizeof (KvpFrameImpl))
+        return ::operator new(size);
+    return slab->allocate();
+}
+
+void
+KvpFrameImpl::operator delete(void* frame, std::size_t size) noexcept
+{
+    auto slab = frame_slab();
+    if (!slab || size != sizeof (KvpFrameImpl))
+        ::operator delete(frame);
+    else
+        slab->deallocate(frame);
+}
+
 KvpFrame *
 KvpFrame::get_child_frame_or_nullptr (Path const & path) noexcept
 {
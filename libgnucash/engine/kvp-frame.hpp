@@ -133,6 +133,13 @@ struct KvpFrameImpl
      */
     ~KvpFrameImpl() noexcept;
 
+    /**
+     * Every QofInstance owns a frame, so frames are allocated from a QofSlab
+     * rather than one by one, unless GNC_NO_SLAB is set in the environment.
+     */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* frame, std::size_t size) noexcept;
+
     /**
      * Set the value with the key in the immediate frame, replacing and
      * returning the old value if it exists or nullptr if it doesn't. Takes
@@ -225,6 +225,13 @@ public:
  *    Revert changes in the engine and unlock the backend.
  */
     virtual void rollback(QofInstance*) {}
+/**
+ *    Bracket the commits that a bulk load deferred, see
+ *    qof_book_begin_bulk_load(), so that a backend can write them in one
+ *    go. Calls don't nest.
+ */
+    virtual void begin_batch() {}
+    virtual void end_batch() {}
 /**
  *    Synchronizes the engine contents to the backend.
  *    This should done by using version numbers (hack alert -- the engine
@@ -246,6 +253,27 @@ public:
 /** Perform a sync in a way that prevents data loss on a DBI backend.
  */
     virtual void safe_sync(QofBook *) = 0;
+/**
+ *    Report whether every transaction in the data store is in the engine. A
+ *    backend whose initial load leaves transactions in the data store
+ *    returns false until it has done a LOAD_TYPE_LOAD_ALL.
+ */
+    virtual bool transactions_loaded() const { return true; }
+/**
+ *    Sum, in the data store, the amounts of an account's splits in
+ *    transactions posted at or after start and before end, so that the
+ *    engine can total transactions that it hasn't loaded.
+ *    @param account The account whose splits are summed.
+ *    @param start The start of the period, or INT64_MIN for none.
+ *    @param end The end of the period, or INT64_MAX for none.
+ *    @param total Set to the exact sum if the backend could compute it.
+ *    @return false if the backend can't compute the sum.
+ */
+    virtual bool sum_split_amounts(const QofInstance* account, time64 start,
+                                   time64 end, gnc_numeric& total)
+    {
+        return false;
+    }
 /**   Extract the chart of accounts from the current database and create a new
  *   database with it. Implemented only in the XML backend at present.
  */
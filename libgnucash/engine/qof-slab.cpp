@@ -0,0 +1,117 @@
+/********************************************************************\
+ * qof-slab.cpp -- Pools of equal-sized blocks for engine objects    *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+\********************************************************************/
+
+#include "qof-slab.hpp"
+
+#include <algorithm>
+#include <new>
+
+static std::size_t
+round_block_size (std::size_t size)
+{
+    constexpr auto align = alignof (std::max_align_t);
+    size = std::max (size, sizeof (void*));
+    return (size + align - 1) / align * align;
+}
+
+QofSlab::QofSlab (std::size_t block_size, std::size_t blocks_per_chunk) :
+    m_block_size{round_block_size (block_size)},
+    m_blocks_per_chunk{std::max<std::size_t> (blocks_per_chunk, 1)}
+{
+}
+
+QofSlab::~QofSlab ()
+{
+    release_chunks (false);
+}
+
+void*
+QofSlab::allocate ()
+{
+    if (m_free)
+    {
+        auto block = m_free;
+        m_free = block->next;
+        ++m_in_use;
+        return block;
+    }
+    if (m_next == m_end)
+    {
+        auto size = m_block_size * m_blocks_per_chunk;
+        auto chunk = static_cast<char*> (::operator new (size));
+        m_chunks.push_back (chunk);
+        m_next = chunk;
+        m_end = chunk + size;
+    }
+    auto block = m_next;
+    m_next += m_block_size;
+    ++m_in_use;
+    return block;
+}
+
+void
+QofSlab::deallocate (void* block) noexcept
+{
+    if (!block)
+        return;
+    /* Keep the first chunk so that a slab that is briefly empty doesn't
+     * go back to the system for every block. */
+    if (--m_in_use == 0)
+    {
+        release_chunks (true);
+        return;
+    }
+    auto free_block = static_cast<FreeBlock*> (block);
+    free_block->next = m_free;
+    m_free = free_block;
+}
+
+std::size_t
+QofSlab::in_use () const noexcept
+{
+    return m_in_use;
+}
+
+std::size_t
+QofSlab::chunks () const noexcept
+{
+    return m_chunks.size ();
+}
+
+void
+QofSlab::release_chunks (bool keep_first) noexcept
+{
+    auto first = m_chunks.begin ();
+    if (keep_first && first != m_chunks.end ())
+        ++first;
+    std::for_each (first, m_chunks.end (),
+                   [](char* chunk) { ::operator delete (chunk); });
+    m_chunks.erase (first, m_chunks.end ());
+    m_free = nullptr;
+    if (m_chunks.empty ())
+        m_next = m_end = nullptr;
+    else
+    {
+        m_next = m_chunks.front ();
+        m_end = m_next + m_block_size * m_blocks_per_chunk;
+    }
+}
@@ -0,0 +1,86 @@
+/********************************************************************\
+ * qof-slab.hpp -- Pools of equal-sized blocks for engine objects    *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+\********************************************************************/
+/** @addtogroup Utilities
+    @{ */
+/** @file qof-slab.hpp
+    @brief Pools of equal-sized blocks for small engine objects.
+
+    A book holds one KVP frame for every split, transaction and account,
+    so loading a large book means millions of small allocations of the same
+    size. A QofSlab carves such blocks out of large chunks and recycles
+    freed blocks through a free list. When the last block is returned, as
+    happens when the only open book is closed, all chunks but the first are
+    released at once instead of block by block.
+
+    A class uses a slab by declaring its own operator new and delete, see
+    KvpFrameImpl.
+
+    A slab isn't locked. Like the rest of the engine, the objects allocated
+    from one must be created and freed on one thread at a time.
+*/
+
+#ifndef QOF_SLAB_HPP
+#define QOF_SLAB_HPP
+
+#include <cstddef>
+#include <vector>
+
+class QofSlab
+{
+public:
+    /** @param block_size The size of the objects allocated from the slab.
+     *  @param blocks_per_chunk The number of blocks in each chunk taken from
+     *  the system.
+     */
+    QofSlab (std::size_t block_size, std::size_t blocks_per_chunk = 1024);
+    ~QofSlab ();
+    QofSlab (const QofSlab&) = delete;
+    QofSlab& operator= (const QofSlab&) = delete;
+
+    /** Return a block of at least block_size() bytes, aligned for any type.
+     *  @exception std::bad_alloc if the system is out of memory.
+     */
+    void* allocate ();
+    /** Return a block obtained from allocate() to the slab. */
+    void deallocate (void* block) noexcept;
+
+    std::size_t block_size () const noexcept { return m_block_size; }
+    /** The number of blocks allocated and not yet returned. */
+    std::size_t in_use () const noexcept;
+    /** The number of chunks currently held. */
+    std::size_t chunks () const noexcept;
+
+private:
+    struct FreeBlock { FreeBlock* next; };
+    void release_chunks (bool keep_first) noexcept;
+
+    const std::size_t m_block_size;
+    const std::size_t m_blocks_per_chunk;
+    std::vector<char*> m_chunks;
+    FreeBlock* m_free = nullptr;
+    char* m_next = nullptr;  // Never used space in the newest chunk.
+    char* m_end = nullptr;
+    std::size_t m_in_use = 0;
+};
+
+#endif /* QOF_SLAB_HPP */
+/** @} */
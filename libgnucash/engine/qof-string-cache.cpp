@@ -37,6 +37,8 @@ extern "C"
 #include "qof.h"
 }
 
+#include <cstddef>
+
 /* Uncomment if you need to log anything.
 static QofLogModule log_module = QOF_MOD_UTIL;
 */
@@ -44,11 +46,28 @@ static QofLogModule log_module = QOF_MOD_UTIL;
 /* The QOF string cache                                                */
 /*                                                                     */
 /* The cache is a GHashTable where a copy of the string is the key,    */
-/* and a ref count is the value                                        */
+/* and a ref count is the value. Both live in one CacheEntry, so that  */
+/* each cached string costs a single allocation.                       */
 /* =================================================================== */
 
+struct CacheEntry
+{
+    guint refcount;
+    char str[1];
+};
+
 static GHashTable* qof_string_cache = NULL;
 
+static CacheEntry*
+cache_entry_new (const char* key)
+{
+    auto len = strlen (key);
+    auto entry = static_cast<CacheEntry*>(g_malloc (offsetof (CacheEntry, str) + len + 1));
+    entry->refcount = 1;
+    memcpy (entry->str, key, len + 1);
+    return entry;
+}
+
 static GHashTable*
 qof_get_string_cache(void)
 {
@@ -57,7 +76,7 @@ qof_get_string_cache(void)
         qof_string_cache = g_hash_table_new_full(
                                g_str_hash,               /* hash_func          */
                                g_str_equal,              /* key_equal_func     */
-                               g_free,                   /* key_destroy_func   */
+                               NULL,                     /* key_destroy_func   */
                                g_free);                  /* value_destroy_func */
     }
     return qof_string_cache;
@@ -91,14 +110,14 @@ qof_string_cache_remove(const char * key)
         gpointer cache_key;
         if (g_hash_table_lookup_extended(cache, key, &cache_key, &value))
         {
-            guint* refcount = (guint*)value;
-            if (*refcount == 1)
+            auto entry = static_cast<CacheEntry*>(value);
+            if (entry->refcount == 1)
             {
                 g_hash_table_remove(cache, key);
             }
             else
             {
-                --(*refcount);
+                --entry->refcount;
             }
         }
     }
@@ -116,17 +135,15 @@ qof_string_cache_insert(const char * key)
         gpointer cache_key;
         if (g_hash_table_lookup_extended(cache, key, &cache_key, &value))
         {
-            guint* refcount = (guint*)value;
-            ++(*refcount);
+            auto entry = static_cast<CacheEntry*>(value);
+            ++entry->refcount;
             return static_cast <char *> (cache_key);
         }
         else
         {
-            gpointer new_key = g_strdup(static_cast<const char*>(key));
-            guint* refcount = static_cast<unsigned int*>(g_malloc(sizeof(guint)));
-            *refcount = 1;
-            g_hash_table_insert(cache, new_key, refcount);
-            return static_cast <char *> (new_key);
+            auto entry = cache_entry_new (key);
+            g_hash_table_insert(cache, entry->str, entry);
+            return entry->str;
         }
     }
     return NULL;
@@ -86,5 +86,6 @@
 #include "qofsession.h"
 #include "qofchoice.h"
 #include "qof-string-cache.h"
+#include "qofstats.h"
 
 #endif /* QOF_H_ */
@@ -59,6 +59,15 @@ void qof_book_set_backend (QofBook *book, QofBackend *be);
 /* Register books with the engine */
 gboolean qof_book_register (void);
 
+/** Called with an instance whose deferred commit failed, and the error. */
+typedef void (*QofDeferredErrorCB)(QofInstance *, QofBackendError);
+
+/** Record that @a inst was committed during a bulk load of @a book, see
+ *  qof_book_begin_bulk_load().  @a on_error, which may be NULL, is called
+ *  should the backend fail the commit when the bulk load ends. */
+void qof_book_defer_commit (QofBook *book, QofInstance *inst,
+                            QofDeferredErrorCB on_error);
+
 /** @deprecated use qof_instance_set_guid instead but only in
 backends (when reading the GncGUID from the data source). */
 #define qof_book_set_guid(book,guid)    \
@@ -58,6 +58,7 @@ extern "C"
 #include "qofobject-p.h"
 #include "qofbookslots.h"
 #include "kvp-frame.hpp"
+#include "qof-backend.hpp"
 // For GNC_ID_ROOT_ACCOUNT:
 #include "AccountP.h"
 
@@ -143,6 +144,9 @@ qof_book_init (QofBook *book)
     book->version = 0;
     book->cached_num_field_source_isvalid = FALSE;
     book->cached_num_days_autoreadonly_isvalid = FALSE;
+    book->bulk_load_level = 0;
+    book->deferred_commits = NULL;
+    book->deferred_commit_set = NULL;
 
     // Register a callback on this NUM_FIELD_SOURCE property of that object
     // because it gets called quite a lot, so that its value must be stored in
@@ -415,6 +419,30 @@ qof_book_finalize_real (G_GNUC_UNUSED GObject *bookp)
 {
 }
 
+/* Hand the deferred commits and their error callbacks to @a func, if
+ * any, and drop them. */
+static void
+take_deferred_commits (QofBook *book, void (*func)(QofInstance*, QofDeferredErrorCB))
+{
+    auto deferred = book->deferred_commits;
+    auto on_errors = book->deferred_commit_set;
+    if (!deferred)
+        return;
+
+    book->deferred_commits = NULL;
+    book->deferred_commit_set = NULL;
+    for (guint i = 0; i < deferred->len; ++i)
+    {
+        auto inst = static_cast<QofInstance*>(g_ptr_array_index (deferred, i));
+        auto on_error = reinterpret_cast<QofDeferredErrorCB>(g_hash_table_lookup (on_errors, inst));
+        if (func)
+            func (inst, on_error);
+        g_object_unref (inst);
+    }
+    g_hash_table_destroy (on_errors);
+    g_ptr_array_free (deferred, TRUE);
+}
+
 void
 qof_book_destroy (QofBook *book)
 {
@@ -424,6 +452,8 @@ qof_book_destroy (QofBook *book)
     ENTER ("book=%p", book);
 
     book->shutting_down = TRUE;
+    /* An unfinished bulk load is abandoned; the book is going away. */
+    take_deferred_commits (book, NULL);
     qof_event_force (&book->inst, QOF_EVENT_DESTROY, NULL);
 
     /* Call the list of finalizers, let them do their thing.
@@ -534,6 +564,63 @@ qof_book_shutting_down (const QofBook *book)
     return book->shutting_down;
 }
 
+void
+qof_book_begin_bulk_load (QofBook *book)
+{
+    g_return_if_fail (QOF_IS_BOOK (book));
+    ++book->bulk_load_level;
+}
+
+gboolean
+qof_book_end_bulk_load (QofBook *book)
+{
+    g_return_val_if_fail (QOF_IS_BOOK (book), FALSE);
+    g_return_val_if_fail (book->bulk_load_level > 0, FALSE);
+
+    if (--book->bulk_load_level > 0)
+        return FALSE;
+
+    if (!book->deferred_commits)
+        return TRUE;
+
+    ENTER ("book=%p commits=%u", book, book->deferred_commits->len);
+    auto be = book->backend;
+    if (be)
+        be->begin_batch ();
+    take_deferred_commits (book, qof_instance_commit_deferred);
+    if (be)
+        be->end_batch ();
+    LEAVE (" ");
+    return TRUE;
+}
+
+gboolean
+qof_book_in_bulk_load (const QofBook *book)
+{
+    return book && book->bulk_load_level > 0;
+}
+
+void
+qof_book_defer_commit (QofBook *book, QofInstance *inst,
+                       QofDeferredErrorCB on_error)
+{
+    g_return_if_fail (QOF_IS_BOOK (book) && book->bulk_load_level > 0);
+
+    if (!book->deferred_commits)
+    {
+        book->deferred_commits = g_ptr_array_new ();
+        book->deferred_commit_set = g_hash_table_new (g_direct_hash,
+                                                      g_direct_equal);
+    }
+    /* The reference keeps the instance around should it be destroyed
+     * before the bulk load ends; qof_instance_commit_deferred skips it.
+     * The latest commit's error callback is the one reported to. */
+    if (!g_hash_table_contains (book->deferred_commit_set, inst))
+        g_ptr_array_add (book->deferred_commits, g_object_ref (inst));
+    g_hash_table_insert (book->deferred_commit_set, inst,
+                         reinterpret_cast<gpointer>(on_error));
+}
+
 /* ====================================================================== */
 /* setters */
 
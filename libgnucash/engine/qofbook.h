@@ -161,6 +161,13 @@ struct _QofBook
     gint cached_num_days_autoreadonly;
     /* Whether the above cached value is valid. */
     gboolean cached_num_days_autoreadonly_isvalid;
+
+    /* The nesting depth of qof_book_begin_bulk_load(), the instances
+     * whose backend commits are deferred until it ends, and each one's
+     * commit error callback. */
+    gint bulk_load_level;
+    GPtrArray *deferred_commits;
+    GHashTable *deferred_commit_set;
 };
 
 struct _QofBookClass
@@ -313,6 +320,24 @@ gboolean qof_book_use_split_action_for_num_field (const QofBook *book);
 /** Is the book shutting down? */
 gboolean qof_book_shutting_down (const QofBook *book);
 
+/** Start a bulk load of @a book. Until the matching
+ * qof_book_end_bulk_load(), committed instances aren't passed to the
+ * backend one by one; they are all handed to it in a single batch when
+ * the outermost bulk load ends. Instances being destroyed are still
+ * committed at once. Bulk loads nest.
+ *
+ * Applications should use gnc_book_begin_bulk_load(), which also defers
+ * the engine's split sorting, balance computation and events. */
+void qof_book_begin_bulk_load (QofBook *book);
+
+/** End a bulk load of @a book.
+ * @return TRUE if this ended the outermost bulk load, after committing
+ * the deferred instances to the backend. */
+gboolean qof_book_end_bulk_load (QofBook *book);
+
+/** Is a bulk load of @a book in progress? */
+gboolean qof_book_in_bulk_load (const QofBook *book);
+
 /** qof_book_not_saved() returns the value of the session_dirty flag,
  * set when changes to any object in the book are committed
  * (qof_backend->commit_edit has been called) and the backend hasn't
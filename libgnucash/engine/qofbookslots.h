@@ -74,6 +74,11 @@
 #define OPTION_SECTION_BUDGETING       N_("Budgeting")
 #define OPTION_NAME_DEFAULT_BUDGET     N_("Default Budget")
 
+#define OPTION_SECTION_SQLITE          N_("SQLite")
+#define OPTION_NAME_SQLITE_PROFILE     N_("Performance Profile")
+#define OPTION_NAME_SQLITE_SYNCHRONOUS N_("Synchronous Level")
+#define OPTION_NAME_SQLITE_MEMORY_TEMP_STORE N_("Keep Temporary Tables in Memory")
+
 /** @} */
 
 /* For the grep-happy:
@@ -88,4 +93,8 @@
  * OPTION-NAME_NUM-FIELD-SOURCE
  * OPTION-SECTION-BUDGETING
  * OPTION-NAME-DEFAULT-BUDGET
+ * OPTION-SECTION-SQLITE
+ * OPTION-NAME-SQLITE-PROFILE
+ * OPTION-NAME-SQLITE-SYNCHRONOUS
+ * OPTION-NAME-SQLITE-MEMORY-TEMP-STORE
  */
@@ -175,6 +175,7 @@ qof_event_generate_internal (QofInstance *entity, QofEventId event_id,
     GList *next_node = NULL;
 
     g_return_if_fail(entity);
+    QOF_STAT_SCOPED_TIMER ("qof.event.gen");
 
     switch (event_id)
     {
@@ -90,6 +90,12 @@ void qof_instance_set_dirty(QofInstance* inst);
 
 /* reset the dirty flag */
 void qof_instance_mark_clean (QofInstance *);
+
+/** Pass @a inst, whose commit was deferred by a bulk load of its book,
+ *  to the book's backend.  A backend error is left on the backend and
+ *  passed to @a on_error, as qof_commit_edit_part2() would have. */
+void qof_instance_commit_deferred (QofInstance *inst,
+                                   void (*on_error)(QofInstance *, QofBackendError));
 /** Get the version number on this instance.  The version number is
  *  used to manage multi-user updates. */
 gint32 qof_instance_get_version (gconstpointer inst);
@@ -1004,9 +1004,14 @@ qof_commit_edit_part2(QofInstance *inst,
       qof_book_mark_session_dirty(priv->book);
     }
 
-    /* See if there's a backend.  If there is, invoke it. */
+    /* See if there's a backend.  If there is, invoke it, or leave it
+     * to the end of a bulk load. */
     auto be = qof_book_get_backend(priv->book);
-    if (be)
+    if (be && !priv->do_free && qof_book_in_bulk_load (priv->book))
+    {
+        qof_book_defer_commit (priv->book, inst, on_error);
+    }
+    else if (be)
     {
         QofBackendError errcode;
 
@@ -1046,6 +1051,46 @@ qof_commit_edit_part2(QofInstance *inst,
     return TRUE;
 }
 
+void
+qof_instance_commit_deferred (QofInstance *inst,
+                              void (*on_error)(QofInstance *, QofBackendError))
+{
+    QofBackendError errcode;
+    QofInstancePrivate *priv;
+
+    g_return_if_fail (QOF_IS_INSTANCE (inst));
+    priv = GET_PRIVATE(inst);
+
+    /* Destroyed since; that commit wasn't deferred. */
+    if (priv->do_free)
+        return;
+
+    auto be = qof_book_get_backend (priv->book);
+    if (!be)
+        return;
+
+    /* clear errors */
+    do
+    {
+        errcode = be->get_error();
+    }
+    while (errcode != ERR_BACKEND_NO_ERR);
+
+    be->commit (inst);
+    errcode = be->get_error();
+    if (errcode != ERR_BACKEND_NO_ERR)
+    {
+        /* The edit was finished when the commit was deferred, so on_done
+         * has run; all that's left is to report the failure. */
+        be->set_error (errcode);
+        if (on_error)
+            on_error (inst, errcode);
+        return;
+    }
+    if (!priv->dirty)
+        priv->infant = FALSE;
+}
+
 gboolean
 qof_instance_has_kvp (QofInstance *inst)
 {
@@ -55,6 +55,7 @@ extern "C"
 #include "qof.h"
 #include "qoflog.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -71,6 +72,9 @@ static GLogFunc previous_handler = NULL;
 static gchar* qof_logger_format = NULL;
 static QofLogModule log_module = "qof";
 
+/* Starts at 1 so that a zero-initialized QofLogCache is always stale. */
+gint qof_log_generation = 1;
+
 using StrVec = std::vector<std::string>;
 
 struct ModuleEntry;
@@ -127,6 +131,15 @@ split_domain (const std::string domain)
     return domain_parts;
 }
 
+static void
+qof_log_bump_generation (void)
+{
+    /* The generation lives in the upper 24 bits of a QofLogCache; skip 0 on
+     * wrap-around so that uninitialized caches stay stale. */
+    gint next = (g_atomic_int_get (&qof_log_generation) + 1) & 0xffffff;
+    g_atomic_int_set (&qof_log_generation, next ? next : 1);
+}
+
 void
 qof_log_indent(void)
 {
@@ -279,6 +292,7 @@ qof_log_shutdown (void)
     if (_modules != NULL)
     {
         _modules = nullptr;
+        qof_log_bump_generation ();
     }
 
     if (previous_handler != NULL)
@@ -315,6 +329,28 @@ qof_log_set_level(QofLogModule log_module, QofLogLevel level)
         }
     }
     module->m_level = level;
+    qof_log_bump_generation ();
+}
+
+QofLogLevel
+qof_log_get_level(QofLogModule log_module)
+{
+    auto module = get_modules();
+    if (!log_module)
+        return module->m_level;
+
+    for (auto part : split_domain(log_module))
+    {
+        auto iter = std::find_if(module->m_children.begin(),
+                              module->m_children.end(),
+                              [part](auto& child){
+                                  return child && part == child->m_name;
+                              });
+        if (iter == module->m_children.end())
+            return default_level;
+        module = iter->get();
+    }
+    return module->m_level;
 }
 
 
@@ -330,10 +366,13 @@ qof_log_check(QofLogModule domain, QofLogLevel level)
     if (!domain)
         return FALSE;
 
-    auto domain_vec = split_domain(domain);
-
-    for (auto part : domain_vec)
+    /* Walk the parts of the domain in place; this runs for every message
+     * that reaches log4glib_handler, so it mustn't allocate. */
+    std::string_view rest{domain};
+    while (true)
     {
+        auto pos = rest.find('.');
+        auto part = rest.substr(0, pos);
         auto iter = std::find_if(module->m_children.begin(),
                                module->m_children.end(),
                                [part](auto& child) {
@@ -345,9 +384,35 @@ qof_log_check(QofLogModule domain, QofLogLevel level)
         if (level <= (*iter)->m_level)
             return TRUE;
 
+        if (pos == std::string_view::npos)
+            return FALSE;
+
         module = iter->get();
+        rest.remove_prefix(pos + 1);
     }
-    return FALSE;
+}
+
+gint
+qof_log_cache_refresh(QofLogCache *cache, QofLogModule domain)
+{
+    static const QofLogLevel levels[] =
+    {
+        QOF_LOG_FATAL, QOF_LOG_ERROR, QOF_LOG_WARNING,
+        QOF_LOG_MESSAGE, QOF_LOG_INFO, QOF_LOG_DEBUG
+    };
+    /* Read the generation first: if the levels change while we compute the
+     * mask it gets tagged with the old generation and is recomputed on the
+     * next check. */
+    auto generation = static_cast<guint>(g_atomic_int_get (&qof_log_generation));
+    guint mask = 0;
+
+    for (auto level : levels)
+        if (qof_log_check (domain, level))
+            mask |= static_cast<guint>(level);
+
+    auto value = static_cast<gint>((generation << 8) | (mask & 0xff));
+    g_atomic_int_set (cache, value);
+    return value;
 }
 
 const char *
@@ -128,6 +128,11 @@ void qof_log_init (void);
 /** Set the logging level of the given log_module. **/
 void qof_log_set_level(QofLogModule module, QofLogLevel level);
 
+/** The logging level set for the given log_module, or the level it would
+ *  start out with if none has been, so that it can be restored with
+ *  qof_log_set_level(). **/
+QofLogLevel qof_log_get_level(QofLogModule module);
+
 /** Specify an alternate log output, to pipe or file. **/
 void qof_log_set_file (FILE *outfile);
 
@@ -173,6 +178,38 @@ gboolean qof_log_check(QofLogModule log_module, QofLogLevel log_level);
 /** Set the default level for QOF-related log paths. **/
 void qof_log_set_default(QofLogLevel log_level);
 
+/**
+ * Per-call-site cache of the levels enabled for a log_module, used by the
+ * PINFO, DEBUG, ENTER and LEAVE macros so that a disabled message costs a
+ * load and a compare instead of a walk of the log path hierarchy.
+ *
+ * The low 8 bits hold a mask of the QofLogLevels enabled for the module,
+ * the remaining bits the qof_log_generation in which the mask was computed.
+ * Keeping both in one word means a reader never sees a torn pair. A cache
+ * must be zero-initialized; generation 0 is never current.
+ **/
+typedef gint QofLogCache;
+
+/** Bumped by every change to the log level configuration; invalidates all
+ * QofLogCaches. Don't modify it, use qof_log_set_level(). **/
+extern gint qof_log_generation;
+
+/** Recompute @a cache for @a log_module and return its new value. This is
+ * the slow path of qof_log_check_cached(). **/
+gint qof_log_cache_refresh(QofLogCache *cache, QofLogModule log_module);
+
+/** Cached equivalent of qof_log_check(). @a cache must belong to a single
+ * call site, or at least to a single @a log_module. **/
+static inline gboolean
+qof_log_check_cached(QofLogCache *cache, QofLogModule log_module,
+                     QofLogLevel log_level)
+{
+    guint cached = (guint)g_atomic_int_get(cache);
+    if (G_UNLIKELY((cached >> 8) != (guint)g_atomic_int_get(&qof_log_generation)))
+        cached = (guint)qof_log_cache_refresh(cache, log_module);
+    return (cached & (guint)log_level) != 0;
+}
+
 #define PRETTY_FUNC_NAME qof_log_prettify(G_STRFUNC)
 
 #ifdef _MSC_VER
@@ -204,19 +241,24 @@ void qof_log_set_default(QofLogLevel log_level);
 
 /** Print an informational note */
 #define PINFO(format, ...) do { \
-    g_log (log_module, G_LOG_LEVEL_INFO, \
-      "[%s] " format, PRETTY_FUNC_NAME , __VA_ARGS__); \
+    static QofLogCache qof_log_site_cache = 0; \
+    if (qof_log_check_cached(&qof_log_site_cache, log_module, QOF_LOG_INFO)) \
+      g_log (log_module, G_LOG_LEVEL_INFO, \
+        "[%s] " format, PRETTY_FUNC_NAME , __VA_ARGS__); \
 } while (0)
 
 /** Print a debugging message */
 #define DEBUG(format, ...) do { \
-    g_log (log_module, G_LOG_LEVEL_DEBUG, \
-      "[%s] " format, PRETTY_FUNC_NAME , __VA_ARGS__); \
+    static QofLogCache qof_log_site_cache = 0; \
+    if (qof_log_check_cached(&qof_log_site_cache, log_module, QOF_LOG_DEBUG)) \
+      g_log (log_module, G_LOG_LEVEL_DEBUG, \
+        "[%s] " format, PRETTY_FUNC_NAME , __VA_ARGS__); \
 } while (0)
 
 /** Print a function entry debugging message */
 #define ENTER(format, ...) do { \
-    if (qof_log_check(log_module, (QofLogLevel)G_LOG_LEVEL_DEBUG)) { \
+    static QofLogCache qof_log_site_cache = 0; \
+    if (qof_log_check_cached(&qof_log_site_cache, log_module, QOF_LOG_DEBUG)) { \
       g_log (log_module, G_LOG_LEVEL_DEBUG, \
         "[enter %s:%s()] " format, __FILE__, \
         PRETTY_FUNC_NAME , __VA_ARGS__); \
@@ -226,7 +268,8 @@ void qof_log_set_default(QofLogLevel log_level);
 
 /** Print a function exit debugging message. **/
 #define LEAVE(format, ...) do { \
-    if (qof_log_check(log_module, (QofLogLevel)G_LOG_LEVEL_DEBUG)) { \
+    static QofLogCache qof_log_site_cache = 0; \
+    if (qof_log_check_cached(&qof_log_site_cache, log_module, QOF_LOG_DEBUG)) { \
       qof_log_dedent(); \
       g_log (log_module, G_LOG_LEVEL_DEBUG, \
         "[leave %s()] " format, \
@@ -256,19 +299,24 @@ void qof_log_set_default(QofLogLevel log_level);
 
 /** Print an informational note */
 #define PINFO(format, args...) do { \
-    g_log (log_module, G_LOG_LEVEL_INFO, \
-      "[%s] " format, PRETTY_FUNC_NAME , ## args); \
+    static QofLogCache qof_log_site_cache = 0; \
+    if (qof_log_check_cached(&qof_log_site_cache, log_module, QOF_LOG_INFO)) \
+      g_log (log_module, G_LOG_LEVEL_INFO, \
+        "[%s] " format, PRETTY_FUNC_NAME , ## args); \
 } while (0)
 
 /** Print a debugging message */
 #define DEBUG(format, args...) do { \
-    g_log (log_module, G_LOG_LEVEL_DEBUG, \
-      "[%s] " format, PRETTY_FUNC_NAME , ## args); \
+    static QofLogCache qof_log_site_cache = 0; \
+    if (qof_log_check_cached(&qof_log_site_cache, log_module, QOF_LOG_DEBUG)) \
+      g_log (log_module, G_LOG_LEVEL_DEBUG, \
+        "[%s] " format, PRETTY_FUNC_NAME , ## args); \
 } while (0)
 
 /** Print a function entry debugging message */
 #define ENTER(format, args...) do { \
-    if (qof_log_check(log_module, (QofLogLevel)G_LOG_LEVEL_DEBUG)) { \
+    static QofLogCache qof_log_site_cache = 0; \
+    if (qof_log_check_cached(&qof_log_site_cache, log_module, QOF_LOG_DEBUG)) { \
       g_log (log_module, G_LOG_LEVEL_DEBUG, \
         "[enter %s:%s()] " format, __FILE__, \
         PRETTY_FUNC_NAME , ## args); \
@@ -278,7 +326,8 @@ void qof_log_set_default(QofLogLevel log_level);
 
 /** Print a function exit debugging message. **/
 #define LEAVE(format, args...) do { \
-    if (qof_log_check(log_module, (QofLogLevel)G_LOG_LEVEL_DEBUG)) { \
+    static QofLogCache qof_log_site_cache = 0; \
+    if (qof_log_check_cached(&qof_log_site_cache, log_module, QOF_LOG_DEBUG)) { \
       qof_log_dedent(); \
       g_log (log_module, G_LOG_LEVEL_DEBUG, \
         "[leave %s()] " format, \
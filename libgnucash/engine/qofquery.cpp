@@ -848,6 +848,7 @@ static void qof_query_run_cb(QofQueryCB* qcb, gpointer cb_arg)
 GList * qof_query_run (QofQuery *q)
 {
     /* Just a wrapper */
+    QOF_STAT_SCOPED_TIMER ("qof.query.run");
     return qof_query_run_internal(q, qof_query_run_cb, NULL);
 }
 
@@ -227,7 +227,10 @@ QofSessionImpl::load (QofPercentageFunc percentage_func) noexcept
     if (m_backend)
     {
         m_backend->set_percentage(percentage_func);
-        m_backend->load (m_book, LOAD_TYPE_INITIAL_LOAD);
+        {
+            QOF_STAT_SCOPED_TIMER ("qof.backend.load");
+            m_backend->load (m_book, LOAD_TYPE_INITIAL_LOAD);
+        }
         push_error (m_backend->get_error(), {});
     }
 
@@ -457,7 +460,10 @@ QofSessionImpl::save (QofPercentageFunc percentage_func) noexcept
         if (qof_book_get_backend (m_book) != m_backend)
             qof_book_set_backend (m_book, m_backend);
         m_backend->set_percentage(percentage_func);
-        m_backend->sync(m_book);
+        {
+            QOF_STAT_SCOPED_TIMER ("qof.backend.sync");
+            m_backend->sync(m_book);
+        }
         auto err = m_backend->get_error();
         if (err != ERR_BACKEND_NO_ERR)
         {
@@ -485,7 +491,10 @@ QofSessionImpl::safe_save (QofPercentageFunc percentage_func) noexcept
     if (qof_book_get_backend (m_book) != m_backend)
         qof_book_set_backend (m_book, m_backend);
     m_backend->set_percentage(percentage_func);
-    m_backend->safe_sync(get_book ());
+    {
+        QOF_STAT_SCOPED_TIMER ("qof.backend.sync");
+        m_backend->safe_sync(get_book ());
+    }
     auto err = m_backend->get_error();
     auto msg = m_backend->get_message();
     if (err != ERR_BACKEND_NO_ERR)
@@ -501,7 +510,10 @@ QofSessionImpl::ensure_all_data_loaded () noexcept
     if (!(m_backend && m_book)) return;
     if (qof_book_get_backend (m_book) != m_backend)
         qof_book_set_backend (m_book, m_backend);
-    m_backend->load(m_book, LOAD_TYPE_LOAD_ALL);
+    {
+        QOF_STAT_SCOPED_TIMER ("qof.backend.load");
+        m_backend->load(m_book, LOAD_TYPE_LOAD_ALL);
+    }
     push_error (m_backend->get_error(), {});
 }
 
@@ -0,0 +1,197 @@
+/********************************************************************\
+ * qofstats.cpp -- QOF instrumentation counters and timers          *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+\********************************************************************/
+
+extern "C"
+{
+#include <config.h>
+
+#include <glib.h>
+}
+
+#include "qofstats.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+struct QofStat
+{
+    std::atomic<guint64> count{0};
+    std::atomic<guint64> total_ns{0};
+    std::atomic<guint64> max_ns{0};
+};
+
+gint qof_stats_active = 0;
+
+/* Statistics are never freed once registered, so the pointers cached at
+ * the instrumentation points stay valid. */
+using StatMap = std::map<std::string, std::unique_ptr<QofStat>>;
+
+static std::mutex stats_mutex;
+
+static StatMap&
+stats_map ()
+{
+    static StatMap map;
+    return map;
+}
+
+static QofStat*
+stats_lookup (const char *name)
+{
+    std::lock_guard<std::mutex> lock{stats_mutex};
+    auto& stat = stats_map ()[name];
+    if (!stat)
+        stat = std::make_unique<QofStat> ();
+    return stat.get ();
+}
+
+void
+qof_stats_set_enabled (gboolean enabled)
+{
+    g_atomic_int_set (&qof_stats_active, enabled ? 1 : 0);
+}
+
+gboolean
+qof_stats_get_enabled (void)
+{
+    return qof_stats_enabled ();
+}
+
+void
+qof_stats_reset (void)
+{
+    std::lock_guard<std::mutex> lock{stats_mutex};
+    for (auto& [name, stat] : stats_map ())
+    {
+        stat->count = 0;
+        stat->total_ns = 0;
+        stat->max_ns = 0;
+    }
+}
+
+gint64
+qof_stats_now (void)
+{
+    using namespace std::chrono;
+    auto now = duration_cast<nanoseconds> (steady_clock::now ().time_since_epoch ());
+    return now.count () ? now.count () : 1;
+}
+
+void
+qof_stat_record (QofStat **site, const char *name, gint64 elapsed_ns)
+{
+    /* Racing threads look up the same QofStat, so the cache needs no lock. */
+    auto stat = static_cast<QofStat*> (g_atomic_pointer_get (site));
+    if (G_UNLIKELY (!stat))
+    {
+        stat = stats_lookup (name);
+        g_atomic_pointer_set (site, stat);
+    }
+
+    stat->count.fetch_add (1, std::memory_order_relaxed);
+    if (elapsed_ns <= 0)
+        return;
+
+    auto elapsed = static_cast<guint64> (elapsed_ns);
+    stat->total_ns.fetch_add (elapsed, std::memory_order_relaxed);
+    auto max = stat->max_ns.load (std::memory_order_relaxed);
+    while (elapsed > max &&
+           !stat->max_ns.compare_exchange_weak (max, elapsed,
+                                                std::memory_order_relaxed))
+        ;
+}
+
+QofStatList*
+qof_stats_snapshot (void)
+{
+    GList *snapshot = nullptr;
+    std::lock_guard<std::mutex> lock{stats_mutex};
+    for (auto& [name, stat] : stats_map ())
+    {
+        auto value = g_new0 (QofStatValue, 1);
+        value->name = g_strdup (name.c_str ());
+        value->count = stat->count.load (std::memory_order_relaxed);
+        value->total_ns = stat->total_ns.load (std::memory_order_relaxed);
+        value->max_ns = stat->max_ns.load (std::memory_order_relaxed);
+        snapshot = g_list_prepend (snapshot, value);
+    }
+    return g_list_reverse (snapshot);
+}
+
+static void
+stat_value_free (gpointer data)
+{
+    auto value = static_cast<QofStatValue*> (data);
+    g_free (value->name);
+    g_free (value);
+}
+
+void
+qof_stats_snapshot_free (QofStatList *snapshot)
+{
+    g_list_free_full (snapshot, stat_value_free);
+}
+
+static const QofStat*
+stats_find (const char *name)
+{
+    if (!name)
+        return nullptr;
+    std::lock_guard<std::mutex> lock{stats_mutex};
+    auto iter = stats_map ().find (name);
+    return iter == stats_map ().end () ? nullptr : iter->second.get ();
+}
+
+guint64
+qof_stats_get_count (const char *name)
+{
+    auto stat = stats_find (name);
+    return stat ? stat->count.load (std::memory_order_relaxed) : 0;
+}
+
+guint64
+qof_stats_get_total_ns (const char *name)
+{
+    auto stat = stats_find (name);
+    return stat ? stat->total_ns.load (std::memory_order_relaxed) : 0;
+}
+
+gchar*
+qof_stats_to_string (void)
+{
+    auto snapshot = qof_stats_snapshot ();
+    auto str = g_string_new (nullptr);
+    for (auto node = snapshot; node; node = node->next)
+    {
+        auto value = static_cast<QofStatValue*> (node->data);
+        if (!value->count)
+            continue;
+        g_string_append_printf (str, "%s %" G_GUINT64_FORMAT " %.3f %.3f\n",
+                                value->name, value->count,
+                                value->total_ns / 1e6, value->max_ns / 1e6);
+    }
+    qof_stats_snapshot_free (snapshot);
+    return g_string_free (str, FALSE);
+}
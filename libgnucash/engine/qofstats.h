@@ -0,0 +1,152 @@
+/********************************************************************\
+ * qofstats.h -- QOF instrumentation counters and timers            *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+\********************************************************************/
+
+/** @addtogroup Utilities
+    @{ */
+/** @file qofstats.h
+    @brief Named counters and timers for the engine's hot paths.
+
+    Instrumented code uses the QOF_STAT_COUNT and QOF_STAT_TIMER_* macros
+    with a static name such as "engine.trans.commit". Statistics are off
+    by default; while they are, each instrumentation point costs a single
+    load and compare. Once enabled with qof_stats_set_enabled() every
+    point records the number of times it was reached and, for timers,
+    the total and the longest time spent.
+
+    The statistics are process-wide and may be updated from any thread.
+*/
+
+#ifndef QOF_STATS_H
+#define QOF_STATS_H
+
+#include <glib.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct QofStat QofStat;
+
+/** A copy of one statistic, see qof_stats_snapshot(). Times are in
+ * nanoseconds and are 0 for plain counters. */
+typedef struct
+{
+    gchar *name;
+    guint64 count;
+    guint64 total_ns;
+    guint64 max_ns;
+} QofStatValue;
+
+/** Non-zero while statistics are being recorded. Don't modify it, use
+ * qof_stats_set_enabled(). */
+extern gint qof_stats_active;
+
+static inline gboolean
+qof_stats_enabled (void)
+{
+    return G_UNLIKELY (g_atomic_int_get (&qof_stats_active) != 0);
+}
+
+/** Start or stop recording. Stopping keeps the values recorded so far. */
+void qof_stats_set_enabled (gboolean enabled);
+gboolean qof_stats_get_enabled (void);
+
+/** Zero all statistics. */
+void qof_stats_reset (void);
+
+/** A monotonic clock in nanoseconds, never 0. */
+gint64 qof_stats_now (void);
+
+/** Add one to the count of the statistic @a name and @a elapsed_ns to its
+ * time. @a site caches the statistic for the calling instrumentation point
+ * and must be a static initialized to NULL. This is the slow path of the
+ * macros below, call it only when qof_stats_enabled(). */
+void qof_stat_record (QofStat **site, const char *name, gint64 elapsed_ns);
+
+/** A GList of QofStatValue*. The language bindings convert it to a list
+ * of (name count total-ns max-ns). */
+typedef GList QofStatList;
+
+/** The values of all statistics seen so far, sorted by name. Free it with
+ * qof_stats_snapshot_free(). */
+QofStatList *qof_stats_snapshot (void);
+void qof_stats_snapshot_free (QofStatList *snapshot);
+
+/** The count and total time of the statistic @a name, 0 if it hasn't been
+ * recorded. For the language bindings. */
+guint64 qof_stats_get_count (const char *name);
+guint64 qof_stats_get_total_ns (const char *name);
+
+/** All statistics with a non-zero count, one per line, as
+ * "name count total-ms max-ms". The caller must g_free the result. */
+gchar *qof_stats_to_string (void);
+
+/** Count one occurrence of @a name. */
+#define QOF_STAT_COUNT(name) do { \
+    static QofStat *qof_stat_site = NULL; \
+    if (qof_stats_enabled ()) \
+        qof_stat_record (&qof_stat_site, name, 0); \
+} while (0)
+
+/** Timing in C: keep the result of QOF_STAT_TIMER_START() in a gint64,
+ * which may be initialized among the declarations, and pass it to
+ * QOF_STAT_TIMER_STOP() on every path out of the timed code. A timer
+ * started while statistics were off records nothing. */
+#define QOF_STAT_TIMER_START() (qof_stats_enabled () ? qof_stats_now () : 0)
+
+#define QOF_STAT_TIMER_STOP(name, start) do { \
+    static QofStat *qof_stat_site = NULL; \
+    if ((start) != 0) \
+        qof_stat_record (&qof_stat_site, name, qof_stats_now () - (start)); \
+} while (0)
+
+#ifdef __cplusplus
+}
+
+/** Timing in C++: times the rest of the enclosing scope. */
+class QofStatTimer
+{
+public:
+    QofStatTimer (QofStat **site, const char *name) :
+        m_site{site}, m_name{name},
+        m_start{qof_stats_enabled () ? qof_stats_now () : 0} {}
+    ~QofStatTimer ()
+    {
+        if (m_start)
+            qof_stat_record (m_site, m_name, qof_stats_now () - m_start);
+    }
+    QofStatTimer (const QofStatTimer&) = delete;
+    QofStatTimer& operator= (const QofStatTimer&) = delete;
+private:
+    QofStat **m_site;
+    const char *m_name;
+    gint64 m_start;
+};
+
+#define QOF_STAT_SCOPED_TIMER(name) \
+    static QofStat *qof_stat_timer_site = nullptr; \
+    QofStatTimer qof_stat_timer {&qof_stat_timer_site, name}
+
+#endif /* __cplusplus */
+
+#endif /* QOF_STATS_H */
+/** @} */
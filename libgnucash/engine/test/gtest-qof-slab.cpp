@@ -0,0 +1,86 @@
+/********************************************************************
+ * gtest-qof-slab.cpp -- unit tests for the QofSlab block pools.    *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+ *******************************************************************/
+
+#include <gtest/gtest.h>
+#include "../qof-slab.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+
+TEST(QofSlab, block_size_is_aligned)
+{
+    QofSlab slab{3};
+    EXPECT_GE(slab.block_size(), sizeof(void*));
+    EXPECT_EQ(0u, slab.block_size() % alignof(std::max_align_t));
+    auto block = slab.allocate();
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(block) % alignof(std::max_align_t));
+    slab.deallocate(block);
+}
+
+TEST(QofSlab, blocks_are_distinct_and_usable)
+{
+    QofSlab slab{40, 8};
+    std::vector<void*> blocks;
+    for (int i = 0; i < 20; ++i)
+    {
+        auto block = slab.allocate();
+        std::memset(block, i, 40);
+        blocks.push_back(block);
+    }
+    EXPECT_EQ(20u, slab.in_use());
+    EXPECT_EQ(3u, slab.chunks());
+    EXPECT_EQ(20u, std::set<void*>(blocks.begin(), blocks.end()).size());
+    for (int i = 0; i < 20; ++i)
+        EXPECT_EQ(i, *static_cast<char*>(blocks[i]));
+    for (auto block : blocks)
+        slab.deallocate(block);
+}
+
+TEST(QofSlab, freed_blocks_are_reused)
+{
+    QofSlab slab{16, 4};
+    auto keep = slab.allocate();
+    auto block = slab.allocate();
+    slab.deallocate(block);
+    EXPECT_EQ(block, slab.allocate());
+    EXPECT_EQ(2u, slab.in_use());
+    slab.deallocate(block);
+    slab.deallocate(keep);
+}
+
+TEST(QofSlab, empty_slab_releases_chunks)
+{
+    QofSlab slab{16, 4};
+    std::vector<void*> blocks;
+    for (int i = 0; i < 10; ++i)
+        blocks.push_back(slab.allocate());
+    EXPECT_EQ(3u, slab.chunks());
+    for (auto block : blocks)
+        slab.deallocate(block);
+    EXPECT_EQ(0u, slab.in_use());
+    EXPECT_EQ(1u, slab.chunks());
+    /* The kept chunk is reused from its start. */
+    EXPECT_EQ(blocks[0], slab.allocate());
+    EXPECT_EQ(1u, slab.chunks());
+}
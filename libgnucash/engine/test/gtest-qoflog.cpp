@@ -0,0 +1,90 @@
+/********************************************************************
+ * gtest-qoflog.cpp -- unit tests for the log level hierarchy and    *
+ *                     the per-call-site level cache.                *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+ *******************************************************************/
+
+#include <gtest/gtest.h>
+#include "../qoflog.h"
+
+class QofLogTest : public ::testing::Test
+{
+protected:
+    void TearDown() override { qof_log_shutdown(); }
+};
+
+TEST_F(QofLogTest, check_hierarchy)
+{
+    qof_log_set_level("gnc", QOF_LOG_WARNING);
+    qof_log_set_level("gnc.engine", QOF_LOG_INFO);
+    qof_log_set_level("gnc.engine.sx", QOF_LOG_DEBUG);
+
+    EXPECT_TRUE(qof_log_check("gnc.engine", QOF_LOG_INFO));
+    EXPECT_FALSE(qof_log_check("gnc.engine", QOF_LOG_DEBUG));
+    EXPECT_TRUE(qof_log_check("gnc.engine.sx", QOF_LOG_DEBUG));
+    EXPECT_TRUE(qof_log_check("gnc.engine.sx.foo", QOF_LOG_DEBUG));
+    EXPECT_FALSE(qof_log_check("gnc.gui", QOF_LOG_INFO));
+    EXPECT_TRUE(qof_log_check("gnc.gui", QOF_LOG_WARNING));
+    EXPECT_FALSE(qof_log_check("foo", QOF_LOG_INFO));
+    EXPECT_TRUE(qof_log_check("foo", QOF_LOG_ERROR));
+}
+
+TEST_F(QofLogTest, get_level)
+{
+    EXPECT_EQ(QOF_LOG_WARNING, qof_log_get_level("gnc.engine"));
+    qof_log_set_level("gnc.engine", QOF_LOG_INFO);
+    EXPECT_EQ(QOF_LOG_INFO, qof_log_get_level("gnc.engine"));
+    EXPECT_EQ(QOF_LOG_WARNING, qof_log_get_level("gnc"));
+    EXPECT_EQ(QOF_LOG_WARNING, qof_log_get_level("gnc.engine.sx"));
+}
+
+TEST_F(QofLogTest, cache_matches_check)
+{
+    QofLogCache cache = 0;
+    qof_log_set_level("gnc.engine", QOF_LOG_INFO);
+    for (auto level : {QOF_LOG_FATAL, QOF_LOG_ERROR, QOF_LOG_WARNING,
+                       QOF_LOG_MESSAGE, QOF_LOG_INFO, QOF_LOG_DEBUG})
+    {
+        EXPECT_EQ(qof_log_check("gnc.engine.foo", level),
+                  qof_log_check_cached(&cache, "gnc.engine.foo", level));
+    }
+}
+
+TEST_F(QofLogTest, cache_invalidated_by_set_level)
+{
+    QofLogCache cache = 0;
+    qof_log_set_level("gnc.engine", QOF_LOG_WARNING);
+    EXPECT_FALSE(qof_log_check_cached(&cache, "gnc.engine", QOF_LOG_DEBUG));
+    auto stale = cache;
+    qof_log_set_level("gnc.engine", QOF_LOG_DEBUG);
+    EXPECT_TRUE(qof_log_check_cached(&cache, "gnc.engine", QOF_LOG_DEBUG));
+    EXPECT_NE(stale, cache);
+    qof_log_set_level("gnc.engine", QOF_LOG_WARNING);
+    EXPECT_FALSE(qof_log_check_cached(&cache, "gnc.engine", QOF_LOG_DEBUG));
+}
+
+TEST_F(QofLogTest, cache_invalidated_by_shutdown)
+{
+    QofLogCache cache = 0;
+    qof_log_set_level("gnc.engine", QOF_LOG_DEBUG);
+    EXPECT_TRUE(qof_log_check_cached(&cache, "gnc.engine", QOF_LOG_DEBUG));
+    qof_log_shutdown();
+    EXPECT_FALSE(qof_log_check_cached(&cache, "gnc.engine", QOF_LOG_DEBUG));
+}
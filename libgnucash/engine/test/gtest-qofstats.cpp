@@ -0,0 +1,114 @@
+/********************************************************************
+ * gtest-qofstats.cpp -- unit tests for the instrumentation         *
+ *                       counters and timers.                       *
+ *                                                                  *
+ * This program is free software; you can redistribute it and/or    *
+ * modify it under the terms of the GNU General Public License as   *
+ * published by the Free Software Foundation; either version 2 of   *
+ * the License, or (at your option) any later version.              *
+ *                                                                  *
+ * This program is distributed in the hope that it will be useful,  *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of   *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the    *
+ * GNU General Public License for more details.                     *
+ *                                                                  *
+ * You should have received a copy of the GNU General Public License*
+ * along with this program; if not, contact:                        *
+ *                                                                  *
+ * Free Software Foundation           Voice:  +1-617-542-5942       *
+ * 51 Franklin Street, Fifth Floor    Fax:    +1-617-542-2652       *
+ * Boston, MA  02110-1301,  USA       gnu@gnu.org                   *
+ *                                                                  *
+ *******************************************************************/
+
+#include <gtest/gtest.h>
+#include "../qofstats.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+class QofStatsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { qof_stats_reset(); qof_stats_set_enabled(TRUE); }
+    void TearDown() override { qof_stats_set_enabled(FALSE); qof_stats_reset(); }
+};
+
+static void
+count_once()
+{
+    QOF_STAT_COUNT("test.count");
+}
+
+static void
+time_once()
+{
+    gint64 start = QOF_STAT_TIMER_START();
+    QOF_STAT_TIMER_STOP("test.timer", start);
+}
+
+TEST_F(QofStatsTest, disabled_records_nothing)
+{
+    qof_stats_set_enabled(FALSE);
+    EXPECT_FALSE(qof_stats_get_enabled());
+    count_once();
+    time_once();
+    EXPECT_EQ(0u, qof_stats_get_count("test.count"));
+    EXPECT_EQ(0u, qof_stats_get_count("test.timer"));
+}
+
+TEST_F(QofStatsTest, counts_and_reset)
+{
+    for (int i = 0; i < 5; ++i)
+        count_once();
+    EXPECT_EQ(5u, qof_stats_get_count("test.count"));
+    EXPECT_EQ(0u, qof_stats_get_total_ns("test.count"));
+    qof_stats_reset();
+    EXPECT_EQ(0u, qof_stats_get_count("test.count"));
+    count_once();
+    EXPECT_EQ(1u, qof_stats_get_count("test.count"));
+    EXPECT_EQ(0u, qof_stats_get_count("test.no-such-stat"));
+}
+
+TEST_F(QofStatsTest, timers)
+{
+    {
+        QOF_STAT_SCOPED_TIMER("test.scoped");
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    time_once();
+    EXPECT_EQ(1u, qof_stats_get_count("test.scoped"));
+    EXPECT_GE(qof_stats_get_total_ns("test.scoped"), 2000000u);
+    EXPECT_EQ(1u, qof_stats_get_count("test.timer"));
+
+    auto snapshot = qof_stats_snapshot();
+    bool found = false;
+    for (auto node = snapshot; node; node = node->next)
+    {
+        auto value = static_cast<QofStatValue*>(node->data);
+        if (std::string{value->name} != "test.scoped")
+            continue;
+        found = true;
+        EXPECT_EQ(value->total_ns, value->max_ns);
+    }
+    qof_stats_snapshot_free(snapshot);
+    EXPECT_TRUE(found);
+
+    auto str = qof_stats_to_string();
+    EXPECT_NE(nullptr, strstr(str, "test.scoped 1 "));
+    EXPECT_EQ(nullptr, strstr(str, "test.count"));
+    g_free(str);
+}
+
+TEST_F(QofStatsTest, threads)
+{
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i)
+        threads.emplace_back([]{ for (int j = 0; j < 1000; ++j) count_once(); });
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_EQ(4000u, qof_stats_get_count("test.count"));
+}
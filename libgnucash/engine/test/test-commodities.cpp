@@ -181,6 +181,73 @@ test_commodity(void)
         }
     }
 
+    {
+        gnc_commodity_table *tbl;
+        gnc_commodity *acme, *other;
+        gnc_quote_source *source;
+        GList *list;
+        QofBook *book;
+
+        book = qof_book_new ();
+        tbl = gnc_commodity_table_new ();
+        source = gnc_quote_source_lookup_by_internal ("alphavantage");
+
+        acme = gnc_commodity_new (book, "Acme Corp", "NASDAQ", "ACME",
+                                  "US0000000001", 100);
+        other = gnc_commodity_new (book, "Other Inc", "NASDAQ", "OTHR",
+                                   "US0000000002", 100);
+        gnc_commodity_set_quote_source (acme, source);
+        gnc_commodity_table_insert (tbl, acme);
+        gnc_commodity_table_insert (tbl, other);
+
+        do_test (gnc_commodity_table_find_full (tbl, "NASDAQ",
+                                                "ACME (Acme Corp)") == acme,
+                 "find_full by print name");
+        do_test (gnc_commodity_table_find_full (tbl,
+                                                GNC_COMMODITY_NS_NONCURRENCY,
+                                                "OTHR (Other Inc)") == other,
+                 "find_full across non-currency namespaces");
+        do_test (gnc_commodity_table_find_by_cusip (tbl, "US0000000002")
+                 == other, "find_by_cusip");
+
+        gnc_commodity_set_fullname (acme, "Acme Holdings");
+        do_test (gnc_commodity_table_find_full (tbl, "NASDAQ",
+                                                "ACME (Acme Corp)") == NULL,
+                 "find_full misses the old print name");
+        do_test (gnc_commodity_table_find_full (tbl, "NASDAQ",
+                                                "ACME (Acme Holdings)") == acme,
+                 "find_full follows set_fullname");
+
+        gnc_commodity_set_cusip (other, "US0000000003");
+        do_test (gnc_commodity_table_find_by_cusip (tbl, "US0000000002")
+                 == NULL, "find_by_cusip misses the old code");
+        do_test (gnc_commodity_table_find_by_cusip (tbl, "US0000000003")
+                 == other, "find_by_cusip follows set_cusip");
+
+        list = gnc_commodity_table_find_by_quote_source (tbl, source);
+        do_test (g_list_length (list) == 1 && list->data == acme,
+                 "find_by_quote_source");
+        g_list_free (list);
+
+        gnc_commodity_set_quote_source (other, source);
+        list = gnc_commodity_table_find_by_quote_source (tbl, source);
+        do_test (g_list_length (list) == 2,
+                 "find_by_quote_source follows set_quote_source");
+        g_list_free (list);
+
+        gnc_commodity_table_remove (tbl, acme);
+        do_test (gnc_commodity_table_find_full (tbl, "NASDAQ",
+                                                "ACME (Acme Holdings)") == NULL,
+                 "find_full misses a removed commodity");
+        list = gnc_commodity_table_find_by_quote_source (tbl, source);
+        do_test (g_list_length (list) == 1 && list->data == other,
+                 "find_by_quote_source misses a removed commodity");
+        g_list_free (list);
+
+        gnc_commodity_destroy (acme);
+        gnc_commodity_table_destroy (tbl);
+        qof_book_destroy (book);
+    }
 }
 
 int
@@ -632,6 +632,22 @@ test_instance_commit_edit_part2( Fixture *fixture, gconstpointer pData )
     g_assert( !commit_test.m_on_free_called );
     g_assert( !commit_test.m_on_done_called );
 
+    g_test_message( "Test when the commit is deferred by a bulk load, error produced" );
+    commit_test.m_commit_called = false;
+    commit_test.m_on_error_called = false;
+    qof_instance_set_dirty_flag( fixture->inst, TRUE );
+    qof_book_begin_bulk_load( book );
+    result = qof_commit_edit_part2( fixture->inst, on_error, on_done, on_free );
+    g_assert( result );
+    g_assert( !commit_test.m_commit_called );
+    g_assert( !commit_test.m_on_error_called );
+    g_assert( commit_test.m_on_done_called );
+    qof_book_end_bulk_load( book );
+    g_assert( commit_test.m_commit_called );
+    g_assert( commit_test.m_on_error_called );
+    g_assert_cmpint( be->get_error(), == , ERR_BACKEND_NO_HANDLER );
+    be->inject_error(ERR_BACKEND_NO_ERR);
+
     /* clean up */
     qof_book_set_backend( book, NULL );
     qof_book_destroy( book );
@@ -43,6 +43,7 @@ void test_suite_account (void);
 
 #include <qofinstance-p.h>
 #include <kvp-frame.hpp>
+#include <vector>
 
 typedef struct
 {
@@ -1181,6 +1182,68 @@ test_gnc_account_insert_remove_split (Fixture *fixture, gconstpointer pData)
     test_signal_free (sig3);
     test_signal_free (sig1);
 }
+/* gnc_book_begin_bulk_load
+void
+gnc_book_begin_bulk_load (QofBook *book)
+
+Also tests gnc_book_end_bulk_load ()
+*/
+static void
+test_gnc_book_bulk_load (Fixture *fixture, gconstpointer pData)
+{
+    QofBook *book = gnc_account_get_book (fixture->acct);
+    Split *split1 = xaccMallocSplit (book);
+    Split *split2 = xaccMallocSplit (book);
+    AccountPrivate *priv = fixture->func->get_private (fixture->acct);
+    auto loglevel = static_cast<GLogLevelFlags>(G_LOG_LEVEL_CRITICAL | G_LOG_FLAG_FATAL);
+    auto check = test_error_struct_new ("gnc.account", loglevel, "twice");
+    TestSignal sig1, sig2;
+    guint logger;
+
+    sig1 = test_signal_new (&fixture->acct->inst, QOF_EVENT_MODIFY, NULL);
+    sig2 = test_signal_new (&fixture->acct->inst, GNC_EVENT_ITEM_ADDED, split1);
+    gnc_book_begin_bulk_load (book);
+    gnc_book_begin_bulk_load (book);
+    g_assert (qof_book_in_bulk_load (book));
+
+    /* Inserts neither sort, nor check for duplicates, nor signal. */
+    g_assert (gnc_account_insert_split (fixture->acct, split1));
+    g_assert (gnc_account_insert_split (fixture->acct, split2));
+    g_assert (gnc_account_insert_split (fixture->acct, split1));
+    g_assert_cmpuint (g_list_length (priv->splits), == , 3);
+    g_assert (priv->sort_dirty);
+    g_assert (priv->balance_dirty);
+    xaccAccountRecomputeBalance (fixture->acct);
+    g_assert (priv->balance_dirty);
+
+    /* Ending the inner bulk load changes nothing. */
+    gnc_book_end_bulk_load (book);
+    g_assert (qof_book_in_bulk_load (book));
+    g_assert (priv->sort_dirty);
+    test_signal_assert_hits (sig1, 0);
+    test_signal_assert_hits (sig2, 0);
+
+    test_add_error (check);
+    logger = g_log_set_handler ("gnc.account", loglevel,
+                                (GLogFunc)test_checked_substring_handler, check);
+    g_test_log_set_fatal_handler ((GTestLogFatalFunc)test_list_substring_handler, NULL);
+    gnc_book_end_bulk_load (book);
+    g_assert (!qof_book_in_bulk_load (book));
+    g_assert_cmpint (check->hits, ==, 1);
+    g_log_remove_handler ("gnc.account", logger);
+    test_clear_error_list ();
+
+    /* The duplicate is gone, and the account was brought up to date and
+     * signalled once. */
+    g_assert_cmpuint (g_list_length (priv->splits), == , 2);
+    g_assert (!priv->sort_dirty);
+    g_assert (!priv->balance_dirty);
+    test_signal_assert_hits (sig1, 1);
+    test_signal_assert_hits (sig2, 0);
+
+    test_signal_free (sig2);
+    test_signal_free (sig1);
+}
 /* xaccAccountSortSplits
 void
 xaccAccountSortSplits (Account *acc, gboolean force)// C: 4 in 2
@@ -1331,6 +1394,97 @@ test_xaccAccountRecomputeBalance (Fixture *fixture, gconstpointer pData)
     g_assert (!priv->balance_dirty);
 }
 
+/* gnc_account_set_split_balances_limit
+void
+gnc_account_set_split_balances_limit (guint max_splits)// C: 1 in 1 */
+static void
+test_gnc_account_set_split_balances_limit (Fixture *fixture, gconstpointer pData)
+{
+    GList *accounts = gnc_account_get_descendants (gnc_account_get_root (fixture->acct));
+    std::vector<Account*> with_splits;
+
+    for (auto node = accounts; node; node = node->next)
+        if (g_list_length (xaccAccountGetSplitList (GNC_ACCOUNT (node->data))) > 1)
+            with_splits.push_back (GNC_ACCOUNT (node->data));
+    g_list_free (accounts);
+    g_assert_cmpint (with_splits.size (), >=, 2);
+
+    auto acc1 = with_splits[0], acc2 = with_splits[1];
+    auto priv1 = fixture->func->get_private (acc1);
+    auto priv2 = fixture->func->get_private (acc2);
+    auto split1 = static_cast<Split*>(g_list_last (priv1->splits)->data);
+    auto split2 = static_cast<Split*>(g_list_last (priv2->splits)->data);
+    xaccAccountRecomputeBalance (acc1);
+    xaccAccountRecomputeBalance (acc2);
+
+    g_assert (gnc_numeric_eq (xaccSplitGetBalance (split1), priv1->balance));
+    g_assert (gnc_numeric_eq (xaccSplitGetBalance (split2), priv2->balance));
+    g_assert (priv1->split_balances != NULL);
+    g_assert (priv2->split_balances != NULL);
+
+    /* Lowering the limit frees everything over it ... */
+    gnc_account_set_split_balances_limit (1);
+    g_assert (priv1->split_balances == NULL);
+    g_assert (priv2->split_balances == NULL);
+    /* ... but an account's balances are kept while they're being used, and
+     * building them frees the older ones. */
+    g_assert (gnc_numeric_eq (xaccSplitGetBalance (split2), priv2->balance));
+    g_assert (priv2->split_balances != NULL);
+    g_assert (gnc_numeric_eq (xaccSplitGetBalance (split1), priv1->balance));
+    g_assert (priv1->split_balances != NULL);
+    g_assert (priv2->split_balances == NULL);
+
+    gnc_account_set_split_balances_limit (0);
+    g_assert (gnc_numeric_eq (xaccSplitGetBalance (split2), priv2->balance));
+    g_assert (priv1->split_balances != NULL);
+    g_assert (priv2->split_balances != NULL);
+
+    gnc_account_drop_all_split_balances ();
+    g_assert (priv1->split_balances == NULL);
+    g_assert (priv2->split_balances == NULL);
+}
+
+/* gnc_book_finalize_load
+void
+gnc_book_finalize_load (QofBook *book)// C: 3 in 3 */
+static void
+test_gnc_book_finalize_load (Fixture *fixture, gconstpointer pData)
+{
+    QofBook *book = gnc_account_get_book (fixture->acct);
+    GList *accounts = gnc_account_get_descendants (gnc_account_get_root (fixture->acct));
+    std::vector<gnc_numeric> balances;
+
+    /* Leave the accounts open, as a backend would, with their splits out
+     * of order and their balances wiped. */
+    for (auto node = accounts; node; node = node->next)
+    {
+        auto priv = fixture->func->get_private (GNC_ACCOUNT (node->data));
+        balances.push_back (priv->balance);
+        xaccAccountBeginEdit (GNC_ACCOUNT (node->data));
+        priv->splits = g_list_reverse (priv->splits);
+        priv->sort_dirty = TRUE;
+        priv->balance_dirty = TRUE;
+        priv->balance = gnc_numeric_zero ();
+    }
+
+    gnc_book_finalize_load (book);
+
+    auto balance = balances.begin ();
+    for (auto node = accounts; node; node = node->next, ++balance)
+    {
+        auto priv = fixture->func->get_private (GNC_ACCOUNT (node->data));
+        g_assert (!priv->sort_dirty);
+        g_assert (!priv->balance_dirty);
+        g_assert (gnc_numeric_eq (priv->balance, *balance));
+        for (auto split = priv->splits; split && split->next; split = split->next)
+            g_assert_cmpint (xaccSplitOrder (static_cast<Split*>(split->data),
+                                             static_cast<Split*>(split->next->data)),
+                             <, 0);
+        xaccAccountCommitEdit (GNC_ACCOUNT (node->data));
+    }
+    g_list_free (accounts);
+}
+
 /* xaccAccountOrder
 int
 xaccAccountOrder (const Account *aa, const Account *ab)// C: 11 in 3 */
@@ -2560,8 +2714,11 @@ test_suite_account (void)
 // GNC_TEST_ADD (suitename, "xaccAcctChildrenEqual", Fixture, NULL, setup, test_xaccAcctChildrenEqual,  teardown );
 // GNC_TEST_ADD (suitename, "xaccAccountEqual", Fixture, NULL, setup, test_xaccAccountEqual,  teardown );
     GNC_TEST_ADD (suitename, "gnc account insert & remove split", Fixture, NULL, setup, test_gnc_account_insert_remove_split,  teardown );
+    GNC_TEST_ADD (suitename, "gnc book bulk load", Fixture, NULL, setup, test_gnc_book_bulk_load,  teardown );
     GNC_TEST_ADD (suitename, "xaccAccount Insert and Remove Lot", Fixture, &good_data, setup, test_xaccAccountInsertRemoveLot,  teardown );
     GNC_TEST_ADD (suitename, "xaccAccountRecomputeBalance", Fixture, &some_data, setup, test_xaccAccountRecomputeBalance,  teardown );
+    GNC_TEST_ADD (suitename, "gnc book finalize load", Fixture, &complex_data, setup, test_gnc_book_finalize_load,  teardown );
+    GNC_TEST_ADD (suitename, "gnc account set split balances limit", Fixture, &complex_data, setup, test_gnc_account_set_split_balances_limit,  teardown );
     GNC_TEST_ADD_FUNC (suitename, "xaccAccountOrder", test_xaccAccountOrder );
     GNC_TEST_ADD (suitename, "qofAccountSetParent", Fixture, &some_data, setup, test_qofAccountSetParent,  teardown );
     GNC_TEST_ADD (suitename, "gnc account append/remove child", Fixture, NULL, setup, test_gnc_account_append_remove_child,  teardown );
@@ -737,6 +737,83 @@ gnc_pricedb_add_price(GNCPriceDB *db, GNCPrice *p)// C: 7 in 7 SCM: 1  Local: 0:
 test_gnc_pricedb_add_price (Fixture *fixture, gconstpointer pData)
 {
 }*/
+/* gnc_pricedb_add_prices_bulk
+guint
+gnc_pricedb_add_prices_bulk(GNCPriceDB *db, GList *prices)
+*/
+static void
+test_gnc_pricedb_add_prices_bulk (PriceDBFixture *fixture, gconstpointer pData)
+{
+    GNCPriceDB *db = fixture->pricedb;
+    QofBook *book = qof_instance_get_book (QOF_INSTANCE (db));
+    Commodities *c = fixture->com;
+    time64 day1 = gnc_dmy2time64_neutral (3, 2, 2015);
+    time64 day2 = gnc_dmy2time64_neutral (4, 2, 2015);
+    time64 day3 = gnc_dmy2time64_neutral (5, 2, 2015);
+    GList *batch = NULL, *prices, *node;
+    GNCPrice *price, *edited_price;
+    time64 last = INT64_MAX;
+    int count = 0;
+
+    /* Out of order, with two prices on day2 of which the edited one wins. */
+    edited_price = construct_price (book, c->amzn, c->eur, day2,
+                                  PRICE_SOURCE_EDIT_DLG,
+                                  gnc_numeric_create (35000, 100));
+    batch = g_list_append (batch, construct_price (book, c->amzn, c->eur, day3,
+                                                   PRICE_SOURCE_FQ,
+                                                   gnc_numeric_create (36000, 100)));
+    batch = g_list_append (batch, edited_price);
+    batch = g_list_append (batch, construct_price (book, c->amzn, c->eur, day1,
+                                                   PRICE_SOURCE_FQ,
+                                                   gnc_numeric_create (34000, 100)));
+    batch = g_list_append (batch, construct_price (book, c->amzn, c->eur, day2,
+                                                   PRICE_SOURCE_FQ,
+                                                   gnc_numeric_create (35500, 100)));
+    g_assert_cmpuint (gnc_pricedb_add_prices_bulk (db, batch), ==, 3);
+    g_list_free (batch);
+
+    prices = gnc_pricedb_get_prices (db, c->amzn, c->eur);
+    for (node = prices; node; node = node->next)
+    {
+        time64 t = gnc_price_get_time64 (node->data);
+        g_assert_cmpint (t, <, last);
+        last = t;
+        ++count;
+    }
+    g_assert_cmpint (count, ==, 3);
+    gnc_price_list_destroy (prices);
+
+    price = gnc_pricedb_lookup_day_t64 (db, c->amzn, c->eur, day2 + 3600);
+    g_assert (price == edited_price);
+    gnc_price_unref (price);
+    /* The reverse pair finds the same price. */
+    price = gnc_pricedb_lookup_day_t64 (db, c->eur, c->amzn, day2);
+    g_assert (price == edited_price);
+    gnc_price_unref (price);
+
+    /* A price that isn't in the database can't be removed from it. */
+    price = construct_price (book, c->amzn, c->eur, day2, PRICE_SOURCE_FQ,
+                             gnc_numeric_create (35500, 100));
+    g_assert (!gnc_pricedb_remove_price (db, price));
+    gnc_price_unref (price);
+    price = gnc_pricedb_lookup_day_t64 (db, c->amzn, c->eur, day2);
+    g_assert (price == edited_price);
+    gnc_price_unref (price);
+
+    g_assert (gnc_pricedb_remove_price (db, edited_price));
+    g_assert (gnc_pricedb_lookup_day_t64 (db, c->amzn, c->eur, day2) == NULL);
+    price = gnc_pricedb_lookup_day_t64 (db, c->amzn, c->eur, day3);
+    g_assert (price != NULL);
+    g_assert_cmpint (gnc_price_get_time64 (price), ==, day3);
+    gnc_pricedb_remove_price (db, price);
+    gnc_price_unref (price);
+    price = gnc_pricedb_lookup_day_t64 (db, c->amzn, c->eur, day1);
+    g_assert (price != NULL);
+    g_assert_cmpint (gnc_price_get_time64 (price), ==, day1);
+    gnc_pricedb_remove_price (db, price);
+    gnc_price_unref (price);
+    g_assert (!gnc_pricedb_has_prices (db, c->amzn, c->eur));
+}
 /* remove_price
 static gboolean
 remove_price(GNCPriceDB *db, GNCPrice *p, gboolean cleanup)// Local: 4:0:0
@@ -784,6 +861,7 @@ gnc_pricedb_remove_old_prices(GNCPriceDB *db,// C: 1  Local: 0:0:0
 static void test_gnc_pricedb_remove_old_prices (PriceDBFixture *fixture, gconstpointer pData)
 {
     GList *comm_list = NULL;
+    GNCPrice *price;
     Commodities *c = fixture->com;
     PriceRemoveSourceFlags source_all = PRICE_REMOVE_SOURCE_FQ |
                                         PRICE_REMOVE_SOURCE_USER |
@@ -847,6 +925,14 @@ static void test_gnc_pricedb_remove_old_prices (PriceDBFixture *fixture, gconstp
 
     g_assert_cmpint (gnc_pricedb_get_num_prices(fixture->pricedb), ==, 33);
 
+    // the day lookups follow the pruned lists
+    price = gnc_pricedb_lookup_day_t64 (fixture->pricedb, c->gbp, c->eur,
+                                        gnc_dmy2time64(12, 11, 2008));
+    g_assert (price != NULL);
+    gnc_price_unref (price);
+    g_assert (gnc_pricedb_lookup_day_t64 (fixture->pricedb, c->gbp, c->eur,
+                                          gnc_dmy2time64(13, 5, 2008)) == NULL);
+
     g_list_free (comm_list);
     g_date_free (fiscal_end_date);
 }
@@ -1557,6 +1643,7 @@ test_suite_gnc_pricedb (void)
 // GNC_TEST_ADD (suitename, "check one price date", Fixture, NULL, setup, test_check_one_price_date, teardown);
 // GNC_TEST_ADD (suitename, "pricedb remove foreach pricelist", Fixture, NULL, setup, test_pricedb_remove_foreach_pricelist, teardown);
 // GNC_TEST_ADD (suitename, "pricedb remove foreach currencies hash", Fixture, NULL, setup, test_pricedb_remove_foreach_currencies_hash, teardown);
+    GNC_TEST_ADD (suitename, "gnc pricedb add prices bulk", PriceDBFixture, NULL, setup, test_gnc_pricedb_add_prices_bulk, teardown);
     GNC_TEST_ADD (suitename, "gnc pricedb remove old prices", PriceDBFixture, NULL, setup, test_gnc_pricedb_remove_old_prices, teardown);
 // GNC_TEST_ADD (suitename, "price list from hashtable", Fixture, NULL, setup, test_price_list_from_hashtable, teardown);
 // GNC_TEST_ADD (suitename, "pricedb get prices internal", Fixture, NULL, setup, test_pricedb_get_prices_internal, teardown);